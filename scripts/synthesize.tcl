@@ -20,6 +20,9 @@ add_files -norecurse {
     ../src/instruction_decoder.v
     ../src/control_unit.v
     ../src/memory_interface.v
+    ../src/perf_counters.v
+    ../src/address_generator.v
+    ../src/dma_controller.v
 }
 
 # Add constraint files
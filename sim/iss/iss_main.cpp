@@ -0,0 +1,163 @@
+//=============================================================================
+// Instruction-Set Simulator Driver for RISC-V DSP Processor
+// Command line, program loading and the cycle / profile report
+//=============================================================================
+
+#include "riscv_dsp_iss.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [options] program.elf\n"
+            "       %s [options] --imem imem.hex [--dmem dmem.hex]\n"
+            "Options:\n"
+            "  --imem FILE        Load instruction memory from a $readmemh image\n"
+            "  --dmem FILE        Load data memory from a $readmemh image\n"
+            "  --imem-size BYTES  Instruction memory size (default %u)\n"
+            "  --dmem-size BYTES  Data memory size (default %u)\n"
+            "  --unified          Single memory for code and data (size = imem size)\n"
+            "  --max-insns N      Stop after N instructions\n"
+            "  --forwarding       Ideal forwarding: only load-use hazards stall\n"
+            "  --branch-penalty N Cycles lost on a taken branch or jump (default 2)\n"
+            "  --profile          Print per-function cycle counts\n"
+            "  --regs             Dump the register file on exit\n"
+            "  --trace            Print every retired instruction\n",
+            program, program, ISS_IMEM_SIZE, ISS_DMEM_SIZE);
+}
+
+static double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+static void print_report(const riscv_dsp_iss &iss, double seconds) {
+    const iss_stats_t &s = iss.stats();
+    fprintf(stderr, "\n==== ISS statistics ====\n");
+    fprintf(stderr, "Instructions retired: %llu\n", (unsigned long long)s.instret);
+    fprintf(stderr, "Cycles:               %llu (CPI %.3f)\n", (unsigned long long)s.cycles,
+            s.instret ? (double)s.cycles / (double)s.instret : 0.0);
+    fprintf(stderr, "  RAW stalls:         %llu\n", (unsigned long long)s.raw_stalls);
+    fprintf(stderr, "  Load-use stalls:    %llu\n", (unsigned long long)s.load_use_stalls);
+    fprintf(stderr, "  Branch flushes:     %llu cycles (%llu of %llu branches taken, %llu jumps)\n",
+            (unsigned long long)s.branch_flush_cycles, (unsigned long long)s.branches_taken,
+            (unsigned long long)s.branches, (unsigned long long)s.jumps);
+    fprintf(stderr, "  Hardware loops:     %llu loop-backs (no flush)\n", (unsigned long long)s.loop_backs);
+    fprintf(stderr, "Loads / stores:       %llu / %llu\n", (unsigned long long)s.loads, (unsigned long long)s.stores);
+    fprintf(stderr, "MAC / SIMD / DSP ops: %llu / %llu / %llu\n", (unsigned long long)s.mac_ops,
+            (unsigned long long)s.simd_ops, (unsigned long long)s.dsp_ops);
+    fprintf(stderr, "Host time:            %.3f s (%.1f MIPS)\n", seconds,
+            seconds > 0 ? (double)s.instret / seconds / 1e6 : 0.0);
+}
+
+static void print_profile(const riscv_dsp_iss &iss) {
+    std::vector<iss_function_t> functions = iss.functions();
+    if (functions.empty()) {
+        fprintf(stderr, "\nNo function symbols; profile unavailable.\n");
+        return;
+    }
+    std::sort(functions.begin(), functions.end(),
+              [](const iss_function_t &a, const iss_function_t &b) { return a.cycles > b.cycles; });
+
+    uint64_t total = iss.stats().cycles;
+    fprintf(stderr, "\n==== Function profile (self cycles) ====\n");
+    fprintf(stderr, "%-28s %10s %12s %14s %7s %6s\n", "function", "calls", "instret", "cycles", "%", "CPI");
+    for (const iss_function_t &f : functions) {
+        if (f.instret == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-28s %10llu %12llu %14llu %6.2f%% %6.3f\n", f.name.c_str(),
+                (unsigned long long)f.calls, (unsigned long long)f.instret, (unsigned long long)f.cycles,
+                percent(f.cycles, total), (double)f.cycles / (double)f.instret);
+    }
+}
+
+static void print_regs(const riscv_dsp_iss &iss) {
+    fprintf(stderr, "\npc = 0x%08x\n", iss.pc());
+    for (int i = 0; i < 32; i++) {
+        fprintf(stderr, "x%-2d = 0x%08x%s", i, iss.reg(i), (i % 4 == 3) ? "\n" : "   ");
+    }
+}
+
+int main(int argc, char **argv) {
+    iss_config_t config;
+    std::string elf, imem_hex, dmem_hex;
+    bool profile = false;
+    bool regs = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--imem" && has_value) {
+            imem_hex = argv[++i];
+        } else if (arg == "--dmem" && has_value) {
+            dmem_hex = argv[++i];
+        } else if (arg == "--imem-size" && has_value) {
+            config.imem_size = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else if (arg == "--dmem-size" && has_value) {
+            config.dmem_size = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else if (arg == "--unified") {
+            config.unified = true;
+        } else if (arg == "--max-insns" && has_value) {
+            config.max_insns = strtoull(argv[++i], nullptr, 0);
+        } else if (arg == "--forwarding") {
+            config.timing.forwarding = true;
+            config.timing.rtl_hazard_fields = false;
+        } else if (arg == "--branch-penalty" && has_value) {
+            config.timing.branch_penalty = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        } else if (arg == "--profile") {
+            profile = true;
+        } else if (arg == "--regs") {
+            regs = true;
+        } else if (arg == "--trace") {
+            config.trace = true;
+        } else if (arg[0] != '-' && elf.empty()) {
+            elf = arg;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (elf.empty() == imem_hex.empty() || (config.imem_size & 3) != 0 || config.imem_size == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    riscv_dsp_iss iss(config);
+    bool loaded = elf.empty() ? iss.load_hex(imem_hex, false) : iss.load_elf(elf);
+    if (loaded && !dmem_hex.empty()) {
+        loaded = iss.load_hex(dmem_hex, true);
+    }
+    if (!loaded) {
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    iss_stop_t reason = iss.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fflush(stdout);
+
+    switch (reason) {
+        case STOP_EXIT:      fprintf(stderr, "\nExit code %d\n", iss.exit_code()); break;
+        case STOP_EBREAK:    fprintf(stderr, "\nebreak at 0x%08x\n", iss.pc()); break;
+        case STOP_MAX_INSNS: fprintf(stderr, "\nInstruction limit reached at 0x%08x\n", iss.pc()); break;
+        default:             fprintf(stderr, "\nFault: %s\n", iss.fault().c_str()); break;
+    }
+
+    print_report(iss, seconds);
+    if (profile) {
+        print_profile(iss);
+    }
+    if (regs) {
+        print_regs(iss);
+    }
+
+    if (reason == STOP_FAULT) {
+        return 1;
+    }
+    return reason == STOP_EXIT ? iss.exit_code() : 0;
+}
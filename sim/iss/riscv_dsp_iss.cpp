@@ -0,0 +1,1044 @@
+//=============================================================================
+// Instruction-Set Simulator for RISC-V DSP Processor
+// Decoder, pre-decoded instruction cache, execution and pipeline timing
+//=============================================================================
+
+#include "riscv_dsp_iss.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+// Mnemonics for the trace, indexed by iss_op_t
+static const char *const op_names[OP_COUNT] = {
+    "illegal",
+    "lui", "auipc", "jal", "jalr",
+    "beq", "bne", "blt", "bge", "bltu", "bgeu",
+    "lb", "lh", "lw", "lbu", "lhu",
+    "sb", "sh", "sw",
+    "addi", "slti", "sltiu", "xori", "ori", "andi", "slli", "srli", "srai",
+    "add", "sub", "sll", "slt", "sltu", "xor", "srl", "sra", "or", "and",
+    "fence", "ecall", "ebreak",
+    "csrrw", "csrrs", "csrrc", "csrrwi", "csrrsi", "csrrci",
+    "mac", "simd8", "simd16",
+    "sat", "clip", "round", "bitrev", "circ",
+    "macc", "macc.clr", "macc.rd", "macc2",
+    "macc.xy", "macc2.xy",
+    "lp.setup", "lp.setupi",
+    "p.lb", "p.lh", "p.lw", "p.sb", "p.sh", "p.sw"
+};
+
+// Little-endian accessors for the byte-addressed memories
+static inline uint32_t load32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint16_t load16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline void store32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline void store16(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+// Sign-extend the low bits of a field
+static inline int32_t sext(uint32_t value, int bits) {
+    return (int32_t)(value << (32 - bits)) >> (32 - bits);
+}
+
+static inline int32_t clamp_64(int64_t value, int64_t lo, int64_t hi) {
+    return (int32_t)(value < lo ? lo : (value > hi ? hi : value));
+}
+
+//=============================================================================
+// Extension semantics
+//=============================================================================
+
+// MAC (funct7 = 0000001): rd + rs1 * rs2. funct3[1:0] selects the operand
+// signedness like mac_unit.v, funct3[2] saturates the sum to 32 bits.
+static uint32_t exec_mac(uint32_t acc, uint32_t a, uint32_t b, uint8_t funct3) {
+    int64_t product;
+    switch (funct3 & 3) {
+        case 1:  product = (int64_t)((uint64_t)a * b); break;                  // unsigned
+        case 2:  product = (int64_t)(int32_t)a * (int64_t)(uint64_t)b; break;  // signed x unsigned
+        default: product = (int64_t)(int32_t)a * (int32_t)b; break;            // signed
+    }
+
+    if (!(funct3 & 4)) {
+        return acc + (uint32_t)product;
+    }
+    if ((funct3 & 3) == 1) {
+        uint64_t sum = (uint64_t)acc + (uint64_t)product;
+        return sum > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)sum;
+    }
+    return (uint32_t)clamp_64((int64_t)(int32_t)acc + product, INT32_MIN, INT32_MAX);
+}
+
+// Wrap to the 40-bit accumulator of mac_unit.v
+static inline int64_t wrap_40(int64_t value) {
+    return (int64_t)((uint64_t)value << 24) >> 24;
+}
+
+// macc.rd: round half up, shift right by rs1[5:0] and saturate to 32 bits
+static uint32_t exec_macc_rd(int64_t acc, uint32_t shift) {
+    shift &= 63;
+    if (shift > 40) {
+        return acc < 0 ? 0xFFFFFFFFu : 0;
+    }
+    if (shift != 0) {
+        acc = (acc + ((int64_t)1 << (shift - 1))) >> shift;
+    }
+    return (uint32_t)clamp_64(acc, INT32_MIN, INT32_MAX);
+}
+
+// SIMD on four unsigned 8-bit lanes, as simd_unit.v width 00. DOT4 (op 7)
+// sums the four signed lane products.
+static uint32_t exec_simd8(uint32_t a, uint32_t b, uint8_t op) {
+    if (op == 7) {
+        int32_t sum = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            sum += (int8_t)(a >> (8 * lane)) * (int8_t)(b >> (8 * lane));
+        }
+        return (uint32_t)sum;
+    }
+    uint32_t result = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        uint32_t x = (a >> (8 * lane)) & 0xFF;
+        uint32_t y = (b >> (8 * lane)) & 0xFF;
+        uint32_t r;
+        switch (op) {
+            case 0:  r = std::min<uint32_t>(x + y, 0xFF); break;   // ADD4, saturating
+            case 1:  r = x >= y ? x - y : 0; break;                // SUB4, floor at 0
+            case 2:  r = x * y; break;                             // MUL4, low bits
+            case 3:  r = x & y; break;                             // AND4
+            case 4:  r = x | y; break;                             // OR4
+            case 5:  r = x ^ y; break;                             // XOR4
+            case 6:  r = x << (b & 7); break;                      // SHIFT4 by rs2[2:0]
+            default: r = 0; break;
+        }
+        result |= (r & 0xFF) << (8 * lane);
+    }
+    return result;
+}
+
+// SIMD on two unsigned 16-bit lanes, as simd_unit.v width 01. DOT2 (op 3)
+// and DOTS2 (op 4) add or subtract the signed lane products; only the sum
+// can overflow and it saturates.
+static uint32_t exec_simd16(uint32_t a, uint32_t b, uint8_t op) {
+    if (op == 3 || op == 4) {
+        int64_t lo = (int64_t)(int16_t)a * (int16_t)b;
+        int64_t hi = (int64_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+        return (uint32_t)clamp_64(op == 3 ? lo + hi : lo - hi, INT32_MIN, INT32_MAX);
+    }
+    uint32_t result = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        uint32_t x = (a >> (16 * lane)) & 0xFFFF;
+        uint32_t y = (b >> (16 * lane)) & 0xFFFF;
+        uint32_t r;
+        switch (op) {
+            case 0:  r = std::min<uint32_t>(x + y, 0xFFFF); break; // ADD2, saturating
+            case 1:  r = x >= y ? x - y : 0; break;                // SUB2, floor at 0
+            case 2:  r = x * y; break;                             // MUL2, low bits
+            default: r = 0; break;
+        }
+        result |= (r & 0xFFFF) << (16 * lane);
+    }
+    return result;
+}
+
+// Reverse the low n bits of a value (n = rs2[4:0], 0 meaning 32)
+static uint32_t bit_reverse_n(uint32_t value, uint32_t n) {
+    n = (n & 31) ? (n & 31) : 32;
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        result = (result << 1) | ((value >> i) & 1);
+    }
+    return result;
+}
+
+//=============================================================================
+// Construction and loading
+//=============================================================================
+
+riscv_dsp_iss::riscv_dsp_iss(const iss_config_t &config)
+    : config_(config),
+      imem_(config.imem_size, 0),
+      dmem_(config.unified ? 0 : config.dmem_size, 0),
+      icache_(config.imem_size / 4),
+      entry_(config.reset_pc) {
+    // Empty instruction memory holds NOPs, like memory_interface.v
+    for (uint32_t addr = 0; addr + 4 <= config_.imem_size && !config_.unified; addr += 4) {
+        store32(&imem_[addr], 0x00000013);
+    }
+    reset();
+}
+
+void riscv_dsp_iss::reset() {
+    memset(regs_, 0, sizeof(regs_));
+    acc_ = 0;
+    memset(loop_start_, 0, sizeof(loop_start_));
+    memset(loop_end_, 0, sizeof(loop_end_));
+    memset(loop_count_, 0, sizeof(loop_count_));
+    addr_base_ = addr_size_ = addr_brev_ = 0;
+    memset(dma_, 0, sizeof(dma_));
+    uint32_t top = config_.unified ? config_.imem_size : config_.dmem_size;
+    regs_[2] = top & ~15u;      // sp at the top of data memory
+    pc_ = entry_;
+    stats_ = iss_stats_t();
+    for (iss_function_t &f : functions_) {
+        f.calls = f.instret = f.cycles = 0;
+    }
+    stop_ = STOP_NONE;
+    exit_code_ = 0;
+    fault_.clear();
+    for (iss_insn_t &e : icache_) {
+        e.valid = 0;
+    }
+}
+
+// ELF32 structures (little-endian RISC-V only)
+struct elf32_ehdr_t {
+    uint8_t  ident[16];
+    uint16_t type, machine;
+    uint32_t version, entry, phoff, shoff, flags;
+    uint16_t ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+};
+
+struct elf32_phdr_t {
+    uint32_t type, offset, vaddr, paddr, filesz, memsz, flags, align;
+};
+
+struct elf32_shdr_t {
+    uint32_t name, type, flags, addr, offset, size, link, info, addralign, entsize;
+};
+
+struct elf32_sym_t {
+    uint32_t name, value, size;
+    uint8_t  info, other;
+    uint16_t shndx;
+};
+
+bool riscv_dsp_iss::load_elf(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        fprintf(stderr, "iss: cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    elf32_ehdr_t eh;
+    if (image.size() < sizeof(eh)) {
+        fprintf(stderr, "iss: %s: not an ELF file\n", path.c_str());
+        return false;
+    }
+    memcpy(&eh, image.data(), sizeof(eh));
+    if (memcmp(eh.ident, "\177ELF", 4) != 0 || eh.ident[4] != 1 || eh.ident[5] != 1 || eh.machine != 243) {
+        fprintf(stderr, "iss: %s: not a 32-bit little-endian RISC-V ELF\n", path.c_str());
+        return false;
+    }
+
+    // Loadable segments
+    for (int i = 0; i < eh.phnum; i++) {
+        elf32_phdr_t ph;
+        size_t offset = eh.phoff + (size_t)i * eh.phentsize;
+        if (offset + sizeof(ph) > image.size()) {
+            return false;
+        }
+        memcpy(&ph, &image[offset], sizeof(ph));
+        if (ph.type != 1 || ph.memsz == 0) {
+            continue;
+        }
+
+        bool code = (ph.flags & 1) != 0;
+        std::vector<uint8_t> &mem = (code || config_.unified) ? imem_ : dmem_;
+        if ((uint64_t)ph.vaddr + ph.memsz > mem.size() || (uint64_t)ph.offset + ph.filesz > image.size()) {
+            fprintf(stderr, "iss: %s: segment 0x%08x+0x%x does not fit in %s memory (%zu bytes)\n",
+                    path.c_str(), ph.vaddr, ph.memsz, &mem == &imem_ ? "instruction" : "data", mem.size());
+            return false;
+        }
+        std::fill(mem.begin() + ph.vaddr, mem.begin() + ph.vaddr + ph.memsz, 0);
+        memcpy(&mem[ph.vaddr], &image[ph.offset], ph.filesz);
+    }
+
+    // Function symbols for the profile
+    functions_.clear();
+    for (int i = 0; i < eh.shnum; i++) {
+        elf32_shdr_t sh, strtab;
+        size_t offset = eh.shoff + (size_t)i * eh.shentsize;
+        if (offset + sizeof(sh) > image.size()) {
+            break;
+        }
+        memcpy(&sh, &image[offset], sizeof(sh));
+        if (sh.type != 2 || sh.link >= eh.shnum) {
+            continue;
+        }
+        memcpy(&strtab, &image[eh.shoff + (size_t)sh.link * eh.shentsize], sizeof(strtab));
+
+        for (uint32_t s = 0; s + sizeof(elf32_sym_t) <= sh.size; s += sizeof(elf32_sym_t)) {
+            elf32_sym_t sym;
+            if ((size_t)sh.offset + s + sizeof(sym) > image.size()) {
+                break;
+            }
+            memcpy(&sym, &image[sh.offset + s], sizeof(sym));
+            if ((sym.info & 0xF) != 2 || sym.shndx == 0 || strtab.offset + sym.name >= image.size()) {
+                continue;
+            }
+            iss_function_t f;
+            f.name = (const char*)&image[strtab.offset + sym.name];
+            f.start = sym.value;
+            f.end = sym.value + sym.size;
+            functions_.push_back(f);
+        }
+    }
+
+    // Sort, drop aliases and give unsized symbols the gap up to the next one
+    std::sort(functions_.begin(), functions_.end(),
+              [](const iss_function_t &a, const iss_function_t &b) { return a.start < b.start; });
+    functions_.erase(std::unique(functions_.begin(), functions_.end(),
+                                 [](const iss_function_t &a, const iss_function_t &b) { return a.start == b.start; }),
+                     functions_.end());
+    for (size_t i = 0; i < functions_.size(); i++) {
+        uint32_t next = (i + 1 < functions_.size()) ? functions_[i + 1].start : config_.imem_size;
+        if (functions_[i].end <= functions_[i].start || functions_[i].end > next) {
+            functions_[i].end = next;
+        }
+    }
+
+    entry_ = eh.entry;
+    reset();
+    return true;
+}
+
+bool riscv_dsp_iss::load_hex(const std::string &path, bool data) {
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "iss: cannot open %s\n", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> &mem = (data && !config_.unified) ? dmem_ : imem_;
+
+    std::string line;
+    uint32_t word = 0;
+    while (std::getline(file, line)) {
+        size_t comment = line.find("//");
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream tokens(line);
+        std::string token;
+        while (tokens >> token) {
+            if (token[0] == '@') {
+                word = (uint32_t)strtoul(token.c_str() + 1, nullptr, 16);
+                continue;
+            }
+            if ((uint64_t)word * 4 + 4 > mem.size()) {
+                fprintf(stderr, "iss: %s: word address 0x%x out of range\n", path.c_str(), word);
+                return false;
+            }
+            store32(&mem[word * 4], (uint32_t)strtoul(token.c_str(), nullptr, 16));
+            word++;
+        }
+    }
+    reset();
+    return true;
+}
+
+//=============================================================================
+// Decode
+//=============================================================================
+
+int32_t riscv_dsp_iss::find_function(uint32_t pc) const {
+    auto it = std::upper_bound(functions_.begin(), functions_.end(), pc,
+                               [](uint32_t value, const iss_function_t &f) { return value < f.start; });
+    if (it == functions_.begin()) {
+        return -1;
+    }
+    --it;
+    return (pc < it->end) ? (int32_t)(it - functions_.begin()) : -1;
+}
+
+iss_insn_t riscv_dsp_iss::decode(uint32_t word, uint32_t pc) const {
+    iss_insn_t d;
+    memset(&d, 0, sizeof(d));
+    d.op = OP_ILLEGAL;
+    d.rd = (word >> 7) & 31;
+    d.rs1 = (word >> 15) & 31;
+    d.rs2 = (word >> 20) & 31;
+    d.valid = 1;
+    d.function = find_function(pc);
+
+    uint32_t opcode = word & 0x7F;
+    uint32_t funct3 = (word >> 12) & 7;
+    uint32_t funct7 = word >> 25;
+    bool uses_rs1 = false, uses_rs2 = false, uses_rd = false, writes = false;
+
+    switch (opcode) {
+        case 0x37:  // LUI
+            d.op = OP_LUI;
+            d.imm = (int32_t)(word & 0xFFFFF000);
+            writes = true;
+            break;
+        case 0x17:  // AUIPC
+            d.op = OP_AUIPC;
+            d.imm = (int32_t)(word & 0xFFFFF000);
+            writes = true;
+            break;
+        case 0x6F:  // JAL
+            d.op = OP_JAL;
+            d.imm = sext(((word >> 31) << 20) | (((word >> 12) & 0xFF) << 12) |
+                         (((word >> 20) & 1) << 11) | (((word >> 21) & 0x3FF) << 1), 21);
+            writes = true;
+            break;
+        case 0x67:  // JALR
+            if (funct3 == 0) {
+                d.op = OP_JALR;
+                d.imm = sext(word >> 20, 12);
+                uses_rs1 = writes = true;
+            }
+            break;
+        case 0x63: {  // Branches
+            static const iss_op_t ops[8] = {OP_BEQ, OP_BNE, OP_ILLEGAL, OP_ILLEGAL,
+                                            OP_BLT, OP_BGE, OP_BLTU, OP_BGEU};
+            d.op = ops[funct3];
+            d.imm = sext(((word >> 31) << 12) | (((word >> 7) & 1) << 11) |
+                         (((word >> 25) & 0x3F) << 5) | (((word >> 8) & 0xF) << 1), 13);
+            uses_rs1 = uses_rs2 = true;
+            break;
+        }
+        case 0x03: {  // Loads
+            static const iss_op_t ops[8] = {OP_LB, OP_LH, OP_LW, OP_ILLEGAL,
+                                            OP_LBU, OP_LHU, OP_ILLEGAL, OP_ILLEGAL};
+            d.op = ops[funct3];
+            d.imm = sext(word >> 20, 12);
+            d.is_load = 1;
+            uses_rs1 = writes = true;
+            break;
+        }
+        case 0x23: {  // Stores
+            static const iss_op_t ops[8] = {OP_SB, OP_SH, OP_SW, OP_ILLEGAL,
+                                            OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL};
+            d.op = ops[funct3];
+            d.imm = sext(((word >> 25) << 5) | ((word >> 7) & 31), 12);
+            uses_rs1 = uses_rs2 = true;
+            break;
+        }
+        case 0x13: {  // Register-immediate
+            static const iss_op_t ops[8] = {OP_ADDI, OP_SLLI, OP_SLTI, OP_SLTIU,
+                                            OP_XORI, OP_SRLI, OP_ORI, OP_ANDI};
+            d.op = ops[funct3];
+            d.imm = sext(word >> 20, 12);
+            if (funct3 == 1) {
+                d.op = (funct7 == 0) ? OP_SLLI : OP_ILLEGAL;
+                d.imm = d.rs2;
+            } else if (funct3 == 5) {
+                d.op = (funct7 == 0) ? OP_SRLI : (funct7 == 0x20) ? OP_SRAI : OP_ILLEGAL;
+                d.imm = d.rs2;
+            }
+            uses_rs1 = writes = true;
+            break;
+        }
+        case 0x33:  // Register-register and the MAC/SIMD extensions
+            uses_rs1 = uses_rs2 = writes = true;
+            if (funct7 == 0x00) {
+                static const iss_op_t ops[8] = {OP_ADD, OP_SLL, OP_SLT, OP_SLTU,
+                                                OP_XOR, OP_SRL, OP_OR, OP_AND};
+                d.op = ops[funct3];
+            } else if (funct7 == 0x20) {
+                d.op = (funct3 == 0) ? OP_SUB : (funct3 == 5) ? OP_SRA : OP_ILLEGAL;
+            } else if (funct7 == 0x01) {
+                d.op = OP_MAC;
+                d.funct = (uint8_t)funct3;
+                uses_rd = true;
+            } else if (funct7 == 0x02) {
+                d.op = OP_SIMD8;
+                d.funct = (uint8_t)funct3;
+            } else if (funct7 == 0x03) {
+                d.op = OP_SIMD16;
+                d.funct = (uint8_t)funct3;
+            }
+            break;
+        case 0x0B: {  // Custom DSP
+            static const iss_op_t ops[8] = {OP_SAT, OP_CLIP, OP_ROUND, OP_BITREV,
+                                            OP_CIRC, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL};
+            d.op = ops[funct3];
+            uses_rs1 = uses_rs2 = writes = true;
+            break;
+        }
+        case 0x2B: {  // Accumulator MAC
+            static const iss_op_t ops[8] = {OP_MACC, OP_MACC_CLR, OP_MACC_RD, OP_MACC2,
+                                            OP_MACC_XY, OP_MACC2_XY, OP_ILLEGAL, OP_ILLEGAL};
+            d.op = ops[funct3];
+            uses_rs1 = true;
+            uses_rs2 = funct3 != 2;
+            writes = funct3 == 2;
+            if (funct3 == 4 || funct3 == 5) {
+                // Dual load: bank Y step in imm (funct7[2] backwards), mode
+                // in funct (funct7[0] circular)
+                int32_t size = (funct3 == 5) ? 4 : 2;
+                d.imm = (funct7 & 4) ? -size : size;
+                d.funct = (uint8_t)(funct7 & 1);
+                d.op = ((funct7 & ~5u) == 0) ? d.op : OP_ILLEGAL;
+                writes = true;
+            }
+            break;
+        }
+        case 0x5B:  // Hardware loop setup: level rd[0], end at pc + imm
+            if (funct3 <= 1) {
+                d.op = (funct3 == 0) ? OP_LP_SETUP : OP_LP_SETUPI;
+                d.funct = (uint8_t)(d.rd & 1);
+                d.imm = sext(word >> 20, 12);
+                uses_rs1 = funct3 == 0;
+            }
+            break;
+        case 0x7B: {  // Post-increment loads/stores: mode imm[11:10], step imm[9:0]
+            static const iss_op_t ops[8] = {OP_PLB, OP_PLH, OP_PLW, OP_ILLEGAL,
+                                            OP_PSB, OP_PSH, OP_PSW, OP_ILLEGAL};
+            uint32_t imm = (funct3 & 4) ? (((word >> 25) << 5) | ((word >> 7) & 31)) : (word >> 20);
+            if ((imm >> 10) != 3) {
+                d.op = ops[funct3];
+                d.funct = (uint8_t)(imm >> 10);
+                d.imm = sext(imm & 0x3FF, 10);
+                d.is_load = (funct3 & 4) == 0;
+                uses_rs1 = true;
+                uses_rs2 = !d.is_load;
+                writes = d.is_load;
+            }
+            break;
+        }
+        case 0x0F:  // FENCE / FENCE.I
+            d.op = OP_FENCE;
+            break;
+        case 0x73:  // SYSTEM
+            if (funct3 == 0) {
+                d.op = (word == 0x00000073) ? OP_ECALL : (word == 0x00100073) ? OP_EBREAK : OP_ILLEGAL;
+            } else if (funct3 != 4) {
+                static const iss_op_t ops[8] = {OP_ILLEGAL, OP_CSRRW, OP_CSRRS, OP_CSRRC,
+                                                OP_ILLEGAL, OP_CSRRWI, OP_CSRRSI, OP_CSRRCI};
+                d.op = ops[funct3];
+                d.imm = (int32_t)(word >> 20);
+                uses_rs1 = funct3 < 4;
+                writes = true;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (d.op == OP_ILLEGAL) {
+        d.rd = 0;
+        return d;
+    }
+
+    d.writes_rd = writes && d.rd != 0;
+    if (!d.writes_rd) {
+        d.rd = 0;
+    }
+
+    // Hazard sources. The RTL compares the rs1/rs2 fields of every
+    // instruction, whether or not they are register operands.
+    if (config_.timing.rtl_hazard_fields) {
+        d.hazard_rs1 = (word >> 15) & 31;
+        d.hazard_rs2 = (word >> 20) & 31;
+    } else {
+        d.hazard_rs1 = uses_rs1 ? d.rs1 : 0;
+        d.hazard_rs2 = uses_rs2 ? d.rs2 : 0;
+        d.hazard_rs3 = uses_rd ? d.rd : 0;
+    }
+    return d;
+}
+
+// Decoded entry for pc, decoding on first use
+iss_insn_t *riscv_dsp_iss::fetch(uint32_t pc) {
+    if ((pc & 3) != 0 || pc >= config_.imem_size) {
+        char message[64];
+        snprintf(message, sizeof(message), "fetch from 0x%08x", pc);
+        stop(STOP_FAULT, message);
+        return nullptr;
+    }
+    iss_insn_t *entry = &icache_[pc >> 2];
+    if (!entry->valid) {
+        *entry = decode(load32(&imem_[pc]), pc);
+    }
+    return entry;
+}
+
+// Self-modifying code: stores into a unified memory drop the cached decode
+void riscv_dsp_iss::invalidate(uint32_t addr) {
+    if (addr < config_.imem_size) {
+        icache_[addr >> 2].valid = 0;
+    }
+}
+
+//=============================================================================
+// Memory, CSRs and environment calls
+//=============================================================================
+
+uint8_t *riscv_dsp_iss::data_ptr(uint32_t addr, uint32_t size, bool write) {
+    std::vector<uint8_t> &mem = config_.unified ? imem_ : dmem_;
+    if ((addr & (size - 1)) != 0 || (uint64_t)addr + size > mem.size()) {
+        char message[64];
+        snprintf(message, sizeof(message), "%s of %u bytes at 0x%08x", write ? "store" : "load", size, addr);
+        stop(STOP_FAULT, message);
+        return nullptr;
+    }
+    if (write && config_.unified) {
+        invalidate(addr & ~3u);
+    }
+    return &mem[addr];
+}
+
+// Addressing CSRs and the read-only user and machine counters
+bool riscv_dsp_iss::csr_access(uint32_t csr, uint32_t write_value, bool write, uint32_t &read_value) {
+    uint32_t *addr_csr = (csr == 0x800) ? &addr_base_ : (csr == 0x801) ? &addr_size_ :
+                         (csr == 0x802) ? &addr_brev_ : nullptr;
+    if (addr_csr != nullptr) {
+        read_value = *addr_csr;
+        if (write) {
+            *addr_csr = (csr == 0x802) ? (write_value & 31) : write_value;
+        }
+        return true;
+    }
+
+    // DMA descriptors 0x810-0x815: no stream is attached, so the channels
+    // never move and the status bits can only be cleared
+    if (csr >= 0x810 && csr <= 0x815) {
+        uint32_t &dma_csr = dma_[csr - 0x810];
+        read_value = dma_csr;
+        if (write) {
+            switch (csr) {
+                case 0x810: dma_csr = write_value & 0xF; break;
+                case 0x811: dma_csr &= write_value & 0x33; break;
+                case 0x813:
+                case 0x815: dma_csr = write_value & 0xFFFF; break;
+                default:    dma_csr = write_value; break;
+            }
+        }
+        return true;
+    }
+
+    uint64_t value;
+    switch (csr & 0x7F) {
+        case 0x00:
+        case 0x01: value = stats_.cycles; break;                        // cycle, time
+        case 0x02: value = stats_.instret; break;                       // instret
+        case 0x03: value = stats_.load_use_stalls; break;               // load-use stall cycles
+        case 0x04: value = 0; break;                                     // memory stalls (none)
+        case 0x05: value = stats_.branches_taken + stats_.jumps; break; // branch/jump flushes
+        case 0x06: value = stats_.mac_ops; break;                        // MAC busy cycles
+        case 0x07: value = stats_.simd_ops; break;                       // SIMD busy cycles
+        case 0x08: value = stats_.raw_stalls; break;                     // RAW stall cycles
+        default: return false;
+    }
+    uint32_t base = csr & ~0x7Fu;
+    if (base != 0xC00 && base != 0xC80 && base != 0xB00 && base != 0xB80) {
+        return false;
+    }
+    // Writes are ignored, as in perf_counters.v
+    read_value = (base == 0xC80 || base == 0xB80) ? (uint32_t)(value >> 32) : (uint32_t)value;
+    return true;
+}
+
+// Access address of a post-increment load/store (memory_interface)
+uint32_t riscv_dsp_iss::agu_address(uint32_t ptr, uint32_t mode, uint32_t size) const {
+    if (mode == 1 && addr_size_ != 0) {
+        return addr_base_ + (ptr - addr_base_) % addr_size_;
+    }
+    if (mode == 2) {
+        uint32_t shift = (size == 4) ? 2 : (size == 2) ? 1 : 0;
+        uint32_t index = (ptr - addr_base_) >> shift;
+        uint32_t reversed = 0;
+        for (uint32_t i = 0; i < addr_brev_; i++) {
+            reversed = (reversed << 1) | ((index >> i) & 1);
+        }
+        return addr_base_ + (reversed << shift);
+    }
+    return ptr;
+}
+
+// Address register after a post-increment access (address_generator)
+uint32_t riscv_dsp_iss::agu_next(uint32_t ptr, int32_t step, uint32_t mode) const {
+    uint32_t next = ptr + (uint32_t)step;
+    if (mode == 1) {
+        if (step >= 0 && next >= addr_base_ + addr_size_) {
+            next -= addr_size_;
+        } else if (step < 0 && next < addr_base_) {
+            next += addr_size_;
+        }
+    }
+    return next;
+}
+
+// a7 = 93: exit(a0); a7 = 64: write(a0, a1, a2)
+bool riscv_dsp_iss::ecall() {
+    switch (regs_[17]) {
+        case 93:
+            exit_code_ = (int32_t)regs_[10];
+            stop(STOP_EXIT, "");
+            return true;
+        case 64: {
+            uint32_t length = regs_[12];
+            for (uint32_t i = 0; i < length; i++) {
+                uint8_t *p = data_ptr(regs_[11] + i, 1, false);
+                if (p == nullptr) {
+                    return false;
+                }
+                fputc(*p, regs_[10] == 2 ? stderr : stdout);
+            }
+            regs_[10] = length;
+            return true;
+        }
+        default: {
+            char message[64];
+            snprintf(message, sizeof(message), "unsupported ecall %u", regs_[17]);
+            stop(STOP_FAULT, message);
+            return false;
+        }
+    }
+}
+
+void riscv_dsp_iss::stop(iss_stop_t reason, const std::string &message) {
+    if (stop_ == STOP_NONE) {
+        stop_ = reason;
+        fault_ = message;
+    }
+}
+
+//=============================================================================
+// Execution loop
+//=============================================================================
+
+iss_stop_t riscv_dsp_iss::run() {
+    const iss_timing_t &timing = config_.timing;
+    uint8_t ex_rd = 0;          // Destination of the previous instruction (now in EX)
+    bool ex_load = false;
+
+    if (stats_.cycles == 0) {
+        stats_.cycles = timing.pipeline_fill;
+    }
+
+    while (stop_ == STOP_NONE) {
+        if (config_.max_insns != 0 && stats_.instret >= config_.max_insns) {
+            stop(STOP_MAX_INSNS, "");
+            break;
+        }
+
+        const uint32_t pc = pc_;
+        iss_insn_t *insn = fetch(pc);
+        if (insn == nullptr) {
+            break;
+        }
+
+        // Interlock against the instruction one stage ahead
+        uint32_t cycles = 1;
+        if (ex_rd != 0 && (insn->hazard_rs1 == ex_rd || insn->hazard_rs2 == ex_rd || insn->hazard_rs3 == ex_rd)) {
+            if (ex_load) {
+                cycles += timing.load_use_penalty;
+                stats_.load_use_stalls += timing.load_use_penalty;
+            } else if (!timing.forwarding) {
+                cycles += timing.raw_penalty;
+                stats_.raw_stalls += timing.raw_penalty;
+            }
+        }
+
+        const uint32_t a = regs_[insn->rs1];
+        const uint32_t b = regs_[insn->rs2];
+        uint32_t result = 0;
+        uint32_t next_pc = pc + 4;
+        bool taken = false;
+        uint8_t *p;
+
+        switch (insn->op) {
+            case OP_LUI:   result = (uint32_t)insn->imm; break;
+            case OP_AUIPC: result = pc + (uint32_t)insn->imm; break;
+            case OP_JAL:
+                result = pc + 4;
+                next_pc = pc + (uint32_t)insn->imm;
+                taken = true;
+                break;
+            case OP_JALR:
+                result = pc + 4;
+                next_pc = (a + (uint32_t)insn->imm) & ~1u;
+                taken = true;
+                break;
+
+            case OP_BEQ:  taken = a == b; break;
+            case OP_BNE:  taken = a != b; break;
+            case OP_BLT:  taken = (int32_t)a < (int32_t)b; break;
+            case OP_BGE:  taken = (int32_t)a >= (int32_t)b; break;
+            case OP_BLTU: taken = a < b; break;
+            case OP_BGEU: taken = a >= b; break;
+
+            case OP_LB:
+                if ((p = data_ptr(a + insn->imm, 1, false)) != nullptr) result = (uint32_t)(int8_t)*p;
+                break;
+            case OP_LBU:
+                if ((p = data_ptr(a + insn->imm, 1, false)) != nullptr) result = *p;
+                break;
+            case OP_LH:
+                if ((p = data_ptr(a + insn->imm, 2, false)) != nullptr) result = (uint32_t)(int16_t)load16(p);
+                break;
+            case OP_LHU:
+                if ((p = data_ptr(a + insn->imm, 2, false)) != nullptr) result = load16(p);
+                break;
+            case OP_LW:
+                if ((p = data_ptr(a + insn->imm, 4, false)) != nullptr) result = load32(p);
+                break;
+            case OP_SB:
+                if ((p = data_ptr(a + insn->imm, 1, true)) != nullptr) *p = (uint8_t)b;
+                break;
+            case OP_SH:
+                if ((p = data_ptr(a + insn->imm, 2, true)) != nullptr) store16(p, b);
+                break;
+            case OP_SW:
+                if ((p = data_ptr(a + insn->imm, 4, true)) != nullptr) store32(p, b);
+                break;
+
+            case OP_ADDI:  result = a + (uint32_t)insn->imm; break;
+            case OP_SLTI:  result = (int32_t)a < insn->imm; break;
+            case OP_SLTIU: result = a < (uint32_t)insn->imm; break;
+            case OP_XORI:  result = a ^ (uint32_t)insn->imm; break;
+            case OP_ORI:   result = a | (uint32_t)insn->imm; break;
+            case OP_ANDI:  result = a & (uint32_t)insn->imm; break;
+            case OP_SLLI:  result = a << insn->imm; break;
+            case OP_SRLI:  result = a >> insn->imm; break;
+            case OP_SRAI:  result = (uint32_t)((int32_t)a >> insn->imm); break;
+
+            case OP_ADD:  result = a + b; break;
+            case OP_SUB:  result = a - b; break;
+            case OP_SLL:  result = a << (b & 31); break;
+            case OP_SLT:  result = (int32_t)a < (int32_t)b; break;
+            case OP_SLTU: result = a < b; break;
+            case OP_XOR:  result = a ^ b; break;
+            case OP_SRL:  result = a >> (b & 31); break;
+            case OP_SRA:  result = (uint32_t)((int32_t)a >> (b & 31)); break;
+            case OP_OR:   result = a | b; break;
+            case OP_AND:  result = a & b; break;
+
+            case OP_FENCE: break;
+            case OP_ECALL: ecall(); break;
+            case OP_EBREAK: stop(STOP_EBREAK, ""); break;
+
+            case OP_CSRRW: case OP_CSRRS: case OP_CSRRC:
+            case OP_CSRRWI: case OP_CSRRSI: case OP_CSRRCI: {
+                bool immediate = insn->op >= OP_CSRRWI;
+                uint32_t source = immediate ? insn->rs1 : a;
+                bool write = (insn->op == OP_CSRRW || insn->op == OP_CSRRWI) || insn->rs1 != 0;
+                uint32_t written = source;
+                if (insn->op == OP_CSRRS || insn->op == OP_CSRRSI ||
+                    insn->op == OP_CSRRC || insn->op == OP_CSRRCI) {
+                    uint32_t old = 0;
+                    csr_access((uint32_t)insn->imm, 0, false, old);
+                    written = (insn->op == OP_CSRRS || insn->op == OP_CSRRSI) ? (old | source) : (old & ~source);
+                }
+                if (!csr_access((uint32_t)insn->imm, written, write, result)) {
+                    char message[64];
+                    snprintf(message, sizeof(message), "unsupported csr access 0x%03x", (uint32_t)insn->imm);
+                    stop(STOP_FAULT, message);
+                }
+                break;
+            }
+
+            case OP_MAC:
+                result = exec_mac(regs_[insn->rd], a, b, insn->funct);
+                stats_.mac_ops++;
+                break;
+            case OP_MACC:
+            case OP_MACC_CLR: {
+                int64_t product = (int64_t)(int16_t)a * (int16_t)b;
+                acc_ = wrap_40(insn->op == OP_MACC ? acc_ + product : product);
+                stats_.mac_ops++;
+                break;
+            }
+            case OP_MACC2: {
+                int64_t lo = (int64_t)(int16_t)a * (int16_t)b;
+                int64_t hi = (int64_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+                acc_ = wrap_40(acc_ + lo + hi);
+                stats_.mac_ops++;
+                break;
+            }
+            case OP_MACC_RD:
+                result = exec_macc_rd(acc_, a);
+                stats_.mac_ops++;
+                break;
+            case OP_MACC_XY:
+            case OP_MACC2_XY: {
+                // One operand from each data bank in the same cycle; rd gets
+                // the stepped bank X pointer, rs2 the stepped bank Y pointer
+                uint32_t size = (insn->op == OP_MACC2_XY) ? 4 : 2;
+                uint8_t *x = data_ptr(a & ~(uint32_t)ISS_DMEM_BANK_Y, size, false);
+                uint8_t *y = x ? data_ptr(b | ISS_DMEM_BANK_Y, size, false) : nullptr;
+                if (y == nullptr) {
+                    break;
+                }
+                if (size == 4) {
+                    uint32_t xw = load32(x), yw = load32(y);
+                    acc_ = wrap_40(acc_ + (int64_t)(int16_t)xw * (int16_t)yw +
+                                   (int64_t)(int16_t)(xw >> 16) * (int16_t)(yw >> 16));
+                } else {
+                    acc_ = wrap_40(acc_ + (int64_t)(int16_t)load16(x) * (int16_t)load16(y));
+                }
+                result = a + size;
+                if (insn->rs2 != 0) {
+                    regs_[insn->rs2] = agu_next(b, insn->imm, insn->funct);
+                }
+                stats_.loads += 2;
+                stats_.mac_ops++;
+                break;
+            }
+            case OP_LP_SETUP:
+            case OP_LP_SETUPI:
+                // The core sets the loop up in EX, by which time fetch has
+                // moved four instructions on; a shorter body is refetched
+                if (insn->imm >= 4 && insn->imm < 16) {
+                    cycles += timing.branch_penalty;
+                    stats_.branch_flush_cycles += timing.branch_penalty;
+                }
+                loop_start_[insn->funct] = pc + 4;
+                loop_end_[insn->funct] = pc + (uint32_t)insn->imm;
+                loop_count_[insn->funct] = (insn->op == OP_LP_SETUP) ? a : insn->rs1;
+                break;
+
+            case OP_PLB: case OP_PLH: case OP_PLW:
+            case OP_PSB: case OP_PSH: case OP_PSW: {
+                // Access through the address register, then update it; a
+                // load into the same register keeps the loaded value
+                uint32_t size = 1u << ((insn->op - OP_PLB) % 3);
+                bool store = insn->op >= OP_PSB;
+                if ((p = data_ptr(agu_address(a, insn->funct, size), size, store)) == nullptr) {
+                    break;
+                }
+                if (store) {
+                    if (size == 1) *p = (uint8_t)b;
+                    else if (size == 2) store16(p, b);
+                    else store32(p, b);
+                } else {
+                    result = (size == 1) ? (uint32_t)(int8_t)*p : (size == 2) ? (uint32_t)(int16_t)load16(p) : load32(p);
+                }
+                if (insn->rs1 != 0) {
+                    regs_[insn->rs1] = agu_next(a, insn->imm, insn->funct);
+                }
+                break;
+            }
+
+            case OP_SIMD8:
+                result = exec_simd8(a, b, insn->funct);
+                stats_.simd_ops++;
+                break;
+            case OP_SIMD16:
+                result = exec_simd16(a, b, insn->funct);
+                stats_.simd_ops++;
+                break;
+
+            case OP_SAT:
+                result = (uint32_t)clamp_64((int32_t)a, -32768, 32767);
+                stats_.dsp_ops++;
+                break;
+            case OP_CLIP:
+                result = (uint32_t)clamp_64((int32_t)a, -(int64_t)(int32_t)b, (int32_t)b);
+                stats_.dsp_ops++;
+                break;
+            case OP_ROUND:
+                result = a + (a & 1);
+                stats_.dsp_ops++;
+                break;
+            case OP_BITREV:
+                result = bit_reverse_n(a, b);
+                stats_.dsp_ops++;
+                break;
+            case OP_CIRC:
+                result = (b != 0) ? a % b : a;
+                stats_.dsp_ops++;
+                break;
+
+            default: {
+                char message[64];
+                snprintf(message, sizeof(message), "illegal instruction 0x%08x at 0x%08x", load32(&imem_[pc]), pc);
+                stop(STOP_FAULT, message);
+                break;
+            }
+        }
+
+        // A faulting instruction does not retire
+        if (stop_ == STOP_FAULT) {
+            break;
+        }
+
+        if (insn->writes_rd) {
+            regs_[insn->rd] = result;
+        }
+
+        // Control flow: taken branches and jumps flush IF and ID
+        if (insn->op >= OP_BEQ && insn->op <= OP_BGEU) {
+            stats_.branches++;
+            if (taken) {
+                stats_.branches_taken++;
+                next_pc = pc + (uint32_t)insn->imm;
+            }
+        } else if (insn->op == OP_JAL || insn->op == OP_JALR) {
+            stats_.jumps++;
+            if (insn->rd != 0 && !functions_.empty()) {
+                int32_t callee = find_function(next_pc);
+                if (callee >= 0 && functions_[callee].start == next_pc) {
+                    functions_[callee].calls++;
+                }
+            }
+        } else if (insn->is_load) {
+            stats_.loads++;
+        } else if ((insn->op >= OP_SB && insn->op <= OP_SW) || (insn->op >= OP_PSB && insn->op <= OP_PSW)) {
+            stats_.stores++;
+        }
+        if (taken) {
+            cycles += timing.branch_penalty;
+            stats_.branch_flush_cycles += timing.branch_penalty;
+        } else {
+            // Hardware loops redirect fetch at the loop end, inner level first
+            bool looped = false;
+            if (pc == loop_end_[0] && loop_count_[0] != 0) {
+                if (--loop_count_[0] != 0) {
+                    next_pc = loop_start_[0];
+                    looped = true;
+                }
+            }
+            if (!looped && pc == loop_end_[1] && loop_count_[1] != 0) {
+                if (--loop_count_[1] != 0) {
+                    next_pc = loop_start_[1];
+                    looped = true;
+                }
+            }
+            stats_.loop_backs += looped;
+        }
+
+        stats_.cycles += cycles;
+        stats_.instret++;
+        if (insn->function >= 0) {
+            iss_function_t &f = functions_[insn->function];
+            f.cycles += cycles;
+            f.instret++;
+        }
+
+        if (config_.trace) {
+            printf("%10llu  %08x: %08x  %-7s", (unsigned long long)stats_.cycles, pc, load32(&imem_[pc]),
+                   op_names[insn->op]);
+            if (insn->writes_rd) {
+                printf("  x%-2u = 0x%08x", insn->rd, result);
+            }
+            printf("\n");
+        }
+
+        ex_rd = insn->rd;
+        ex_load = insn->is_load;
+        pc_ = next_pc;
+    }
+    return stop_;
+}
@@ -0,0 +1,175 @@
+//=============================================================================
+// Instruction-Set Simulator for RISC-V DSP Processor
+// RV32I plus the MAC, SIMD and custom DSP extensions with cycle accounting
+//=============================================================================
+
+#ifndef RISCV_DSP_ISS_H
+#define RISCV_DSP_ISS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Memory map of riscv_dsp_core / memory_interface
+#define ISS_IMEM_SIZE   (16 * 1024)     // instruction_mem[0:4095]
+#define ISS_DMEM_SIZE   (8 * 1024)      // data_mem_x[0:1023], data_mem_y[0:1023]
+#define ISS_DMEM_BANK_Y 0x1000          // Address bit selecting data bank Y
+#define ISS_RESET_PC    0x1000
+
+// Pipeline timing model. The defaults follow control_unit.v: a one cycle
+// bubble whenever the instruction in ID reads a register written by the
+// instruction in EX (forwarding only covers MEM and WB), and a two cycle
+// flush for taken branches and jumps, which resolve in EX.
+struct iss_timing_t {
+    uint32_t raw_penalty = 1;       // ID reads a register written in EX
+    uint32_t load_use_penalty = 1;  // ID reads a register loaded in EX
+    uint32_t branch_penalty = 2;    // Taken branch or jump (IF/ID flushed)
+    uint32_t pipeline_fill = 4;     // Cycles before the first retirement
+    bool forwarding = false;        // Ideal EX->EX forwarding: only load-use stalls
+    bool rtl_hazard_fields = true;  // Compare the raw rs1/rs2 fields like the RTL
+};
+
+// Simulator configuration
+struct iss_config_t {
+    uint32_t imem_size = ISS_IMEM_SIZE;
+    uint32_t dmem_size = ISS_DMEM_SIZE;
+    bool unified = false;           // One memory for fetch and data (no Harvard split)
+    uint32_t reset_pc = ISS_RESET_PC;
+    uint64_t max_insns = 0;         // 0: run until exit/ebreak
+    bool trace = false;             // Print every retired instruction
+    iss_timing_t timing;
+};
+
+// Pre-decoded operation
+enum iss_op_t : uint8_t {
+    OP_ILLEGAL,
+    OP_LUI, OP_AUIPC, OP_JAL, OP_JALR,
+    OP_BEQ, OP_BNE, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU,
+    OP_LB, OP_LH, OP_LW, OP_LBU, OP_LHU,
+    OP_SB, OP_SH, OP_SW,
+    OP_ADDI, OP_SLTI, OP_SLTIU, OP_XORI, OP_ORI, OP_ANDI, OP_SLLI, OP_SRLI, OP_SRAI,
+    OP_ADD, OP_SUB, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_SRA, OP_OR, OP_AND,
+    OP_FENCE, OP_ECALL, OP_EBREAK,
+    OP_CSRRW, OP_CSRRS, OP_CSRRC, OP_CSRRWI, OP_CSRRSI, OP_CSRRCI,
+    OP_MAC,                         // funct7 = 0000001
+    OP_SIMD8,                       // funct7 = 0000010, 4 x 8-bit lanes
+    OP_SIMD16,                      // funct7 = 0000011, 2 x 16-bit lanes
+    OP_SAT, OP_CLIP, OP_ROUND, OP_BITREV, OP_CIRC,  // opcode 0001011
+    OP_MACC, OP_MACC_CLR, OP_MACC_RD, OP_MACC2,     // opcode 0101011
+    OP_MACC_XY, OP_MACC2_XY,                        // opcode 0101011, dual load
+    OP_LP_SETUP, OP_LP_SETUPI,                      // opcode 1011011
+    OP_PLB, OP_PLH, OP_PLW, OP_PSB, OP_PSH, OP_PSW, // opcode 1111011, post-increment
+    OP_COUNT
+};
+
+// Pre-decoded instruction cache entry, one per instruction memory word
+struct iss_insn_t {
+    iss_op_t op;
+    uint8_t rd;
+    uint8_t rs1;
+    uint8_t rs2;
+    uint8_t funct;                  // MAC mode / SIMD op / addressing mode
+    uint8_t hazard_rs1;             // Registers checked against the EX stage
+    uint8_t hazard_rs2;             // (0 = none)
+    uint8_t hazard_rs3;
+    uint8_t writes_rd;              // Result written to rd (rd != 0)
+    uint8_t is_load;
+    uint8_t valid;                  // Entry holds a decoded instruction
+    int32_t imm;
+    int32_t function;               // Index into the profile, -1 if unknown
+};
+
+// Aggregate counters
+struct iss_stats_t {
+    uint64_t cycles = 0;
+    uint64_t instret = 0;
+    uint64_t raw_stalls = 0;
+    uint64_t load_use_stalls = 0;
+    uint64_t branch_flush_cycles = 0;
+    uint64_t loop_backs = 0;        // Hardware loop iterations (no penalty)
+    uint64_t branches = 0;
+    uint64_t branches_taken = 0;
+    uint64_t jumps = 0;
+    uint64_t loads = 0;
+    uint64_t stores = 0;
+    uint64_t mac_ops = 0;
+    uint64_t simd_ops = 0;
+    uint64_t dsp_ops = 0;
+};
+
+// Per-function profile entry (flat: cycles of the function's own code)
+struct iss_function_t {
+    std::string name;
+    uint32_t start;
+    uint32_t end;
+    uint64_t calls = 0;
+    uint64_t instret = 0;
+    uint64_t cycles = 0;
+};
+
+// Why the simulator stopped
+enum iss_stop_t {
+    STOP_NONE,
+    STOP_EXIT,                      // ecall exit
+    STOP_EBREAK,
+    STOP_MAX_INSNS,
+    STOP_FAULT                      // Illegal instruction or bad access
+};
+
+class riscv_dsp_iss {
+public:
+    explicit riscv_dsp_iss(const iss_config_t &config);
+
+    // Program loading. Executable ELF segments go to instruction memory,
+    // the rest to data memory (both to the same memory when unified).
+    bool load_elf(const std::string &path);
+    // $readmemh image, word addressed like instruction_mem / data_mem
+    bool load_hex(const std::string &path, bool data);
+
+    void reset();
+    iss_stop_t run();
+
+    int32_t exit_code() const { return exit_code_; }
+    const std::string &fault() const { return fault_; }
+    const iss_stats_t &stats() const { return stats_; }
+    const std::vector<iss_function_t> &functions() const { return functions_; }
+    uint32_t reg(int index) const { return regs_[index]; }
+    uint32_t pc() const { return pc_; }
+
+private:
+    iss_insn_t decode(uint32_t word, uint32_t pc) const;
+    iss_insn_t *fetch(uint32_t pc);
+    void invalidate(uint32_t addr);
+    int32_t find_function(uint32_t pc) const;
+
+    uint8_t *data_ptr(uint32_t addr, uint32_t size, bool write);
+    bool csr_access(uint32_t csr, uint32_t write_value, bool write, uint32_t &read_value);
+    uint32_t agu_address(uint32_t ptr, uint32_t mode, uint32_t size) const;
+    uint32_t agu_next(uint32_t ptr, int32_t step, uint32_t mode) const;
+    bool ecall();
+    void stop(iss_stop_t reason, const std::string &message);
+
+    iss_config_t config_;
+    std::vector<uint8_t> imem_;
+    std::vector<uint8_t> dmem_;     // Unused when unified
+    std::vector<iss_insn_t> icache_;
+    std::vector<iss_function_t> functions_;
+    uint32_t entry_;
+
+    uint32_t regs_[32];
+    int64_t acc_;                   // 40-bit macc accumulator, sign-extended
+    uint32_t loop_start_[2];        // Hardware loops (0: inner, 1: outer)
+    uint32_t loop_end_[2];
+    uint32_t loop_count_[2];
+    uint32_t addr_base_;            // Post-increment addressing CSRs 0x800-0x802
+    uint32_t addr_size_;
+    uint32_t addr_brev_;
+    uint32_t dma_[6];               // DMA controller CSRs 0x810-0x815
+    uint32_t pc_;
+    iss_stats_t stats_;
+    iss_stop_t stop_;
+    int32_t exit_code_;
+    std::string fault_;
+};
+
+#endif // RISCV_DSP_ISS_H
@@ -0,0 +1,181 @@
+//=============================================================================
+// Verilator Harness for RISC-V DSP Processor
+// Runs a program image on riscv_dsp_core, checks registers, reports speed
+//=============================================================================
+//
+// Plusargs:
+//   +imem=FILE    Instruction memory image ($readmemh, read by memory_interface)
+//   +dmem=FILE    Data memory image ($readmemh, read by memory_interface)
+//   +cycles=N     Clock cycles to simulate after reset (default 1000)
+//   +expect=FILE  Expected register values, one "xN 0xVALUE" per line
+//   +asserts=FILE Hand-derived values: the "# expect xN 0xVALUE" comment
+//                 lines of the scenario source, checked on top of +expect
+//   +stream=START,PERIOD,COUNT
+//                 Feed COUNT receive samples (1, 2, 3, ...) on the external
+//                 stream, one every PERIOD cycles from cycle START
+//   +name=NAME    Scenario name for the report
+//   +trace        Print every register write
+//
+// The register file is shadowed from the write-back debug ports (reg_write,
+// rd, reg_write_data), so the harness only depends on the core's top-level
+// interface.
+
+#include "Vriscv_dsp_core.h"
+#include "verilated.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#ifndef TB_THREADS
+#define TB_THREADS 1
+#endif
+
+// Reset is held for this many cycles, like the UVM driver's reset_task
+#define RESET_CYCLES 5
+
+// Value of a +name=value plusarg, or nullptr
+static const char *plusarg(int argc, char **argv, const char *name) {
+    size_t length = strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '+' && strncmp(argv[i] + 1, name, length) == 0) {
+            const char *rest = argv[i] + 1 + length;
+            if (*rest == '=') {
+                return rest + 1;
+            }
+            if (*rest == '\0') {
+                return "";
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Compare the shadow register file with an expectation file. With tagged,
+// only "# expect" comment lines count (a scenario source).
+static int check_registers(const char *path, const uint32_t *regs, bool tagged) {
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "tb: cannot open %s\n", path);
+        return -1;
+    }
+
+    int errors = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        const char *text = line;
+        if (tagged) {
+            if (strncmp(line, "# expect ", 9) != 0) {
+                continue;
+            }
+            text += 9;
+        } else if (line[0] == '#') {
+            continue;
+        }
+        unsigned index;
+        unsigned long expected;
+        if (sscanf(text, " x%u %lx", &index, &expected) != 2 || index > 31) {
+            continue;
+        }
+        if (regs[index] != (uint32_t)expected) {
+            printf("  MISMATCH x%-2u expected 0x%08lx got 0x%08x\n", index, expected, regs[index]);
+            errors++;
+        }
+    }
+    fclose(file);
+    return errors;
+}
+
+int main(int argc, char **argv) {
+    const std::unique_ptr<VerilatedContext> context{new VerilatedContext};
+    context->commandArgs(argc, argv);
+
+    const char *cycles_arg = plusarg(argc, argv, "cycles");
+    const char *expect = plusarg(argc, argv, "expect");
+    const char *asserts = plusarg(argc, argv, "asserts");
+    const char *stream = plusarg(argc, argv, "stream");
+    const char *name = plusarg(argc, argv, "name");
+    const bool trace = plusarg(argc, argv, "trace") != nullptr;
+    const uint64_t cycles = cycles_arg ? strtoull(cycles_arg, nullptr, 0) : 1000;
+    if (plusarg(argc, argv, "imem") == nullptr) {
+        fprintf(stderr,
+                "Usage: %s +imem=FILE [+dmem=FILE] [+cycles=N] [+expect=FILE] [+asserts=FILE]\n"
+                "       [+stream=START,PERIOD,COUNT] [+name=NAME] [+trace]\n",
+                argv[0]);
+        return 2;
+    }
+    unsigned long stream_start = 0, stream_period = 1, stream_count = 0;
+    if (stream && (sscanf(stream, "%lu,%lu,%lu", &stream_start, &stream_period, &stream_count) != 3 ||
+                   stream_period == 0)) {
+        fprintf(stderr, "tb: +stream wants START,PERIOD,COUNT\n");
+        return 2;
+    }
+
+    const std::unique_ptr<Vriscv_dsp_core> core{new Vriscv_dsp_core{context.get()}};
+    uint32_t regs[32] = {0};
+
+    // Reset
+    core->clk = 0;
+    core->rst_n = 0;
+    core->external_data_in = 0;
+    core->external_data_valid = 0;
+    core->eval();
+    for (int i = 0; i < RESET_CYCLES; i++) {
+        core->clk = 1;
+        core->eval();
+        core->clk = 0;
+        core->eval();
+    }
+    core->rst_n = 1;
+    core->eval();
+
+    // Main loop: sample the write-back port while the clock is low, then
+    // commit it on the rising edge
+    uint64_t writes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t cycle = 0; cycle < cycles && !context->gotFinish(); cycle++) {
+        // Receive stream: sample n + 1 at START + n * PERIOD
+        uint64_t n = (cycle - stream_start) / stream_period;
+        bool sample = cycle >= stream_start && (cycle - stream_start) % stream_period == 0 && n < stream_count;
+        core->external_data_valid = sample;
+        core->external_data_in = sample ? (uint32_t)(n + 1) : 0;
+
+        if (core->reg_write && core->rd != 0) {
+            regs[core->rd] = core->reg_write_data;
+            writes++;
+            if (trace) {
+                printf("%10llu  pc %08x  x%-2u <= 0x%08x\n", (unsigned long long)cycle, core->pc,
+                       (unsigned)core->rd, core->reg_write_data);
+            }
+        }
+        core->clk = 1;
+        context->timeInc(5);
+        core->eval();
+        core->clk = 0;
+        context->timeInc(5);
+        core->eval();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    core->final();
+
+    int errors = 0;
+    if (expect) {
+        errors += check_registers(expect, regs, false);
+    }
+    if (asserts) {
+        errors += check_registers(asserts, regs, true);
+    }
+
+    const char *scenario = name ? name : "run";
+    printf("%s: %llu cycles, %llu register writes, %.3f s, %.0f cycles/s (%d thread%s)\n", scenario,
+           (unsigned long long)cycles, (unsigned long long)writes, seconds,
+           seconds > 0 ? (double)cycles / seconds : 0.0, TB_THREADS, TB_THREADS == 1 ? "" : "s");
+    if (expect || asserts) {
+        printf("%s: %s\n", scenario, errors == 0 ? "PASSED" : "FAILED");
+    }
+    return errors == 0 ? 0 : 1;
+}
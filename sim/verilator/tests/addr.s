@@ -0,0 +1,98 @@
+# Post-increment addressing scenario: fill eight words with linear
+# post-increment stores, walk a three-word circular buffer forwards and
+# backwards, then read the words back in bit-reversed order. Dependent
+# instructions are separated by four NOPs so the results do not depend on
+# hazard handling. The immediate is the mode in bits 11:10 (00 linear,
+# 01 circular, 10 bit-reversed) and the signed step in bits 9:0.
+  .text
+  .globl _start
+_start:
+  addi x1, x0, 0x100                      # store pointer
+  addi x5, x0, 10                         # first value
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x5B, 1, x0, x8, 24             # lp.setupi 0, 8, fill_end
+  .insn s 0x7B, 6, x5, 4(x1)              # p.sw x5, 4(x1!)
+  addi x5, x5, 1
+  nop
+  nop
+  nop
+fill_end:
+  nop
+  addi x16, x0, 0x100                     # buffer base and read pointers
+  addi x3, x0, 0x100
+  addi x4, x0, 12                         # three-word circular buffer
+  nop
+  nop
+  nop
+  nop
+  csrw 0x800, x16                         # addr_base
+  csrw 0x801, x4                          # addr_size
+  csrwi 0x802, 3                          # addr_brev: 8 elements
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x6, x16, 1028          # p.lw x6, 4(x16!) circular: 10
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x7, x16, 1028          # 11
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x8, x16, 1028          # 12, wraps to the base
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x9, x16, 1028          # 10
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x9, x16, 2044          # p.lw x9, -4(x16!) circular: 11
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x9, x16, 2044          # 10, wraps to the end
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x10, x3, -2044         # p.lw x10, 4(x3!) bit-reversed: 10
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x11, x3, -2044         # 14
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x12, x3, -2044         # 12
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x13, x3, -2044         # 16
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x7B, 2, x14, x3, -2044         # 11
+  nop
+  nop
+  nop
+  nop
+  csrr x15, 0x801                         # 12
+  nop
+  nop
+  nop
+  nop
+  ebreak
@@ -0,0 +1,48 @@
+# ALU scenario: RV32I register and immediate operations and the custom
+# SAT/CLIP/ROUND instructions.
+  .text
+  .globl _start
+_start:
+  addi x1, x0, 1000
+  addi x2, x0, -7
+  addi x3, x0, 5
+  nop
+  nop
+  nop
+  nop
+  add  x10, x1, x2
+  sub  x11, x1, x2
+  and  x12, x1, x2
+  or   x13, x1, x2
+  xor  x14, x1, x2
+  sll  x15, x1, x3
+  srl  x16, x2, x3
+  sra  x17, x2, x3
+  slt  x18, x2, x1
+  sltu x19, x2, x1
+  andi x20, x1, 0x3F
+  ori  x21, x1, 0x7
+  xori x22, x2, -1
+  slti x23, x2, -6
+  srai x24, x2, 1
+  nop
+  nop
+  nop
+  nop
+  slli x4, x1, 8                        # x4 = 256000
+  addi x5, x0, 300
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x0b, 0, 0, x25, x4, x0       # sat   -> 32767
+  .insn r 0x0b, 0, 0, x26, x2, x0       # sat   -> -7
+  .insn r 0x0b, 1, 0, x27, x1, x5       # clip  -> 300
+  .insn r 0x0b, 2, 0, x28, x3, x0       # round -> 6
+  nop
+  nop
+  nop
+  nop
+  ebreak
+1:
+  j 1b
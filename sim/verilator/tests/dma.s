@@ -0,0 +1,47 @@
+# DMA descriptor scenario: program both channels' ping-pong buffers through
+# the CSRs, read them back, enable and disable the channels with csrs/csrc
+# and clear the (idle) status. No samples are streamed, so the channels
+# stay at the ping half. Dependent instructions are separated by four NOPs
+# so the results do not depend on hazard handling.
+  .text
+  .globl _start
+_start:
+  lui  x5, 0x1                            # receive buffer in bank Y
+  addi x6, x0, 0x100                      # transmit buffer in bank X
+  addi x7, x0, 64                         # 64 samples per half
+  nop
+  nop
+  nop
+  nop
+  csrw 0x812, x5                          # dma_rx_addr
+  csrw 0x813, x7                          # dma_rx_len
+  csrw 0x814, x6                          # dma_tx_addr
+  csrw 0x815, x7                          # dma_tx_len
+  csrwi 0x810, 0xC                        # both interrupts enabled
+  nop
+  nop
+  nop
+  nop
+  csrr x10, 0x812
+  csrr x11, 0x813
+  csrr x12, 0x814
+  csrr x13, 0x815
+  csrsi 0x810, 3                          # start both channels
+  nop
+  nop
+  nop
+  nop
+  csrr x14, 0x810
+  csrci 0x810, 3                          # and stop them again
+  nop
+  nop
+  nop
+  nop
+  csrr x15, 0x810
+  csrci 0x811, 0x13                       # acknowledge rx done and overrun
+  nop
+  nop
+  nop
+  nop
+  csrr x16, 0x811
+  ebreak
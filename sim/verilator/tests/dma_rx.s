@@ -0,0 +1,46 @@
+# DMA receive scenario: the harness streams samples 1 to 8 (+stream=40,17,8)
+# into a 4-sample ping-pong buffer in bank Y while a hardware loop keeps the
+# core loading from bank Y every other cycle. The core's port has priority,
+# so a sample that meets a bank Y load waits a cycle in the channel; with an
+# odd period the arrivals fall on both load and free cycles, and none may be
+# dropped. The ISS has no stream, so there is no dma_rx.expect: the results
+# below are the whole check.
+#
+# expect x12 0x00020001  ping half: samples 1 and 2
+# expect x13 0x00040003  samples 3 and 4
+# expect x14 0x00060005  pong half at rx_addr + 2 * len: samples 5 and 6
+# expect x15 0x00080007  samples 7 and 8
+# expect x16 0x00000001  rx done, both halves filled so back at ping, no overrun
+  .text
+  .globl _start
+_start:
+  lui  x5, 0x1                            # receive buffer in bank Y
+  addi x6, x0, 4                          # 4 samples per half
+  addi x7, x0, 64                         # loop count, past the last sample
+  lui  x11, 0x1
+  nop
+  nop
+  nop
+  nop
+  addi x11, x11, 0x100                    # bank Y load address, off the buffer
+  csrw 0x812, x5                          # dma_rx_addr
+  csrw 0x813, x6                          # dma_rx_len
+  csrwi 0x810, 1                          # start the receive channel
+  .insn i 0x5B, 0, x0, x7, 16             # lp.setup 0, x7, load_end
+  lw   x20, 0(x11)                        # bank Y busy
+  nop                                     # bank Y free
+  lw   x21, 0(x11)
+load_end:
+  nop
+  nop
+  nop
+  nop
+  nop
+  lw   x12, 0(x5)
+  lw   x13, 4(x5)
+  lw   x14, 8(x5)
+  lw   x15, 12(x5)
+  csrr x16, 0x811
+  ebreak
+1:
+  j 1b
@@ -0,0 +1,78 @@
+# Hardware loop scenario: an inner LP.SETUPI loop nested in an outer LP.SETUP
+# loop, two loops ending on the same instruction, a taken branch just
+# before the loop end and a body shorter than four instructions. Apart from
+# the short body, dependent instructions are separated by four NOPs so the
+# results do not depend on hazard handling. The loop end is a byte offset
+# from the setup instruction, to the last instruction of the body.
+#
+# Hand-derived results, checked by the harness on top of loop.expect:
+# expect x5 0x0000000f   inner body 5 times per outer iteration, 3 iterations
+# expect x6 0x00000003   outer body once per outer iteration
+# expect x9 0x00000008   shared end: 4 inner times 2 outer, no extra give-back
+# expect x10 0x00000003
+# expect x11 0x00000000  the branch always skips it
+# expect x12 0x00000003  the taken branch squashes the fetched loop end, and
+#                        the loop still gives back to its start 3 times
+# expect x13 0x00000006  a 1-instruction body is refetched, not lost
+  .text
+  .globl _start
+_start:
+  addi x7, x0, 3
+  addi x8, x0, 2
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x5B, 0, x1, x7, 44             # lp.setup  1, x7, outer_end (3 iterations)
+  .insn i 0x5B, 1, x0, x5, 20             # lp.setupi 0, 5, inner_end
+  addi x5, x5, 1                          # inner body: x5 += 1
+  nop
+  nop
+  nop
+inner_end:
+  nop
+  addi x6, x6, 1                          # outer body: x6 += 1
+  nop
+  nop
+  nop
+outer_end:
+  nop
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x5B, 0, x1, x8, 24             # lp.setup  1, x8, shared_end (2 iterations)
+  .insn i 0x5B, 1, x0, x4, 20             # lp.setupi 0, 4, shared_end
+  addi x9, x9, 1                          # shared end: x9 += 1, 8 times
+  nop
+  nop
+  nop
+shared_end:
+  nop
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x5B, 1, x0, x3, 24             # lp.setupi 0, 3, skip_end
+  addi x10, x10, 1                        # x10 += 1, 3 times
+  nop
+  nop
+  beq x0, x0, skip_end                    # squashes the fetched loop end
+  addi x11, x11, 1                        # skipped
+skip_end:
+  addi x12, x12, 1                        # x12 += 1, 3 times
+  nop
+  nop
+  nop
+  nop
+  .insn i 0x5B, 1, x0, x6, 8              # lp.setupi 0, 6, short_end (refetched)
+  addi x13, x13, 1                        # x13 += 1, 6 times
+short_end:
+  nop
+  nop
+  nop
+  nop
+  nop
+  ebreak
+1:
+  j 1b
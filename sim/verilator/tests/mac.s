@@ -0,0 +1,60 @@
+# MAC scenario: signed, unsigned, signed x unsigned and saturating MAC, and
+# the rounding of macc.rd. Dependent instructions are separated by four NOPs
+# so the results do not depend on hazard handling.
+#
+# Hand-derived results, checked by the harness on top of mac.expect:
+# expect x10 0x7fffffff  2^30 * 2^30 saturates
+# expect x6 0x00005398   20000 + 1400 = 21400
+# expect x13 0x00000058  1400 >> 4 = 87.5 rounds half up to 88
+# expect x15 0xfffffffd  -28 >> 3 = -3.5 rounds half up to -3, not -4
+# expect x17 0xffffffff  a shift past the 40-bit accumulator leaves the sign
+  .text
+  .globl _start
+_start:
+  addi x1, x0, 7
+  addi x2, x0, -4
+  addi x3, x0, 100
+  addi x4, x0, 200
+  addi x8, x0, 1
+  addi x12, x0, 4
+  addi x14, x0, 3
+  addi x16, x0, 41
+  nop
+  nop
+  nop
+  nop
+  slli x8, x8, 30
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x33, 0, 0x01, x5, x1, x2     # mac      x5 = 0 + 7 * -4
+  .insn r 0x33, 0, 0x01, x6, x3, x4     # mac      x6 = 0 + 100 * 200
+  .insn r 0x33, 1, 0x01, x7, x1, x3     # macu     x7 = 0 + 7 * 100
+  .insn r 0x33, 2, 0x01, x9, x2, x3     # macsu    x9 = 0 + -4 * 100
+  .insn r 0x33, 4, 0x01, x10, x8, x8    # mac.sat  x10 = sat(2^60)
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x33, 0, 0x01, x6, x1, x4     # mac      x6 = 20000 + 7 * 200
+  .insn r 0x2B, 1, 0, x0, x1, x4        # macc.clr acc = 7 * 200
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 2, 0, x13, x12, x0      # macc.rd  x13 = round(1400 >> 4)
+  .insn r 0x2B, 1, 0, x0, x1, x2        # macc.clr acc = 7 * -4
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 2, 0, x15, x14, x0      # macc.rd  x15 = round(-28 >> 3)
+  .insn r 0x2B, 2, 0, x17, x16, x0      # macc.rd  x17 = -28 >> 41
+  nop
+  nop
+  nop
+  nop
+  ebreak
+1:
+  j 1b
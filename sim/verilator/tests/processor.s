@@ -0,0 +1,71 @@
+# Processor scenario: loads and stores, a counted loop, a call and return.
+# Also used as the throughput benchmark, where it runs for a fixed number
+# of cycles.
+  .text
+  .globl _start
+_start:
+  addi x1, x0, 0x100                    # data pointer
+  addi x2, x0, 8                        # loop count
+  addi x10, x0, 0                       # sum
+  addi x11, x0, 3                       # value
+  nop
+  nop
+  nop
+  nop
+fill:
+  sw   x11, 0(x1)
+  addi x11, x11, 3
+  addi x1, x1, 4
+  addi x2, x2, -1
+  nop
+  nop
+  nop
+  nop
+  bne  x2, x0, fill
+  nop
+  nop
+  nop
+  nop
+  addi x1, x0, 0x100
+  addi x2, x0, 8
+  nop
+  nop
+  nop
+  nop
+sum:
+  lw   x12, 0(x1)
+  addi x1, x1, 4
+  addi x2, x2, -1
+  nop
+  nop
+  nop
+  nop
+  add  x10, x10, x12
+  bne  x2, x0, sum
+  nop
+  nop
+  nop
+  nop
+  jal  x5, twice
+  nop
+  nop
+  nop
+  nop
+  sw   x10, 0x40(x0)
+  lh   x13, 0x104(x0)
+  lbu  x14, 0x108(x0)
+  nop
+  nop
+  nop
+  nop
+  ebreak
+1:
+  j 1b
+
+twice:
+  add  x10, x10, x10
+  nop
+  nop
+  nop
+  nop
+  jalr x0, 0(x5)
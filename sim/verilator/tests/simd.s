@@ -0,0 +1,40 @@
+# SIMD scenario: 4 x 8-bit and 2 x 16-bit lane operations.
+  .text
+  .globl _start
+_start:
+  addi x1, x0, 0x7F0
+  addi x2, x0, 0x123
+  nop
+  nop
+  nop
+  nop
+  slli x3, x1, 16
+  slli x4, x2, 16
+  nop
+  nop
+  nop
+  nop
+  or x1, x1, x3                         # x1 = 0x07F007F0
+  or x2, x2, x4                         # x2 = 0x01230123
+  addi x3, x0, 2
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x33, 0, 0x02, x10, x1, x2    # add4
+  .insn r 0x33, 1, 0x02, x11, x1, x2    # sub4
+  .insn r 0x33, 2, 0x02, x12, x1, x2    # mul4
+  .insn r 0x33, 3, 0x02, x13, x1, x2    # and4
+  .insn r 0x33, 4, 0x02, x14, x1, x2    # or4
+  .insn r 0x33, 5, 0x02, x15, x1, x2    # xor4
+  .insn r 0x33, 6, 0x02, x16, x1, x3    # shift4
+  .insn r 0x33, 0, 0x03, x17, x1, x2    # add2
+  .insn r 0x33, 1, 0x03, x18, x1, x2    # sub2
+  .insn r 0x33, 2, 0x03, x19, x1, x2    # mul2
+  nop
+  nop
+  nop
+  nop
+  ebreak
+1:
+  j 1b
@@ -0,0 +1,95 @@
+# Dual-bank scenario: coefficients in data bank X (0x0000-0x0FFF), samples
+# in bank Y (0x1000-0x1FFF). macc2.xy takes a packed pair from each bank per
+# instruction; macc.xy walks the samples backwards through a circular
+# buffer. Dependent instructions are separated by four NOPs so the results
+# do not depend on hazard handling.
+#
+# Hand-derived results, checked by the harness on top of xy.expect:
+# expect x12 0x00000046  1*5 + 2*6 + 3*7 + 4*8 = 70, both banks in one cycle
+# expect x13 0x00000042  1*5 + 2*8 + 3*7 + 4*6 = 66: the bank Y pointer wraps
+#                        from 0x1100 back to 0x1106 in the 8-byte buffer
+# expect x10 0x00000108  bank X pointer stepped four times by 2
+# expect x11 0x00001100  bank Y pointer back at the start after four steps
+  .text
+  .globl _start
+_start:
+  lui  x5, 0x20                           # coefficients 1, 2, 3, 4
+  lui  x6, 0x40
+  lui  x7, 0x60                           # samples 5, 6, 7, 8
+  lui  x8, 0x80
+  addi x10, x0, 0x100                     # bank X pointer
+  lui  x11, 0x1                           # bank Y pointer
+  nop
+  nop
+  nop
+  nop
+  addi x5, x5, 1
+  addi x6, x6, 3
+  addi x7, x7, 5
+  addi x8, x8, 7
+  addi x11, x11, 0x100
+  nop
+  nop
+  nop
+  nop
+  sw   x5, 0(x10)
+  sw   x6, 4(x10)
+  sw   x7, 0(x11)
+  sw   x8, 4(x11)
+  csrw 0x800, x11                         # addr_base: the samples
+  addi x4, x0, 8
+  nop
+  nop
+  nop
+  nop
+  csrw 0x801, x4                          # addr_size: four halfwords
+  .insn r 0x2B, 1, 0, x0, x0, x0          # macc.clr: acc = 0
+  .insn r 0x2B, 5, 0, x10, x10, x11       # macc2.xy x10, x11: 1*5 + 2*6
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 5, 0, x10, x10, x11       # + 3*7 + 4*8
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 2, 0, x12, x0, x0         # macc.rd x12: 70
+  addi x10, x0, 0x100
+  lui  x11, 0x1
+  nop
+  nop
+  nop
+  nop
+  addi x11, x11, 0x100
+  .insn r 0x2B, 1, 0, x0, x0, x0          # macc.clr
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 4, 5, x10, x10, x11       # macc.xy, bank Y backwards and circular: 1*5
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 4, 5, x10, x10, x11       # 2*8
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 4, 5, x10, x10, x11       # 3*7
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 4, 5, x10, x10, x11       # 4*6
+  nop
+  nop
+  nop
+  nop
+  .insn r 0x2B, 2, 0, x13, x0, x0         # macc.rd x13: 66
+  nop
+  nop
+  nop
+  nop
+  ebreak
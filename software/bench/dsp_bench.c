@@ -0,0 +1,980 @@
+//=============================================================================
+// Kernel Benchmark Suite for RISC-V DSP Processor
+// Sweeps FIR taps, FFT sizes and block lengths; JSON/CSV output and baselines
+//=============================================================================
+
+#include "../dsp_math.h"
+#include "../fir_filter.h"
+#include "../iir_filter.h"
+#include "../fft.h"
+#include "../fast_conv.h"
+#include "../tone_detector.h"
+#include "../sliding_window.h"
+#include "../stream.h"
+#include "../dsp_arena.h"
+#include "../rom_tables.h"
+#include "../multichannel.h"
+#include "../worker_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__riscv)
+// Core clock used to turn cycle counts into time on the target
+#ifndef BENCH_CPU_HZ
+#define BENCH_CPU_HZ 100000000ull
+#endif
+#else
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+#define BENCH_MAX_RESULTS 192
+#define BENCH_MAX_SAMPLES 4096
+#define BENCH_TRIALS 5
+#define BENCH_WORKSPACE_SIZE (256 * 1024)
+#define BENCH_CHANNELS 64
+#define BENCH_BANK_TAPS 64
+#define BENCH_BATCH_SIZE 256
+
+// One measured configuration
+typedef struct {
+    const char *kernel;         // Function under test
+    char params[48];            // Sweep point, e.g. "taps=64 block=256"
+    int32_t samples;            // Samples processed per call
+    int64_t macs;               // Multiply-accumulates per call
+    double ns_per_call;         // Best of BENCH_TRIALS
+    double cycles_per_call;     // Negative when no cycle counter is available
+} bench_result_t;
+
+// Benchmark body: processes one batch and returns nothing
+typedef void (*bench_fn_t)(void *ctx);
+
+static bench_result_t results[BENCH_MAX_RESULTS];
+static int result_count = 0;
+static uint64_t min_time_ns = 20000000;    // Per trial
+
+static int16_t signal_in[BENCH_MAX_SAMPLES];
+static int16_t signal_aux[BENCH_MAX_SAMPLES];
+static int16_t signal_out[BENCH_MAX_SAMPLES];
+static int16_t coeffs[256];
+static complex_t spectrum_in[BENCH_MAX_SAMPLES];
+static complex_t spectrum_out[BENCH_MAX_SAMPLES];
+
+//=============================================================================
+// Time base
+//=============================================================================
+
+static uint64_t bench_now_ns(void) {
+#if defined(__riscv)
+    uint32_t lo, hi, hi2;
+    do {
+        __asm__ volatile ("rdcycleh %0" : "=r" (hi));
+        __asm__ volatile ("rdcycle %0" : "=r" (lo));
+        __asm__ volatile ("rdcycleh %0" : "=r" (hi2));
+    } while (hi != hi2);
+    return ((((uint64_t)hi << 32) | lo) * 1000000000ull) / BENCH_CPU_HZ;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + now.tv_nsec;
+#endif
+}
+
+// Cycle counter: rdcycle on the target, the TSC on x86 hosts
+static int bench_has_cycles(void) {
+#if defined(__riscv) || defined(__x86_64__) || defined(__i386__)
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+static uint64_t bench_cycles(void) {
+#if defined(__riscv)
+    uint32_t lo;
+    __asm__ volatile ("rdcycle %0" : "=r" (lo));
+    return lo;
+#elif defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static const char *bench_cycle_source(void) {
+#if defined(__riscv)
+    return "rdcycle";
+#elif defined(__x86_64__) || defined(__i386__)
+    return "tsc";
+#else
+    return "none";
+#endif
+}
+
+// Time fn: calibrate the batch size to roughly min_time_ns, then keep the
+// fastest of BENCH_TRIALS batches
+static void bench_run(const char *kernel, const char *params, int32_t samples, int64_t macs,
+                      bench_fn_t fn, void *ctx) {
+    if (result_count == BENCH_MAX_RESULTS) {
+        return;
+    }
+
+    uint64_t calls = 1;
+    for (;;) {
+        uint64_t start = bench_now_ns();
+        for (uint64_t i = 0; i < calls; i++) {
+            fn(ctx);
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        if (elapsed >= min_time_ns / 4 || calls >= (1ull << 30)) {
+            break;
+        }
+        calls *= 2;
+    }
+
+    double best_ns = 0;
+    double best_cycles = -1;
+    for (int trial = 0; trial < BENCH_TRIALS; trial++) {
+        uint64_t start = bench_now_ns();
+        uint64_t start_cycles = bench_cycles();
+        for (uint64_t i = 0; i < calls; i++) {
+            fn(ctx);
+        }
+        uint64_t cycles = bench_cycles() - start_cycles;
+        double ns = (double)(bench_now_ns() - start) / calls;
+        if (trial == 0 || ns < best_ns) {
+            best_ns = ns;
+            best_cycles = bench_has_cycles() ? (double)cycles / calls : -1;
+        }
+    }
+
+    bench_result_t *r = &results[result_count++];
+    r->kernel = kernel;
+    snprintf(r->params, sizeof(r->params), "%s", params);
+    r->samples = samples;
+    r->macs = macs;
+    r->ns_per_call = best_ns;
+    r->cycles_per_call = best_cycles;
+
+    printf("%-18s %-22s %10.2f ns/sample %12.0f samples/s", kernel, params,
+           best_ns / samples, 1e9 * samples / best_ns);
+    if (best_cycles >= 0 && macs > 0) {
+        printf(" %8.3f cycles/MAC", best_cycles / macs);
+    }
+    printf("\n");
+}
+
+//=============================================================================
+// Kernels
+//=============================================================================
+
+typedef struct {
+    fir_filter_t fir;
+    iir_filter_t iir;
+    iir_bank_t iir_bank;
+    fast_conv_t conv;
+    tone_bank_t tones;
+    fft_t *fft;
+    int16_t length;
+    int16_t *response;
+    fir_bank_t bank;
+    int16_t frames;
+} bench_ctx_t;
+
+static void run_fir_sample(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    for (int n = 0; n < ctx->length; n++) {
+        signal_out[n] = fir_process(&ctx->fir, signal_in[n]);
+    }
+}
+
+static void run_fir_block(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fir_process_block(&ctx->fir, signal_in, signal_out, ctx->length);
+}
+
+static void run_fir_rom(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    rom_lowpass_process_block(&ctx->fir, signal_in, signal_out, ctx->length);
+}
+
+static void run_fir_simd(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fir_process_simd(&ctx->fir, signal_in, signal_out, ctx->length);
+}
+
+static void run_iir_sample(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    for (int n = 0; n < ctx->length; n++) {
+        signal_out[n] = iir_process(&ctx->iir, signal_in[n]);
+    }
+}
+
+static void run_iir_block(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    iir_process_block(&ctx->iir, signal_in, signal_out, ctx->length);
+}
+
+static void run_iir_simd(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    iir_process_simd(&ctx->iir, signal_in, signal_out, ctx->length);
+}
+
+static void run_iir_bank(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    iir_bank_process(&ctx->iir_bank, signal_in, signal_out, ctx->length / ctx->iir_bank.channel_count);
+}
+
+static void run_fast_conv(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fast_conv_process(&ctx->conv, signal_in, signal_out);
+}
+
+static void run_fft_radix2(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    memcpy(spectrum_out, spectrum_in, ctx->length * sizeof(complex_t));
+    fft_radix2(ctx->fft, spectrum_out, spectrum_out);
+}
+
+static void run_fft_radix4(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fft_radix4(ctx->fft, spectrum_in, spectrum_out);
+}
+
+static void run_fft_real(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fft_real(ctx->fft, signal_in, spectrum_out);
+}
+
+static void run_fft_filter(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fft_filter(ctx->fft, signal_in, ctx->response, signal_out);
+}
+
+static void run_tone_bank(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    tone_bank_process(&ctx->tones, signal_in, ctx->length);
+}
+
+static void run_tone_fft(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    int16_t exponent = fft_real(ctx->fft, signal_in, spectrum_out);
+    fft_power_spectrum(ctx->fft, spectrum_out, exponent, signal_out);
+}
+
+static void run_add(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    add_16(signal_in, signal_aux, signal_out, ctx->length);
+}
+
+static void run_mul(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    mul_16(signal_in, signal_aux, signal_out, ctx->length);
+}
+
+static void run_scale(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    scale_16(signal_in, signal_out, ctx->length, 23170);
+}
+
+static void run_normalize(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    normalize_16(signal_in, signal_out, ctx->length);
+}
+
+static void run_magnitude(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    magnitude_16(signal_in, signal_aux, signal_out, ctx->length);
+}
+
+static void run_convolution(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    convolution_16(signal_in, coeffs, signal_out, ctx->length, 64);
+}
+
+static void run_correlation(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    correlation_16(signal_in, coeffs, signal_out, ctx->length, 64);
+}
+
+// Multichannel buffers start on a cache line, as fir_bank_t asks
+static int16_t bank_delay_line[FIR_BANK_DELAY_LINE_LEN(BENCH_BANK_TAPS, BENCH_CHANNELS)]
+    __attribute__((aligned(MULTICHANNEL_CACHE_LINE)));
+static int32_t bank_accumulator[BENCH_CHANNELS] __attribute__((aligned(MULTICHANNEL_CACHE_LINE)));
+static int16_t bank_out[BENCH_MAX_SAMPLES] __attribute__((aligned(MULTICHANNEL_CACHE_LINE)));
+static complex_t batch_out[BENCH_MAX_SAMPLES] __attribute__((aligned(MULTICHANNEL_CACHE_LINE)));
+static int16_t batch_exponents[BENCH_MAX_SAMPLES / BENCH_BATCH_SIZE];
+
+static void run_fir_bank(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fir_bank_process(&ctx->bank, signal_in, bank_out, ctx->frames);
+}
+
+static void run_fft_batch(void *p) {
+    bench_ctx_t *ctx = (bench_ctx_t*)p;
+    fft_radix4_batch(ctx->fft, spectrum_in, batch_out, ctx->frames, batch_exponents);
+}
+
+static int16_t log2_int(int32_t n) {
+    int16_t bits = 0;
+    while ((1 << bits) < n) {
+        bits++;
+    }
+    return bits;
+}
+
+// FIR sweeps. MAC counts are taps per output sample.
+static void bench_fir(int quick) {
+    static const int16_t tap_sweep[] = {16, 32, 64, 128, 256};
+    static const int16_t block_sweep[] = {64, 256, 1024};
+    static int16_t delay_line[FIR_DELAY_LINE_LEN(256)];
+    bench_ctx_t ctx;
+    char params[48];
+
+    for (unsigned t = 0; t < sizeof(tap_sweep) / sizeof(tap_sweep[0]); t++) {
+        int16_t taps = tap_sweep[t];
+        if (quick && taps != 64) {
+            continue;
+        }
+        fir_design_lowpass(coeffs, taps, 1000, 8000);
+
+        for (unsigned b = 0; b < sizeof(block_sweep) / sizeof(block_sweep[0]); b++) {
+            int16_t block = block_sweep[b];
+            if (quick && block != 256) {
+                continue;
+            }
+            ctx.length = block;
+            snprintf(params, sizeof(params), "taps=%d block=%d", taps, block);
+
+            fir_init(&ctx.fir, coeffs, delay_line, taps);
+            bench_run("fir_process", params, block, (int64_t)taps * block, run_fir_sample, &ctx);
+            fir_init(&ctx.fir, coeffs, delay_line, taps);
+            bench_run("fir_process_block", params, block, (int64_t)taps * block, run_fir_block, &ctx);
+            fir_init(&ctx.fir, coeffs, delay_line, taps);
+            bench_run("fir_process_simd", params, block, (int64_t)taps * block, run_fir_simd, &ctx);
+
+            // Compile-time coefficients, tap loop unrolled (rom_tables.cpp)
+            if (taps == ROM_LOWPASS_TAPS) {
+                fir_init(&ctx.fir, rom_lowpass_coeffs, delay_line, taps);
+                bench_run("fir_rom_unrolled", params, block, (int64_t)taps * block, run_fir_rom, &ctx);
+            }
+
+            if (!fast_conv_init(&ctx.conv, coeffs, taps, block)) {
+                fprintf(stderr, "bench: cannot build fast_conv %s\n", params);
+                exit(2);
+            }
+            bench_run("fast_conv", params, block, (int64_t)taps * block, run_fast_conv, &ctx);
+            fast_conv_cleanup(&ctx.conv);
+        }
+    }
+}
+
+// IIR sweeps. MAC counts are five per section per output sample; the bank
+// runs 8 interleaved channels over the same number of samples.
+static void bench_iir(int quick) {
+    static const int16_t order_sweep[] = {2, 4, 8};
+    static const int16_t block_sweep[] = {64, 256, 1024};
+    static int16_t iir_coeffs[IIR_COEFFS_LEN(IIR_SECTIONS(8))];
+    static int32_t state[IIR_BANK_STATE_LEN(IIR_SECTIONS(8), 8)];
+    bench_ctx_t ctx;
+    char params[48];
+
+    for (unsigned o = 0; o < sizeof(order_sweep) / sizeof(order_sweep[0]); o++) {
+        int16_t order = order_sweep[o];
+        if (quick && order != 4) {
+            continue;
+        }
+        int16_t sections = iir_design_butterworth_lowpass(iir_coeffs, order, 1000, 8000);
+
+        for (unsigned b = 0; b < sizeof(block_sweep) / sizeof(block_sweep[0]); b++) {
+            int16_t block = block_sweep[b];
+            if (quick && block != 256) {
+                continue;
+            }
+            int64_t macs = (int64_t)IIR_COEFFS_PER_SECTION * sections * block;
+            ctx.length = block;
+            snprintf(params, sizeof(params), "order=%d block=%d", order, block);
+
+            iir_init(&ctx.iir, iir_coeffs, state, sections);
+            bench_run("iir_process", params, block, macs, run_iir_sample, &ctx);
+            iir_init(&ctx.iir, iir_coeffs, state, sections);
+            bench_run("iir_process_block", params, block, macs, run_iir_block, &ctx);
+            iir_init(&ctx.iir, iir_coeffs, state, sections);
+            bench_run("iir_process_simd", params, block, macs, run_iir_simd, &ctx);
+
+            iir_bank_init(&ctx.iir_bank, iir_coeffs, state, sections, 8);
+            snprintf(params, sizeof(params), "order=%d block=%d ch=8", order, block);
+            bench_run("iir_bank_process", params, block, macs, run_iir_bank, &ctx);
+        }
+    }
+}
+
+// FFT sweeps. MAC counts are the radix-2 equivalent: N/2 * log2(N)
+// butterflies of four real multiplies, halved for real-input transforms.
+static void bench_fft(int quick) {
+    static const int16_t size_sweep[] = {64, 256, 1024, 4096};
+    static int16_t response[BENCH_MAX_SAMPLES];
+    bench_ctx_t ctx;
+    char params[48];
+
+    for (unsigned s = 0; s < sizeof(size_sweep) / sizeof(size_sweep[0]); s++) {
+        int16_t size = size_sweep[s];
+        if (quick && size != 256) {
+            continue;
+        }
+        int64_t macs = 2 * (int64_t)size * log2_int(size);
+        ctx.fft = fft_plan_get(size);
+        ctx.length = size;
+        ctx.response = response;
+        for (int i = 0; i < size; i++) {
+            response[i] = (i < size / 4 || i >= size - size / 4) ? 32767 : 0;
+        }
+        snprintf(params, sizeof(params), "size=%d", size);
+
+        bench_run("fft_radix2", params, size, macs, run_fft_radix2, &ctx);
+        bench_run("fft_radix4", params, size, macs, run_fft_radix4, &ctx);
+        bench_run("fft_real", params, size, macs / 2, run_fft_real, &ctx);
+        bench_run("fft_filter", params, size, macs + 2 * size, run_fft_filter, &ctx);
+    }
+    fft_plan_cache_clear();
+}
+
+// Tone detection: Goertzel and sliding DFT banks against fft_real plus
+// fft_power_spectrum on the same block. MAC counts come from the cost model
+// that stream_watch_bins uses to choose between them.
+static void bench_tone(int quick) {
+    static const int16_t bin_sweep[] = {1, 4, 16};
+    static const int16_t block_sweep[] = {256, 1024};
+    static int16_t bins[16];
+    bench_ctx_t ctx;
+    char params[48];
+
+    for (unsigned b = 0; b < sizeof(block_sweep) / sizeof(block_sweep[0]); b++) {
+        int16_t block = block_sweep[b];
+        if (quick && block != 256) {
+            continue;
+        }
+        ctx.fft = fft_plan_get(block);
+        ctx.length = block;
+        snprintf(params, sizeof(params), "block=%d", block);
+        bench_run("tone_fft", params, block, tone_fft_cost(block), run_tone_fft, &ctx);
+
+        for (unsigned k = 0; k < sizeof(bin_sweep) / sizeof(bin_sweep[0]); k++) {
+            int16_t count = bin_sweep[k];
+            if (quick && count != 4) {
+                continue;
+            }
+            for (int i = 0; i < count; i++) {
+                bins[i] = (int16_t)((2 * i + 1) * block / (4 * count));
+            }
+            snprintf(params, sizeof(params), "bins=%d block=%d", count, block);
+
+            tone_bank_init(&ctx.tones, TONE_GOERTZEL, bins, count, block, NULL);
+            bench_run("tone_goertzel", params, block, tone_bank_cost(TONE_GOERTZEL, count, block, 0),
+                      run_tone_bank, &ctx);
+            tone_bank_cleanup(&ctx.tones);
+
+            tone_bank_init(&ctx.tones, TONE_SLIDING_DFT, bins, count, block, NULL);
+            bench_run("tone_sliding_dft", params, block, tone_bank_cost(TONE_SLIDING_DFT, count, block, 0),
+                      run_tone_bank, &ctx);
+            tone_bank_cleanup(&ctx.tones);
+        }
+    }
+    fft_plan_cache_clear();
+}
+
+// Tone bank accuracy: a tone at each of several bins (DC, the lowest bins,
+// mid band, just below Nyquist) and at three levels, read by both banks
+// and by fft_real plus fft_power_spectrum. Returns the number of readings
+// more than TONE_TOLERANCE_DB away from the FFT.
+#define TONE_TOLERANCE_DB 1
+
+static int bench_tone_accuracy(void) {
+    static const int16_t size_sweep[] = {256, 1024, 4096, 16384};
+    static const int16_t level_sweep[] = {30, 1000, 16000};
+    static int16_t tone[16384];
+    static complex_t spectrum[16384];
+    static int16_t power[8192];
+    tone_bank_t bank;
+    int failures = 0;
+
+    printf("\nTone bank vs FFT   %-22s %10s %10s %10s\n", "", "fft dB", "goertzel", "sliding");
+    for (unsigned i = 0; i < sizeof(size_sweep) / sizeof(size_sweep[0]); i++) {
+        int16_t size = size_sweep[i];
+        int16_t bins[6] = {0, 1, 2, size / 8 + 3, size / 2 - 2, size / 2 - 1};
+        fft_t *plan = fft_plan_get(size);
+
+        for (unsigned l = 0; l < sizeof(level_sweep) / sizeof(level_sweep[0]); l++) {
+            for (int b = 0; b < 6; b++) {
+                int16_t bin = bins[b];
+                uint32_t seed = 1;
+                for (int n = 0; n < size; n++) {
+                    // Binary angle k n 2^16 / N is exact for power-of-two N
+                    int16_t angle = (int16_t)(((uint32_t)bin * n * (65536 / size)) + 3000);
+                    seed = seed * 1103515245u + 12345u;
+                    tone[n] = (int16_t)(mac(0, level_sweep[l], cos_16(angle)) >> 15) + (int16_t)((seed >> 16) % 3) - 1;
+                }
+                fft_power_spectrum(plan, spectrum, fft_real(plan, tone, spectrum), power);
+
+                tone_bank_init(&bank, TONE_GOERTZEL, &bin, 1, size, NULL);
+                tone_bank_process(&bank, tone, size);
+                int16_t goertzel = bank.power[0];
+                tone_bank_cleanup(&bank);
+                tone_bank_init(&bank, TONE_SLIDING_DFT, &bin, 1, size, NULL);
+                tone_bank_process(&bank, tone, size);
+                int16_t sliding = bank.power[0];
+                tone_bank_cleanup(&bank);
+
+                int bad = abs(goertzel - power[bin]) > TONE_TOLERANCE_DB || abs(sliding - power[bin]) > TONE_TOLERANCE_DB;
+                failures += bad;
+                if (bad || (l == 0 && b == 1)) {
+                    char params[48];
+                    snprintf(params, sizeof(params), "N=%d k=%d A=%d", size, bin, level_sweep[l]);
+                    printf("%-18s %-22s %10d %10d %10d%s\n", "tone_accuracy", params, power[bin], goertzel, sliding,
+                           bad ? "  MISMATCH" : "");
+                }
+            }
+        }
+    }
+    fft_plan_cache_clear();
+    printf("  %d readings outside +/-%d dB\n", failures, TONE_TOLERANCE_DB);
+    return failures;
+}
+
+// Fast convolution accuracy: fast_conv_process against fir_process for an
+// impulse, a burst followed by silence and a steady random input, with the
+// lowpass at half scale so neither path saturates. Returns the number of
+// runs off by more than FAST_CONV_TOLERANCE_LSB, or not exactly zero once
+// the burst has left the filter.
+#define FAST_CONV_TOLERANCE_LSB 32
+#define FAST_CONV_MAX_TAPS 1000
+
+static int bench_fast_conv_accuracy(void) {
+    static const int16_t config[][2] = {{64, 64}, {100, 32}, {255, 128}, {256, 64}, {1000, 256}};
+    static int16_t h[FAST_CONV_MAX_TAPS];
+    static int16_t delay_line[FIR_DELAY_LINE_LEN(FAST_CONV_MAX_TAPS)];
+    static int16_t x[BENCH_MAX_SAMPLES];
+    static int16_t expected[BENCH_MAX_SAMPLES];
+    static int16_t actual[BENCH_MAX_SAMPLES];
+    fir_filter_t fir;
+    fast_conv_t conv;
+    int failures = 0;
+
+    printf("\nfast_conv vs FIR   %-22s %10s %10s %10s\n", "", "impulse", "burst", "random");
+    for (unsigned c = 0; c < sizeof(config) / sizeof(config[0]); c++) {
+        int16_t taps = config[c][0];
+        int16_t block = config[c][1];
+        int16_t partitions = (taps + block - 1) / block;
+        int32_t length = (int32_t)block * (partitions + 6);
+        int worst[3];
+        int bad = 0;
+
+        fir_design_lowpass(h, taps, 1000, 8000);
+        for (int i = 0; i < taps; i++) {
+            h[i] >>= 1;
+        }
+
+        for (int k = 0; k < 3; k++) {
+            // Ternary noise; the burst lasts two blocks
+            uint32_t seed = 1;
+            for (int32_t n = 0; n < length; n++) {
+                seed = seed * 1103515245u + 12345u;
+                int16_t noise = (int16_t)((seed >> 16) % 3) - 1;
+                x[n] = (k == 0) ? (n == 0) : (k == 1 && n >= 2 * block) ? 0 : noise;
+            }
+
+            fir_init(&fir, h, delay_line, taps);
+            for (int32_t n = 0; n < length; n++) {
+                expected[n] = fir_process(&fir, x[n]);
+            }
+            if (!fast_conv_init(&conv, h, taps, block)) {
+                fprintf(stderr, "bench: cannot build fast_conv taps=%d block=%d\n", taps, block);
+                exit(2);
+            }
+            for (int32_t n = 0; n < length; n += block) {
+                fast_conv_process(&conv, &x[n], &actual[n]);
+            }
+            fast_conv_cleanup(&conv);
+
+            worst[k] = 0;
+            for (int32_t n = 0; n < length; n++) {
+                int error = abs(actual[n] - expected[n]);
+                if (error > worst[k]) {
+                    worst[k] = error;
+                }
+            }
+            bad |= worst[k] > FAST_CONV_TOLERANCE_LSB;
+
+            // The last two blocks see only silence
+            for (int32_t n = length - 2 * block; k < 2 && n < length; n++) {
+                bad |= actual[n] != 0;
+            }
+        }
+
+        char params[48];
+        snprintf(params, sizeof(params), "taps=%d block=%d", taps, block);
+        printf("%-18s %-22s %10d %10d %10d%s\n", "fast_conv_accuracy", params, worst[0], worst[1], worst[2],
+               bad ? "  MISMATCH" : "");
+        failures += bad;
+    }
+    fft_plan_cache_clear();
+    printf("  %d configurations outside +/-%d LSB\n", failures, FAST_CONV_TOLERANCE_LSB);
+    return failures;
+}
+
+// Workspace report: each object is built in an empty arena and the bytes it
+// took are checked against its *_workspace_size query. Returns the number of
+// configurations where they differ.
+static uint8_t workspace[BENCH_WORKSPACE_SIZE];
+
+static int workspace_row(const char *kernel, const char *params, uint32_t query, const arena_t *arena) {
+    int ok = arena->failures == 0 && arena->peak == query;
+    printf("%-18s %-22s %10lu %10lu %10lu%s\n", kernel, params, (unsigned long)query,
+           (unsigned long)arena->used, (unsigned long)arena->peak, ok ? "" : "  MISMATCH");
+    return !ok;
+}
+
+static int bench_workspace(int quick) {
+    static const int16_t fft_sweep[] = {64, 256, 1024, 4096};
+    static const int16_t tap_sweep[] = {16, 64, 256};
+    static int16_t bins[4] = {10, 20, 30, 40};
+    static fir_filter_t fir;
+    static int16_t delay_line[FIR_DELAY_LINE_LEN(64)];
+    static sliding_window_t window;
+    static stream_pipeline_t pipe;
+    bench_ctx_t ctx;
+    arena_t arena;
+    char params[48];
+    int mismatches = 0;
+
+    printf("\n%-18s %-22s %10s %10s %10s\n", "Workspace (bytes)", "", "query", "used", "peak");
+
+    // Plans come with their half-size companions, down to one point
+    for (unsigned i = 0; i < sizeof(fft_sweep) / sizeof(fft_sweep[0]); i++) {
+        int16_t size = fft_sweep[i];
+        uint32_t query = 0;
+        if (quick && size != 256) {
+            continue;
+        }
+        for (int16_t s = size; s >= 1; s >>= 1) {
+            query += fft_workspace_size(s);
+        }
+        snprintf(params, sizeof(params), "size=%d", size);
+        arena_init(&arena, workspace, sizeof(workspace));
+        fft_plan_cache_arena(&arena);
+        fft_plan_get(size);
+        mismatches += workspace_row("fft_plan", params, query, &arena);
+        fft_plan_cache_clear();
+        fft_plan_cache_arena(NULL);
+
+        // Scratch only: the plan is already built, the spectrum is returned
+        fft_t *plan = fft_plan_get(size);
+        arena_init(&arena, workspace, sizeof(workspace));
+        fft_filter_arena(plan, signal_in, signal_aux, signal_out, &arena);
+        mismatches += workspace_row("fft_filter", params, fft_filter_workspace_size(size), &arena);
+        fft_plan_cache_clear();
+    }
+
+    fir_design_lowpass(coeffs, 256, 1000, 8000);
+    for (unsigned t = 0; t < sizeof(tap_sweep) / sizeof(tap_sweep[0]); t++) {
+        int16_t taps = tap_sweep[t];
+        if (quick && taps != 64) {
+            continue;
+        }
+        snprintf(params, sizeof(params), "taps=%d block=256", taps);
+        arena_init(&arena, workspace, sizeof(workspace));
+        fast_conv_init_arena(&ctx.conv, coeffs, taps, 256, &arena);
+        mismatches += workspace_row("fast_conv", params, fast_conv_workspace_size(taps, 256), &arena);
+        fast_conv_cleanup(&ctx.conv);
+    }
+
+    snprintf(params, sizeof(params), "size=64 all");
+    arena_init(&arena, workspace, sizeof(workspace));
+    window_init_arena(&window, 64, WINDOW_MEAN | WINDOW_MEDIAN | WINDOW_MINMAX, &arena);
+    mismatches += workspace_row("sliding_window", params,
+                                window_workspace_size(64, WINDOW_MEAN | WINDOW_MEDIAN | WINDOW_MINMAX), &arena);
+    window_cleanup(&window);
+
+    snprintf(params, sizeof(params), "bins=4 block=256");
+    arena_init(&arena, workspace, sizeof(workspace));
+    tone_bank_init_arena(&ctx.tones, TONE_GOERTZEL, bins, 4, 256, NULL, &arena);
+    mismatches += workspace_row("tone_goertzel", params, tone_bank_workspace_size(TONE_GOERTZEL, 4, 256), &arena);
+    tone_bank_cleanup(&ctx.tones);
+    arena_init(&arena, workspace, sizeof(workspace));
+    tone_bank_init_arena(&ctx.tones, TONE_SLIDING_DFT, bins, 4, 256, NULL, &arena);
+    mismatches += workspace_row("tone_sliding_dft", params, tone_bank_workspace_size(TONE_SLIDING_DFT, 4, 256),
+                                &arena);
+    tone_bank_cleanup(&ctx.tones);
+
+    // The dsp_app pipeline: ROM plan, 1024-sample rings, three watched tones
+    rom_fft_install();
+    fir_init(&fir, rom_lowpass_coeffs, delay_line, ROM_LOWPASS_TAPS);
+    snprintf(params, sizeof(params), "block=%d ring=1024", ROM_FFT_SIZE);
+    arena_init(&arena, workspace, sizeof(workspace));
+    stream_init_arena(&pipe, &fir, fft_plan_get(ROM_FFT_SIZE), ROM_FFT_SIZE, 1024, &arena);
+    stream_watch_bins(&pipe, bins, 3);
+    mismatches += workspace_row("stream", params, stream_workspace_size(ROM_FFT_SIZE, 1024, 1, 3), &arena);
+    stream_cleanup(&pipe);
+    fft_plan_cache_clear();
+
+    return mismatches;
+}
+
+// Block operations on the compiled backend. Element-wise kernels count one
+// MAC per multiply; convolution and correlation use a 64-tap kernel.
+static void bench_block(int quick) {
+    static const int16_t block_sweep[] = {64, 256, 1024};
+    bench_ctx_t ctx;
+    char params[48];
+
+    fir_design_lowpass(coeffs, 64, 1000, 8000);
+    for (unsigned b = 0; b < sizeof(block_sweep) / sizeof(block_sweep[0]); b++) {
+        int16_t block = block_sweep[b];
+        if (quick && block != 256) {
+            continue;
+        }
+        ctx.length = block;
+        snprintf(params, sizeof(params), "block=%d", block);
+
+        bench_run("add_16", params, block, 0, run_add, &ctx);
+        bench_run("mul_16", params, block, block, run_mul, &ctx);
+        bench_run("scale_16", params, block, block, run_scale, &ctx);
+        bench_run("normalize_16", params, block, block, run_normalize, &ctx);
+        bench_run("magnitude_16", params, block, 0, run_magnitude, &ctx);
+        bench_run("convolution_16", params, block, 64 * (int64_t)block, run_convolution, &ctx);
+        bench_run("correlation_16", params, block, 64 * (int64_t)(block - 63), run_correlation, &ctx);
+    }
+}
+
+// Multichannel FIR bank and batched FFT over a thread-count sweep: powers
+// of two up to the online cores (at least four, so a small host still
+// shows the cost of oversubscription). Speedups are against one thread.
+static void bench_multichannel(int quick) {
+    static const int16_t thread_sweep[] = {1, 2, 4, 8, 16, 32, 64};
+    static double fir_ns[sizeof(thread_sweep) / sizeof(thread_sweep[0])];
+    static double fft_ns[sizeof(thread_sweep) / sizeof(thread_sweep[0])];
+    static int16_t swept[sizeof(thread_sweep) / sizeof(thread_sweep[0])];
+    bench_ctx_t ctx;
+    char params[48];
+    int16_t frames = BENCH_MAX_SAMPLES / BENCH_CHANNELS;
+    int16_t batch = BENCH_MAX_SAMPLES / BENCH_BATCH_SIZE;
+    unsigned runs = 0;
+
+    int16_t cores = worker_pool_init(0);
+    worker_pool_shutdown();
+    int16_t max_threads = (quick || cores < 4) ? 4 : cores;
+
+    fir_design_lowpass(coeffs, BENCH_BANK_TAPS, 1000, 8000);
+    ctx.fft = fft_plan_get(BENCH_BATCH_SIZE);
+    for (unsigned t = 0; t < sizeof(thread_sweep) / sizeof(thread_sweep[0]); t++) {
+        int16_t threads = thread_sweep[t];
+        if (threads > max_threads || (quick && threads == 2)) {
+            continue;
+        }
+        if (worker_pool_init(threads) != threads) {
+            worker_pool_shutdown();
+            break;
+        }
+
+        fir_bank_init(&ctx.bank, coeffs, bank_delay_line, bank_accumulator, BENCH_BANK_TAPS, BENCH_CHANNELS);
+        ctx.frames = frames;
+        snprintf(params, sizeof(params), "ch=%d taps=%d thr=%d", BENCH_CHANNELS, BENCH_BANK_TAPS, threads);
+        bench_run("fir_bank", params, BENCH_MAX_SAMPLES, (int64_t)BENCH_BANK_TAPS * BENCH_MAX_SAMPLES,
+                  run_fir_bank, &ctx);
+        fir_ns[runs] = results[result_count - 1].ns_per_call;
+
+        ctx.frames = batch;
+        snprintf(params, sizeof(params), "size=%d frames=%d thr=%d", BENCH_BATCH_SIZE, batch, threads);
+        bench_run("fft_radix4_batch", params, BENCH_MAX_SAMPLES,
+                  2 * (int64_t)BENCH_MAX_SAMPLES * log2_int(BENCH_BATCH_SIZE), run_fft_batch, &ctx);
+        fft_ns[runs] = results[result_count - 1].ns_per_call;
+
+        worker_pool_shutdown();
+        swept[runs++] = threads;
+    }
+    fft_plan_cache_clear();
+
+    printf("\nThread scaling (%d online cores), speedup over one thread\n", cores);
+    printf("%-18s", "threads");
+    for (unsigned t = 0; t < runs; t++) {
+        printf(" %7d", swept[t]);
+    }
+    printf("\n%-18s", "fir_bank");
+    for (unsigned t = 0; t < runs; t++) {
+        printf(" %6.2fx", fir_ns[0] / fir_ns[t]);
+    }
+    printf("\n%-18s", "fft_radix4_batch");
+    for (unsigned t = 0; t < runs; t++) {
+        printf(" %6.2fx", fft_ns[0] / fft_ns[t]);
+    }
+    printf("\n");
+}
+
+//=============================================================================
+// Output and baseline comparison
+//=============================================================================
+
+static int write_csv(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "bench: cannot write %s\n", path);
+        return -1;
+    }
+    fprintf(file, "kernel,params,samples,macs,ns_per_sample,samples_per_sec,cycles_per_mac\n");
+    for (int i = 0; i < result_count; i++) {
+        bench_result_t *r = &results[i];
+        fprintf(file, "%s,%s,%d,%lld,%.4f,%.0f,", r->kernel, r->params, r->samples, (long long)r->macs,
+                r->ns_per_call / r->samples, 1e9 * r->samples / r->ns_per_call);
+        if (r->cycles_per_call >= 0 && r->macs > 0) {
+            fprintf(file, "%.4f", r->cycles_per_call / r->macs);
+        }
+        fprintf(file, "\n");
+    }
+    fclose(file);
+    return 0;
+}
+
+static int write_json(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "bench: cannot write %s\n", path);
+        return -1;
+    }
+    fprintf(file, "{\n  \"suite\": \"dsp_bench\",\n  \"cycle_counter\": \"%s\",\n  \"results\": [\n",
+            bench_cycle_source());
+    for (int i = 0; i < result_count; i++) {
+        bench_result_t *r = &results[i];
+        fprintf(file, "    {\"kernel\": \"%s\", \"params\": \"%s\", \"samples\": %d, \"macs\": %lld, "
+                      "\"ns_per_sample\": %.4f, \"samples_per_sec\": %.0f, \"cycles_per_mac\": ",
+                r->kernel, r->params, r->samples, (long long)r->macs,
+                r->ns_per_call / r->samples, 1e9 * r->samples / r->ns_per_call);
+        if (r->cycles_per_call >= 0 && r->macs > 0) {
+            fprintf(file, "%.4f}", r->cycles_per_call / r->macs);
+        } else {
+            fprintf(file, "null}");
+        }
+        fprintf(file, "%s\n", (i + 1 < result_count) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return 0;
+}
+
+// Compare ns/sample with a CSV written by an earlier run. Returns the
+// number of configurations slower than the baseline by more than
+// threshold percent, or -1 if the baseline cannot be read.
+static int compare_baseline(const char *path, double threshold) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "bench: cannot read baseline %s\n", path);
+        return -1;
+    }
+
+    int regressions = 0;
+    int matched = 0;
+    char line[256];
+    printf("\nBaseline comparison (%s, threshold %.1f%%)\n", path, threshold);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char kernel[48], params[48];
+        double base_ns;
+        if (sscanf(line, "%47[^,],%47[^,],%*d,%*d,%lf", kernel, params, &base_ns) != 3 || base_ns <= 0) {
+            continue;
+        }
+        for (int i = 0; i < result_count; i++) {
+            bench_result_t *r = &results[i];
+            if (strcmp(r->kernel, kernel) != 0 || strcmp(r->params, params) != 0) {
+                continue;
+            }
+            double ns = r->ns_per_call / r->samples;
+            double change = 100.0 * (ns - base_ns) / base_ns;
+            int slower = change > threshold;
+            matched++;
+            regressions += slower;
+            if (slower || change < -threshold) {
+                printf("  %-18s %-22s %10.2f -> %10.2f ns/sample (%+.1f%%)%s\n", kernel, params,
+                       base_ns, ns, change, slower ? "  REGRESSION" : "");
+            }
+            break;
+        }
+    }
+    fclose(file);
+    printf("  %d configurations compared, %d regressions\n", matched, regressions);
+    return regressions;
+}
+
+//=============================================================================
+// Main
+//=============================================================================
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [--quick] [--min-time MS] [--csv FILE] [--json FILE]\n"
+            "          [--baseline FILE] [--threshold PERCENT]\n",
+            program);
+}
+
+int main(int argc, char **argv) {
+    const char *csv_path = NULL;
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+    double threshold = 10.0;
+    int quick = 0;
+
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--quick") == 0) {
+            quick = 1;
+        } else if (strcmp(argv[i], "--min-time") == 0 && has_value) {
+            min_time_ns = (uint64_t)(atof(argv[++i]) * 1e6);
+        } else if (strcmp(argv[i], "--csv") == 0 && has_value) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && has_value) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && has_value) {
+            threshold = atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Deterministic full-scale test signal
+    uint32_t seed = 12345;
+    for (int i = 0; i < BENCH_MAX_SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        signal_in[i] = (int16_t)(seed >> 16);
+        signal_aux[i] = (int16_t)seed;
+        spectrum_in[i].real = signal_in[i] >> 1;
+        spectrum_in[i].imag = (int16_t)(seed >> 1) >> 1;
+    }
+
+    printf("DSP kernel benchmark (backend: %s, cycle counter: %s)\n", DSP_BACKEND_NAME, bench_cycle_source());
+    bench_fir(quick);
+    bench_iir(quick);
+    bench_fft(quick);
+    bench_block(quick);
+    bench_tone(quick);
+    bench_multichannel(quick);
+
+    int status = (bench_tone_accuracy() || bench_fast_conv_accuracy() || bench_workspace(quick)) ? 1 : 0;
+    if (csv_path != NULL && write_csv(csv_path) != 0) {
+        status = 2;
+    }
+    if (json_path != NULL && write_json(json_path) != 0) {
+        status = 2;
+    }
+    if (baseline_path != NULL) {
+        int regressions = compare_baseline(baseline_path, threshold);
+        if (regressions < 0) {
+            status = 2;
+        } else if (regressions > 0) {
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,72 @@
+//=============================================================================
+// Workspace Arena for RISC-V DSP Processor
+// Bump allocation from a caller-provided buffer, with peak tracking
+//=============================================================================
+
+#include "dsp_arena.h"
+#if !defined(DSP_NO_MALLOC)
+#include <stdlib.h>
+#endif
+
+// Initialize arena over buffer
+void arena_init(arena_t *arena, void *buffer, uint32_t size) {
+    uint32_t skew = (uint32_t)(-(uintptr_t)buffer & (ARENA_ALIGN - 1));
+
+    arena->base = (uint8_t*)buffer + skew;
+    arena->capacity = (size > skew) ? (size - skew) & ~(uint32_t)(ARENA_ALIGN - 1) : 0;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->failures = 0;
+}
+
+void *arena_alloc(arena_t *arena, uint32_t bytes) {
+    uint32_t block = ARENA_BLOCK_SIZE(bytes);
+
+    if (block > arena->capacity - arena->used) {
+        arena->failures++;
+        return NULL;
+    }
+
+    void *ptr = arena->base + arena->used;
+    arena->used += block;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return ptr;
+}
+
+uint32_t arena_mark(const arena_t *arena) {
+    return arena ? arena->used : 0;
+}
+
+void arena_release(arena_t *arena, uint32_t mark) {
+    if (arena && mark <= arena->used) {
+        arena->used = mark;
+    }
+}
+
+void arena_reset(arena_t *arena) {
+    arena->used = 0;
+}
+
+void *dsp_alloc(arena_t *arena, uint32_t bytes) {
+    if (arena) {
+        return arena_alloc(arena, bytes);
+    }
+#if defined(DSP_NO_MALLOC)
+    return NULL;
+#else
+    return malloc(bytes);
+#endif
+}
+
+void dsp_free(arena_t *arena, void *ptr) {
+#if defined(DSP_NO_MALLOC)
+    (void)arena;
+    (void)ptr;
+#else
+    if (!arena) {
+        free(ptr);
+    }
+#endif
+}
@@ -0,0 +1,58 @@
+//=============================================================================
+// Workspace Arena for RISC-V DSP Processor
+// Bump allocation from a caller-provided buffer, with peak tracking
+//=============================================================================
+
+#ifndef DSP_ARENA_H
+#define DSP_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Every allocation starts on this boundary (int64_t sums, SIMD loads)
+#define ARENA_ALIGN 8
+
+// Bytes an allocation of 'bytes' takes from an arena. The *_workspace_size
+// queries are sums of these, so an arena of exactly that size always fits.
+#define ARENA_BLOCK_SIZE(bytes) (((uint32_t)(bytes) + ARENA_ALIGN - 1) & ~(uint32_t)(ARENA_ALIGN - 1))
+
+// Arena over a static buffer. Objects initialized from an arena are never
+// freed one by one: their cleanup functions leave the memory alone and the
+// whole arena is reset (or simply kept for the life of the program).
+typedef struct {
+    uint8_t *base;              // First aligned byte of the buffer
+    uint32_t capacity;          // Usable bytes from base
+    uint32_t used;              // Bytes handed out
+    uint32_t peak;              // Highest 'used' so far
+    uint32_t failures;          // Requests that did not fit
+} arena_t;
+
+void arena_init(arena_t *arena, void *buffer, uint32_t size);
+
+// Aligned block, or NULL (and failures++) when it does not fit
+void *arena_alloc(arena_t *arena, uint32_t bytes);
+
+// Scratch scopes: everything allocated after arena_mark is returned by
+// arena_release. Both accept a NULL arena and do nothing.
+uint32_t arena_mark(const arena_t *arena);
+void arena_release(arena_t *arena, uint32_t mark);
+
+// Drop every allocation; the peak is kept
+void arena_reset(arena_t *arena);
+
+// Library allocation: from the arena when one is given, else from the heap.
+// Built with DSP_NO_MALLOC the heap is never referenced (so malloc is not
+// linked) and a NULL arena gets NULL; the heap-only entry points such as
+// fft_init or stream_init are then not declared.
+void *dsp_alloc(arena_t *arena, uint32_t bytes);
+void dsp_free(arena_t *arena, void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_ARENA_H
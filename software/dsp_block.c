@@ -0,0 +1,314 @@
+//=============================================================================
+// Block Operations for RISC-V DSP Processor
+// Element-wise arithmetic, normalization, convolution and correlation
+//=============================================================================
+
+#include "dsp_math.h"
+
+// Every backend evaluates the same integer expressions: saturating 16-bit
+// sums, Q15 products rounded half up and dot products accumulated with
+// 32-bit wrap-around like the MAC unit. The vector loops take whole vectors
+// (AVX2 first, then SSE) and leave the tail to the scalar loop, so results
+// are bit-identical whichever backend was compiled in.
+
+// Q15 product rounded half up; only -1 * -1 saturates
+static inline int16_t mul_q15(int16_t a, int16_t b) {
+    return saturate_16(((int32_t)a * b + 0x4000) >> 15);
+}
+
+#if defined(DSP_BACKEND_X86)
+
+// pmulhrsw computes (a * b + 0x4000) >> 15 but wraps -1 * -1 to -1; those
+// lanes are flipped to 32767
+static inline __m128i mul_q15_x8(__m128i a, __m128i b) {
+    __m128i min = _mm_set1_epi16(-32768);
+    __m128i wrapped = _mm_and_si128(_mm_cmpeq_epi16(a, min), _mm_cmpeq_epi16(b, min));
+    return _mm_xor_si128(_mm_mulhrs_epi16(a, b), wrapped);
+}
+
+// Reverse the eight halfwords of a vector
+static inline __m128i reverse_x8(__m128i v) {
+    return _mm_shuffle_epi8(v, _mm_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+}
+
+static inline int32_t sum_x4(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0x4E));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, 0xB1));
+    return _mm_cvtsi128_si32(v);
+}
+
+#if defined(__AVX2__)
+static inline __m256i mul_q15_x16(__m256i a, __m256i b) {
+    __m256i min = _mm256_set1_epi16(-32768);
+    __m256i wrapped = _mm256_and_si256(_mm256_cmpeq_epi16(a, min), _mm256_cmpeq_epi16(b, min));
+    return _mm256_xor_si256(_mm256_mulhrs_epi16(a, b), wrapped);
+}
+
+static inline __m256i reverse_x16(__m256i v) {
+    __m256i lanes = _mm256_shuffle_epi8(v, _mm256_set_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                                           1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+    return _mm256_permute4x64_epi64(lanes, 0x4E);
+}
+
+static inline __m128i fold_x8(__m256i v) {
+    return _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+#endif
+
+#endif
+
+// sum a[i] * b[i] for i < n, wrapping at 32 bits
+static int32_t dot_16(const int16_t *a, const int16_t *b, int32_t n) {
+    int32_t acc = 0;
+    int32_t i = 0;
+#if defined(DSP_BACKEND_X86)
+    __m128i sum = _mm_setzero_si128();
+#if defined(__AVX2__)
+    __m256i sum16 = _mm256_setzero_si256();
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)&a[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i *)&b[i]);
+        sum16 = _mm256_add_epi32(sum16, _mm256_madd_epi16(va, vb));
+    }
+    sum = fold_x8(sum16);
+#endif
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i *)&a[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i *)&b[i]);
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(va, vb));
+    }
+    acc = sum_x4(sum);
+#endif
+    for (; i < n; i++) {
+        acc = mac(acc, a[i], b[i]);
+    }
+    return acc;
+}
+
+// sum a[i] * b[-i] for i < n, wrapping at 32 bits
+static int32_t dot_rev_16(const int16_t *a, const int16_t *b, int32_t n) {
+    int32_t acc = 0;
+    int32_t i = 0;
+#if defined(DSP_BACKEND_X86)
+    __m128i sum = _mm_setzero_si128();
+#if defined(__AVX2__)
+    __m256i sum16 = _mm256_setzero_si256();
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)&a[i]);
+        __m256i vb = reverse_x16(_mm256_loadu_si256((const __m256i *)&b[-i - 15]));
+        sum16 = _mm256_add_epi32(sum16, _mm256_madd_epi16(va, vb));
+    }
+    sum = fold_x8(sum16);
+#endif
+    for (; i + 8 <= n; i += 8) {
+        __m128i va = _mm_loadu_si128((const __m128i *)&a[i]);
+        __m128i vb = reverse_x8(_mm_loadu_si128((const __m128i *)&b[-i - 7]));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(va, vb));
+    }
+    acc = sum_x4(sum);
+#endif
+    for (; i < n; i++) {
+        acc = mac(acc, a[i], b[-i]);
+    }
+    return acc;
+}
+
+// Saturating addition
+void add_16(int16_t *input1, int16_t *input2, int16_t *output, int16_t length) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    for (; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&input1[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *)&input2[i]);
+        _mm256_storeu_si256((__m256i *)&output[i], _mm256_adds_epi16(a, b));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input1[i]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&input2[i]);
+        _mm_storeu_si128((__m128i *)&output[i], _mm_adds_epi16(a, b));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = saturate_16((int32_t)input1[i] + input2[i]);
+    }
+}
+
+// Saturating subtraction
+void sub_16(int16_t *input1, int16_t *input2, int16_t *output, int16_t length) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    for (; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&input1[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *)&input2[i]);
+        _mm256_storeu_si256((__m256i *)&output[i], _mm256_subs_epi16(a, b));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input1[i]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&input2[i]);
+        _mm_storeu_si128((__m128i *)&output[i], _mm_subs_epi16(a, b));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = saturate_16((int32_t)input1[i] - input2[i]);
+    }
+}
+
+// Q15 multiplication, rounded and saturated
+void mul_16(int16_t *input1, int16_t *input2, int16_t *output, int16_t length) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    for (; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&input1[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i *)&input2[i]);
+        _mm256_storeu_si256((__m256i *)&output[i], mul_q15_x16(a, b));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input1[i]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&input2[i]);
+        _mm_storeu_si128((__m128i *)&output[i], mul_q15_x8(a, b));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = mul_q15(input1[i], input2[i]);
+    }
+}
+
+// Scaling by a Q15 factor, rounded and saturated
+void scale_16(int16_t *input, int16_t *output, int16_t length, int16_t scale_factor) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    __m256i factor16 = _mm256_set1_epi16(scale_factor);
+    for (; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&input[i]);
+        _mm256_storeu_si256((__m256i *)&output[i], mul_q15_x16(a, factor16));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    __m128i factor = _mm_set1_epi16(scale_factor);
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input[i]);
+        _mm_storeu_si128((__m128i *)&output[i], mul_q15_x8(a, factor));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = mul_q15(input[i], scale_factor);
+    }
+}
+
+// Saturating offset
+void offset_16(int16_t *input, int16_t *output, int16_t length, int16_t offset) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    __m256i offset16 = _mm256_set1_epi16(offset);
+    for (; i + 16 <= length; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)&input[i]);
+        _mm256_storeu_si256((__m256i *)&output[i], _mm256_adds_epi16(a, offset16));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    __m128i offset8 = _mm_set1_epi16(offset);
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input[i]);
+        _mm_storeu_si128((__m128i *)&output[i], _mm_adds_epi16(a, offset8));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = saturate_16((int32_t)input[i] + offset);
+    }
+}
+
+// Normalization: scale so the largest magnitude becomes exactly 32767 (a
+// -32768 peak comes out at -32767). The gain is round(32767 / peak) in Q16,
+// fine enough that the peak lands on 32767 after rounding, and |x| * gain
+// stays below 2^31 for every |x| <= peak. An all-zero input gives zeros.
+void normalize_16(int16_t *input, int16_t *output, int16_t length) {
+    int16_t max_val = 0;
+    int16_t min_val = 0;
+    int i = 0;
+
+#if defined(DSP_BACKEND_X86)
+    __m128i vmax = _mm_setzero_si128();
+    __m128i vmin = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input[i]);
+        vmax = _mm_max_epi16(vmax, a);
+        vmin = _mm_min_epi16(vmin, a);
+    }
+    int16_t lanes_max[8], lanes_min[8];
+    _mm_storeu_si128((__m128i *)lanes_max, vmax);
+    _mm_storeu_si128((__m128i *)lanes_min, vmin);
+    for (int lane = 0; lane < 8; lane++) {
+        max_val = max_16(max_val, lanes_max[lane]);
+        min_val = min_16(min_val, lanes_min[lane]);
+    }
+#endif
+    for (; i < length; i++) {
+        max_val = max_16(max_val, input[i]);
+        min_val = min_16(min_val, input[i]);
+    }
+
+    int32_t peak = (max_val > -(int32_t)min_val) ? max_val : -(int32_t)min_val;
+    if (peak == 0) {
+        for (i = 0; i < length; i++) {
+            output[i] = 0;
+        }
+        return;
+    }
+    int32_t gain = (int32_t)((((uint32_t)32767 << 16) + (uint32_t)peak / 2) / (uint32_t)peak);
+
+    i = 0;
+#if defined(DSP_BACKEND_X86) && defined(__AVX2__)
+    __m256i gain8 = _mm256_set1_epi32(gain);
+    __m256i round8 = _mm256_set1_epi32(1 << 15);
+    for (; i + 16 <= length; i += 16) {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&input[i]));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)&input[i + 8]));
+        lo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(lo, gain8), round8), 16);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(hi, gain8), round8), 16);
+        _mm256_storeu_si256((__m256i *)&output[i], _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+    }
+#endif
+#if defined(DSP_BACKEND_X86)
+    __m128i gain4 = _mm_set1_epi32(gain);
+    __m128i round4 = _mm_set1_epi32(1 << 15);
+    for (; i + 8 <= length; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&input[i]);
+        __m128i lo = _mm_cvtepi16_epi32(a);
+        __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(a, 8));
+        lo = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(lo, gain4), round4), 16);
+        hi = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(hi, gain4), round4), 16);
+        _mm_storeu_si128((__m128i *)&output[i], _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i < length; i++) {
+        output[i] = saturate_16(((int32_t)input[i] * gain + (1 << 15)) >> 16);
+    }
+}
+
+// Full convolution with a Q15 kernel: input_len + kernel_len - 1 outputs,
+// output[n] = sat(sum kernel[k] * input[n - k] >> 15)
+void convolution_16(int16_t *input, int16_t *kernel, int16_t *output,
+                   int16_t input_len, int16_t kernel_len) {
+    int32_t output_len = (int32_t)input_len + kernel_len - 1;
+
+    for (int32_t n = 0; n < output_len; n++) {
+        int32_t k0 = (n >= input_len) ? n - input_len + 1 : 0;
+        int32_t k1 = (n < kernel_len) ? n : kernel_len - 1;
+        output[n] = saturate_16(dot_rev_16(&kernel[k0], &input[n - k0], k1 - k0 + 1) >> 15);
+    }
+}
+
+// Cross-correlation with a Q15 template over the lags where it fits:
+// len1 - len2 + 1 outputs, output[lag] = sat(sum input1[lag + i] * input2[i] >> 15)
+void correlation_16(int16_t *input1, int16_t *input2, int16_t *output,
+                   int16_t len1, int16_t len2) {
+    for (int32_t lag = 0; lag + len2 <= len1; lag++) {
+        output[lag] = saturate_16(dot_16(&input1[lag], input2, len2) >> 15);
+    }
+}
@@ -0,0 +1,393 @@
+//=============================================================================
+// DSP Math Library for RISC-V DSP Processor
+// Fixed-point elementary functions: tables, interpolation and CORDIC
+//=============================================================================
+
+#include "dsp_math.h"
+#include <stddef.h>
+
+// Quarter-wave sine, round(32768 * sin(i * pi / 512)) for i = 0..256,
+// clamped to 32767
+static const int16_t sin_table[257] = {
+         0,    201,    402,    603,    804,   1005,   1206,   1407,
+      1608,   1809,   2009,   2210,   2411,   2611,   2811,   3012,
+      3212,   3412,   3612,   3812,   4011,   4211,   4410,   4609,
+      4808,   5007,   5205,   5404,   5602,   5800,   5998,   6195,
+      6393,   6590,   6787,   6983,   7180,   7376,   7571,   7767,
+      7962,   8157,   8351,   8546,   8740,   8933,   9127,   9319,
+      9512,   9704,   9896,  10088,  10279,  10469,  10660,  10850,
+     11039,  11228,  11417,  11605,  11793,  11980,  12167,  12354,
+     12540,  12725,  12910,  13095,  13279,  13463,  13646,  13828,
+     14010,  14192,  14373,  14553,  14733,  14912,  15091,  15269,
+     15447,  15624,  15800,  15976,  16151,  16326,  16500,  16673,
+     16846,  17018,  17190,  17361,  17531,  17700,  17869,  18037,
+     18205,  18372,  18538,  18703,  18868,  19032,  19195,  19358,
+     19520,  19681,  19841,  20001,  20160,  20318,  20475,  20632,
+     20788,  20943,  21097,  21251,  21403,  21555,  21706,  21856,
+     22006,  22154,  22302,  22449,  22595,  22740,  22884,  23028,
+     23170,  23312,  23453,  23593,  23732,  23870,  24008,  24144,
+     24279,  24414,  24548,  24680,  24812,  24943,  25073,  25202,
+     25330,  25457,  25583,  25708,  25833,  25956,  26078,  26199,
+     26320,  26439,  26557,  26674,  26791,  26906,  27020,  27133,
+     27246,  27357,  27467,  27576,  27684,  27791,  27897,  28002,
+     28106,  28209,  28311,  28411,  28511,  28610,  28707,  28803,
+     28899,  28993,  29086,  29178,  29269,  29359,  29448,  29535,
+     29622,  29707,  29792,  29875,  29957,  30038,  30118,  30196,
+     30274,  30350,  30425,  30499,  30572,  30644,  30715,  30784,
+     30853,  30920,  30986,  31050,  31114,  31177,  31238,  31298,
+     31357,  31415,  31471,  31527,  31581,  31634,  31686,  31737,
+     31786,  31834,  31881,  31927,  31972,  32015,  32058,  32099,
+     32138,  32177,  32214,  32251,  32286,  32319,  32352,  32383,
+     32413,  32442,  32470,  32496,  32522,  32546,  32568,  32590,
+     32610,  32629,  32647,  32664,  32679,  32693,  32706,  32718,
+     32729,  32738,  32746,  32753,  32758,  32762,  32766,  32767,
+     32767
+};
+
+// CORDIC rotation angles with 8 extra fraction bits,
+// round(atan(2^-i) * 2^24 / (2 * pi)) for i = 0..17
+static const int32_t atan_table[18] = {
+    2097152, 1238021,  654136,  332050,  166669,   83416,   41718,   20860,
+      10430,    5215,    2608,    1304,     652,     326,     163,      81,
+         41,      20
+};
+
+// round(65536 * log2(1 + i / 64)) for i = 0..64
+static const uint32_t log2_table[65] = {
+         0,   1466,   2909,   4331,   5732,   7112,   8473,   9814,
+     11136,  12440,  13727,  14996,  16248,  17484,  18704,  19909,
+     21098,  22272,  23433,  24579,  25711,  26830,  27936,  29029,
+     30109,  31178,  32234,  33279,  34312,  35334,  36346,  37346,
+     38336,  39316,  40286,  41246,  42196,  43137,  44068,  44990,
+     45904,  46809,  47705,  48593,  49472,  50344,  51207,  52063,
+     52911,  53751,  54584,  55410,  56229,  57040,  57845,  58643,
+     59434,  60219,  60997,  61769,  62534,  63294,  64047,  64794,
+     65536
+};
+
+// round(65536 * 2^(i / 64)) for i = 0..64
+static const uint32_t exp2_table[65] = {
+      65536,   66250,   66971,   67700,   68438,   69183,   69936,   70698,
+      71468,   72246,   73032,   73828,   74632,   75444,   76266,   77096,
+      77936,   78785,   79642,   80510,   81386,   82273,   83169,   84074,
+      84990,   85915,   86851,   87796,   88752,   89719,   90696,   91684,
+      92682,   93691,   94711,   95743,   96785,   97839,   98905,   99982,
+     101070,  102171,  103283,  104408,  105545,  106694,  107856,  109031,
+     110218,  111418,  112631,  113858,  115098,  116351,  117618,  118899,
+     120194,  121502,  122825,  124163,  125515,  126882,  128263,  129660,
+     131072
+};
+
+// CORDIC gain compensation, 1 / 1.646760 in Q30
+#define CORDIC_GAIN_INV 652032874
+
+// log2(e) in Q14, log10(2) in Q16
+#define LOG2_E_Q14 23637
+#define LOG10_2_Q16 19728
+
+// Sine over the first quadrant, r = 0..16384 (pi / 2)
+static int16_t sin_quarter(int32_t r) {
+    int32_t index = r >> 6;
+    int32_t frac = r & 63;
+
+    if (index == 256) {
+        return sin_table[256];
+    }
+    int32_t delta = sin_table[index + 1] - sin_table[index];
+    return (int16_t)(sin_table[index] + ((delta * frac + 32) >> 6));
+}
+
+// Sine: 256-segment quarter-wave table with linear interpolation.
+// Max error 1 LSB.
+int16_t sin_16(int16_t angle) {
+    uint16_t a = (uint16_t)angle;
+    int32_t r = a & 0x3FFF;
+
+    switch (a >> 14) {
+        case 0:  return sin_quarter(r);
+        case 1:  return sin_quarter(16384 - r);
+        case 2:  return -sin_quarter(r);
+        default: return -sin_quarter(16384 - r);
+    }
+}
+
+// Cosine: sine advanced by a quarter turn
+int16_t cos_16(int16_t angle) {
+    return sin_16((int16_t)(uint16_t)((uint16_t)angle + 16384));
+}
+
+// CORDIC vectoring: rotate (x, y) onto the positive x axis. Returns the
+// angle of (x, y) and the magnitude (saturated to 32767) through *magnitude.
+static int16_t cordic_vector(int16_t x_in, int16_t y_in, int16_t *magnitude) {
+    int32_t x = x_in;
+    int32_t y = y_in;
+    uint32_t angle = 0;
+
+    // Bring the vector into the right half plane
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        angle = 32768 << 8;
+    }
+
+    // 14 guard bits keep the shifted terms exact for the first iterations.
+    // The angle alone (no magnitude to keep in step with the SIMD lanes)
+    // scales the vector up to full scale and takes two more iterations, so
+    // small vectors do not run out of bits.
+    int16_t guard = 14;
+    int16_t iterations = 16;
+    if (magnitude == NULL) {
+        uint32_t peak = (uint32_t)x | (uint32_t)((y < 0) ? -y : y);
+        while ((peak << (guard + 1)) <= (1u << 29)) {
+            guard++;
+        }
+        iterations = 18;
+    }
+    x <<= guard;
+    y <<= guard;
+    for (int i = 0; i < iterations; i++) {
+        int32_t x_shift = x >> i;
+        int32_t y_shift = y >> i;
+        if (y > 0) {
+            x += y_shift;
+            y -= x_shift;
+            angle += atan_table[i];
+        } else {
+            x -= y_shift;
+            y += x_shift;
+            angle -= atan_table[i];
+        }
+    }
+
+    if (magnitude) {
+        int64_t m = ((int64_t)x * CORDIC_GAIN_INV + ((int64_t)1 << 43)) >> 44;
+        *magnitude = (m > 32767) ? 32767 : (int16_t)m;
+    }
+    return (int16_t)(uint16_t)((angle + 128) >> 8);
+}
+
+// Arctangent: 18-iteration CORDIC on the vector scaled to full scale. Result
+// in the same binary angle units as sin_16 (32768 = pi). Max error 0.6 LSB
+// (0.0033 degree); atan2_16(0, 0) = 0.
+int16_t atan2_16(int16_t y, int16_t x) {
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+    return cordic_vector(x, y, NULL);
+}
+
+// Square root of a Q15 value (0 to 1) in Q15: bit-by-bit integer square root
+// of value << 15, rounded. Max error 0.5 LSB; negative inputs return 0.
+int16_t sqrt_16(int16_t value) {
+    if (value <= 0) {
+        return 0;
+    }
+
+    uint32_t n = (uint32_t)value << 15;
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    // n now holds value - root^2; round to nearest
+    if (n > root) {
+        root++;
+    }
+    return (root > 32767) ? 32767 : (int16_t)root;
+}
+
+// log2 of a positive integer in Q16: leading-one position plus a 64-segment
+// interpolated mantissa table (max error 2^-14)
+int32_t log2_q16(uint32_t x) {
+    int32_t msb = 31;
+    while (!(x & 0x80000000u)) {
+        x <<= 1;
+        msb--;
+    }
+
+    int32_t index = (x >> 25) & 63;
+    int32_t frac = (x >> 15) & 1023;
+    int32_t delta = log2_table[index + 1] - log2_table[index];
+    return (msb << 16) + log2_table[index] + ((delta * frac + 512) >> 10);
+}
+
+// 2^t for t in Q16, result in Q15 saturated to 32767: 64-segment
+// interpolated table for the fraction and a shift for the integer part
+int16_t exp2_q15(int32_t t) {
+    int32_t n = t >> 16;
+    int32_t f = t & 0xFFFF;
+
+    if (n >= 0) {
+        return 32767;
+    }
+    int32_t shift = 1 - n;
+    if (shift > 31) {
+        return 0;
+    }
+
+    int32_t index = f >> 10;
+    int32_t frac = f & 1023;
+    int32_t delta = exp2_table[index + 1] - exp2_table[index];
+    uint32_t v = exp2_table[index] + ((delta * frac + 512) >> 10);
+    v = (v + (1u << (shift - 1))) >> shift;
+    return (v > 32767) ? 32767 : (int16_t)v;
+}
+
+// Base-10 logarithm of a Q15 value (0 to 1), result in Q12 (-4.52 to 0).
+// Max error 1 LSB; non-positive inputs return -32768.
+int16_t log10_16(int16_t value) {
+    if (value <= 0) {
+        return -32768;
+    }
+
+    int64_t l2 = log2_q16((uint32_t)value) - (15 << 16);
+    return (int16_t)((l2 * LOG10_2_Q16 + (1 << 19)) >> 20);
+}
+
+// e^x for x in Q12 (-8 to 8), result in Q15 saturated to 32767 (x >= 0).
+// Max error 1.1 LSB.
+int16_t exp_16(int16_t value) {
+    int32_t t = ((int32_t)value * LOG2_E_Q14) >> 10;
+    return exp2_q15(t);
+}
+
+// base^exponent for a Q15 base (0 to 1) and a Q12 exponent, result in Q15
+// saturated to 32767. Computed as 2^(exponent * log2(base)); the log2 error
+// is scaled by the exponent, max error 4.1 LSB over the full Q12 range.
+// Non-positive bases return 0.
+int16_t pow_16(int16_t base, int16_t exponent) {
+    if (base <= 0) {
+        return 0;
+    }
+
+    int64_t t = ((int64_t)(log2_q16((uint32_t)base) - (15 << 16)) * exponent + 2048) >> 12;
+    if (t > 0x7FFFFFFF) {
+        t = 0x7FFFFFFF;
+    }
+    if (t < -0x7FFFFFFF) {
+        t = -0x7FFFFFFF;
+    }
+    return exp2_q15((int32_t)t);
+}
+
+// Batch sine and cosine of an angle array
+void sin_16_block(const int16_t *angles, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        output[i] = sin_16(angles[i]);
+    }
+}
+
+void cos_16_block(const int16_t *angles, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        output[i] = cos_16(angles[i]);
+    }
+}
+
+// Oscillators: sin/cos(start + n * step) with wrap-around phase
+void sin_16_ramp(int16_t *output, int16_t length, int16_t start, int16_t step) {
+    uint16_t phase = (uint16_t)start;
+
+    for (int i = 0; i < length; i++) {
+        output[i] = sin_16((int16_t)phase);
+        phase += (uint16_t)step;
+    }
+}
+
+void cos_16_ramp(int16_t *output, int16_t length, int16_t start, int16_t step) {
+    sin_16_ramp(output, length, (int16_t)(uint16_t)((uint16_t)start + 16384), step);
+}
+
+// Symmetric windows, w[n] = sum a_m cos(2 pi m n / (length - 1)), Q15.
+// Angles are binary as in fir_design_lowpass.
+static void cosine_window_16(int16_t *window, int16_t length, int32_t a0, int32_t a1, int32_t a2) {
+    if (length == 1) {
+        window[0] = 32767;
+        return;
+    }
+    for (int n = 0; n < length; n++) {
+        int16_t angle = (int16_t)(((int32_t)n << 16) / (length - 1));
+        int32_t w = a0 - ((a1 * cos_16(angle) + 16384) >> 15)
+                       + ((a2 * cos_16((int16_t)(2 * angle)) + 16384) >> 15);
+        window[n] = saturate_16(w);
+    }
+}
+
+// Hamming: 0.54 - 0.46 cos
+void hamming_window_16(int16_t *window, int16_t length) {
+    cosine_window_16(window, length, 17695, 15073, 0);
+}
+
+// Hann: 0.5 - 0.5 cos
+void hanning_window_16(int16_t *window, int16_t length) {
+    cosine_window_16(window, length, 16384, 16384, 0);
+}
+
+// Blackman: 0.42 - 0.5 cos + 0.08 cos 2x
+void blackman_window_16(int16_t *window, int16_t length) {
+    cosine_window_16(window, length, 13763, 16384, 2621);
+}
+
+#if defined(DSP_BACKEND_X86)
+// Four lanes of cordic_vector's magnitude path. The direction of each step
+// is applied as a conditional negate, (v ^ m) - m, so every lane follows
+// the scalar arithmetic exactly.
+static void cordic_magnitude_x4(const int16_t *real, const int16_t *imag, int16_t *magnitude) {
+    __m128i x = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)real));
+    __m128i y = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)imag));
+
+    __m128i left = _mm_cmpgt_epi32(_mm_setzero_si128(), x);
+    x = _mm_sub_epi32(_mm_xor_si128(x, left), left);
+    y = _mm_sub_epi32(_mm_xor_si128(y, left), left);
+
+    x = _mm_slli_epi32(x, 14);
+    y = _mm_slli_epi32(y, 14);
+    for (int i = 0; i < 16; i++) {
+        __m128i count = _mm_cvtsi32_si128(i);
+        __m128i x_shift = _mm_sra_epi32(x, count);
+        __m128i y_shift = _mm_sra_epi32(y, count);
+        __m128i down = _mm_cmpeq_epi32(_mm_cmpgt_epi32(y, _mm_setzero_si128()), _mm_setzero_si128());
+        x = _mm_add_epi32(x, _mm_sub_epi32(_mm_xor_si128(y_shift, down), down));
+        y = _mm_sub_epi32(y, _mm_sub_epi32(_mm_xor_si128(x_shift, down), down));
+    }
+
+    // x >= 0 here, so the 64-bit products can be shifted logically
+    __m128i gain = _mm_set1_epi32(CORDIC_GAIN_INV);
+    __m128i round = _mm_set1_epi64x((int64_t)1 << 43);
+    __m128i even = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(x, gain), round), 44);
+    __m128i odd = _mm_srli_epi64(_mm_add_epi64(_mm_mul_epi32(_mm_srli_epi64(x, 32), gain), round), 44);
+    __m128i m = _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+    m = _mm_min_epi32(m, _mm_set1_epi32(32767));
+    _mm_storel_epi64((__m128i *)magnitude, _mm_packs_epi32(m, m));
+}
+#endif
+
+// Magnitude of complex samples (CORDIC), saturated to 32767; max error 0.5 LSB
+void magnitude_16(int16_t *real, int16_t *imag, int16_t *magnitude, int16_t length) {
+    int i = 0;
+#if defined(DSP_BACKEND_X86)
+    for (; i + 4 <= length; i += 4) {
+        cordic_magnitude_x4(&real[i], &imag[i], &magnitude[i]);
+    }
+#endif
+    for (; i < length; i++) {
+        cordic_vector(real[i], imag[i], &magnitude[i]);
+    }
+}
+
+// Phase of complex samples in binary angle units (CORDIC)
+void phase_16(int16_t *real, int16_t *imag, int16_t *phase, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        phase[i] = atan2_16(imag[i], real[i]);
+    }
+}
@@ -9,28 +9,438 @@
 #include <stdint.h>
 #include <math.h>
 
-// Hardware MAC instruction wrapper
+// Backend selection. Target builds use the custom instructions; host builds
+// use SSE4.1/AVX2 when the compiler enables them (-march=native) and plain C
+// otherwise, or when DSP_BACKEND_GENERIC is defined. All backends give
+// bit-identical results.
+#if defined(__riscv)
+#define DSP_BACKEND_RISCV
+#define DSP_BACKEND_NAME "riscv"
+#elif defined(__SSE4_1__) && !defined(DSP_BACKEND_GENERIC)
+#define DSP_BACKEND_X86
+#include <immintrin.h>
+#if defined(__AVX2__)
+#define DSP_BACKEND_NAME "avx2"
+#else
+#define DSP_BACKEND_NAME "sse4.1"
+#endif
+#else
+#ifndef DSP_BACKEND_GENERIC
+#define DSP_BACKEND_GENERIC
+#endif
+#define DSP_BACKEND_NAME "generic"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__riscv)
+
+// Hardware MAC instruction wrapper (R-type, funct7 = 0000001, rd += rs1 * rs2)
 static inline int32_t mac(int32_t acc, int16_t a, int16_t b) {
     int32_t result;
     __asm__ volatile (
-        "mac %0, %1, %2, %3"
+        ".insn r 0x33, 0, 0x01, %0, %1, %2"
         : "=r" (result)
-        : "r" (acc), "r" (a), "r" (b)
+        : "r" (a), "r" (b), "0" (acc)
     );
     return result;
 }
 
-// Hardware SIMD MAC instruction wrapper
-static inline int32_t simd_mac4(int16_t *coeffs, int16_t *samples) {
+// Dual 16x16 dot product: sat32(a.lo * b.lo + a.hi * b.hi) (SIMD DOT2)
+static inline int32_t simd_dot2(int32_t a, int32_t b) {
     int32_t result;
-    __asm__ volatile (
-        "simd_mac4 %0, %1, %2"
-        : "=r" (result)
-        : "r" (coeffs), "r" (samples)
-    );
+    __asm__ (".insn r 0x33, 3, 0x03, %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+// Dual 16x16 product difference: a.lo * b.lo - a.hi * b.hi (SIMD DOTS2)
+static inline int32_t simd_dots2(int32_t a, int32_t b) {
+    int32_t result;
+    __asm__ (".insn r 0x33, 4, 0x03, %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+// Signed 4x8-bit dot product (SIMD DOT4)
+static inline int32_t simd_dot4(int32_t a, int32_t b) {
+    int32_t result;
+    __asm__ (".insn r 0x33, 7, 0x02, %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+}
+
+// Accumulator-resident MAC (opcode 0101011). The 40-bit accumulator lives in
+// the MAC unit, so a chain of macc() calls issues one per cycle.
+
+// acc = a * b
+static inline void macc_clr(int16_t a, int16_t b) {
+    __asm__ volatile (".insn r 0x2B, 1, 0, x0, %0, %1" : : "r" (a), "r" (b));
+}
+
+// acc += a * b
+static inline void macc(int16_t a, int16_t b) {
+    __asm__ volatile (".insn r 0x2B, 0, 0, x0, %0, %1" : : "r" (a), "r" (b));
+}
+
+// acc += a.lo * b.lo + a.hi * b.hi (dual MAC on packed halfwords)
+static inline void macc2(int32_t a, int32_t b) {
+    __asm__ volatile (".insn r 0x2B, 3, 0, x0, %0, %1" : : "r" (a), "r" (b));
+}
+
+// Read acc >> shift, rounded and saturated to 32 bits
+static inline int32_t macc_rd(int16_t shift) {
+    int32_t result;
+    __asm__ volatile (".insn r 0x2B, 2, 0, %0, %1, x0" : "=r" (result) : "r" (shift));
+    return result;
+}
+
+#else
+
+// Portable MAC for host builds, wrapping like the hardware accumulator
+static inline int32_t mac(int32_t acc, int16_t a, int16_t b) {
+    return (int32_t)((uint32_t)acc + (uint32_t)((int32_t)a * b));
+}
+
+// Portable dual 16x16 dot product, saturated like simd_unit.v. Only
+// (-32768)^2 + (-32768)^2 overflows, and it is the only sum that wraps
+// to 0x80000000.
+static inline int32_t simd_dot2(int32_t a, int32_t b) {
+    uint32_t sum = (uint32_t)((int16_t)a * (int16_t)b) + (uint32_t)((int16_t)(a >> 16) * (int16_t)(b >> 16));
+    return (int32_t)(sum - (sum == 0x80000000u));
+}
+
+// Portable dual 16x16 product difference (always fits in 32 bits)
+static inline int32_t simd_dots2(int32_t a, int32_t b) {
+    return (int16_t)a * (int16_t)b - (int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+
+// Portable signed 4x8-bit dot product
+static inline int32_t simd_dot4(int32_t a, int32_t b) {
+    int32_t result = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        result += (int8_t)(a >> (8 * lane)) * (int8_t)(b >> (8 * lane));
+    }
+    return result;
+}
+
+// Portable accumulator. It is kept in 64 bits and wrapped to the MAC unit's
+// 40 bits on read, which gives the same result as wrapping every step.
+static inline int64_t *macc_state(void) {
+    static int64_t acc;
+    return &acc;
+}
+
+// acc = a * b
+static inline void macc_clr(int16_t a, int16_t b) {
+    *macc_state() = (int32_t)a * b;
+}
+
+// acc += a * b
+static inline void macc(int16_t a, int16_t b) {
+    *macc_state() += (int32_t)a * b;
+}
+
+// acc += a.lo * b.lo + a.hi * b.hi
+static inline void macc2(int32_t a, int32_t b) {
+    *macc_state() += (int32_t)(int16_t)a * (int16_t)b + (int64_t)((int16_t)(a >> 16) * (int16_t)(b >> 16));
+}
+
+// Read acc >> shift, rounded and saturated to 32 bits
+static inline int32_t macc_rd(int16_t shift) {
+    int64_t value = (int64_t)((uint64_t)*macc_state() << 24) >> 24;
+    if (shift > 40) return (value < 0) ? -1 : 0;
+    if (shift > 0) value = (value + ((int64_t)1 << (shift - 1))) >> shift;
+    if (value > INT32_MAX) return INT32_MAX;
+    if (value < INT32_MIN) return INT32_MIN;
+    return (int32_t)value;
+}
+
+#endif
+
+// Pack two 16-bit samples into one SIMD operand
+static inline int32_t pack_16x2(int16_t lo, int16_t hi) {
+    return (int32_t)(((uint32_t)(uint16_t)hi << 16) | (uint16_t)lo);
+}
+
+// Four-tap SIMD MAC: two dual-MAC dot products
+#if defined(DSP_BACKEND_X86)
+// pmaddwd wraps the one overflowing pair sum to 0x80000000; step it back to
+// 0x7fffffff as simd_dot2 saturates
+static inline int32_t simd_mac4(const int16_t *coeffs, const int16_t *samples) {
+    __m128i c = _mm_loadl_epi64((const __m128i *)coeffs);
+    __m128i s = _mm_loadl_epi64((const __m128i *)samples);
+    __m128i dots = _mm_madd_epi16(c, s);
+    dots = _mm_add_epi32(dots, _mm_cmpeq_epi32(dots, _mm_set1_epi32(INT32_MIN)));
+    return (int32_t)((uint32_t)_mm_cvtsi128_si32(dots) + (uint32_t)_mm_extract_epi32(dots, 1));
+}
+#else
+static inline int32_t simd_mac4(const int16_t *coeffs, const int16_t *samples) {
+    int32_t lo = simd_dot2(pack_16x2(coeffs[0], coeffs[1]), pack_16x2(samples[0], samples[1]));
+    int32_t hi = simd_dot2(pack_16x2(coeffs[2], coeffs[3]), pack_16x2(samples[2], samples[3]));
+    return (int32_t)((uint32_t)lo + (uint32_t)hi);
+}
+#endif
+
+// Performance counters (user CSRs 0xC00-0xC07, high words at 0xC80-0xC87).
+// Each read returns the 64-bit count; the high word is re-read to catch a
+// carry out of the low word. Host builds have no counters and read 0.
+#if defined(__riscv)
+#define PERF_COUNTER(name, csr_lo, csr_hi)                                  \
+    static inline uint64_t name(void) {                                     \
+        uint32_t lo, hi, hi2;                                               \
+        do {                                                                \
+            __asm__ volatile ("csrr %0, " #csr_hi : "=r" (hi));             \
+            __asm__ volatile ("csrr %0, " #csr_lo : "=r" (lo));             \
+            __asm__ volatile ("csrr %0, " #csr_hi : "=r" (hi2));            \
+        } while (hi != hi2);                                                \
+        return ((uint64_t)hi << 32) | lo;                                   \
+    }
+#else
+#define PERF_COUNTER(name, csr_lo, csr_hi)                                  \
+    static inline uint64_t name(void) { return 0; }
+#endif
+
+PERF_COUNTER(perf_cycles,          0xC00, 0xC80)  // Clock cycles
+PERF_COUNTER(perf_instret,         0xC02, 0xC82)  // Instructions retired
+PERF_COUNTER(perf_load_use_stalls, 0xC03, 0xC83)  // Load-use stall cycles
+PERF_COUNTER(perf_mem_stalls,      0xC04, 0xC84)  // Memory stall cycles
+PERF_COUNTER(perf_branch_flushes,  0xC05, 0xC85)  // Taken branches and jumps
+PERF_COUNTER(perf_mac_busy,        0xC06, 0xC86)  // MAC unit busy cycles
+PERF_COUNTER(perf_simd_busy,       0xC07, 0xC87)  // SIMD unit busy cycles
+PERF_COUNTER(perf_raw_stalls,      0xC08, 0xC88)  // Other RAW hazard stall cycles
+
+// Snapshot of all counters, for profiling a region of code
+typedef struct {
+    uint64_t cycles;           // Clock cycles
+    uint64_t instret;          // Instructions retired
+    uint64_t load_use_stalls;  // Load-use stall cycles
+    uint64_t mem_stalls;       // Memory stall cycles
+    uint64_t branch_flushes;   // Taken branches and jumps
+    uint64_t mac_busy;         // MAC unit busy cycles
+    uint64_t simd_busy;        // SIMD unit busy cycles
+    uint64_t raw_stalls;       // Other RAW hazard stall cycles
+} perf_counters_t;
+
+// Read all counters
+static inline void perf_snapshot(perf_counters_t *counters) {
+    counters->cycles = perf_cycles();
+    counters->instret = perf_instret();
+    counters->load_use_stalls = perf_load_use_stalls();
+    counters->mem_stalls = perf_mem_stalls();
+    counters->branch_flushes = perf_branch_flushes();
+    counters->mac_busy = perf_mac_busy();
+    counters->simd_busy = perf_simd_busy();
+    counters->raw_stalls = perf_raw_stalls();
+}
+
+// Counts since a snapshot: delta = now - start
+static inline void perf_delta(const perf_counters_t *start, perf_counters_t *delta) {
+    perf_counters_t now;
+    perf_snapshot(&now);
+    delta->cycles = now.cycles - start->cycles;
+    delta->instret = now.instret - start->instret;
+    delta->load_use_stalls = now.load_use_stalls - start->load_use_stalls;
+    delta->mem_stalls = now.mem_stalls - start->mem_stalls;
+    delta->branch_flushes = now.branch_flushes - start->branch_flushes;
+    delta->mac_busy = now.mac_busy - start->mac_busy;
+    delta->simd_busy = now.simd_busy - start->simd_busy;
+    delta->raw_stalls = now.raw_stalls - start->raw_stalls;
+}
+
+// Post-increment addressing (opcode 1111011, CSRs 0x800-0x802). The access
+// goes through the pointer, which then advances; circular pointers wrap
+// inside [base, base + size) and bit-reversed accesses reverse the low
+// brev_log2 bits of the element index from base. No extra instructions are
+// spent on the wrap or the reversal.
+#if defined(__riscv)
+
+// Configure the buffer used by the circular and bit-reversed modes
+static inline void addr_setup(const void *base, uint32_t size, int16_t brev_log2) {
+    __asm__ volatile ("csrw 0x800, %0" : : "r" (base));
+    __asm__ volatile ("csrw 0x801, %0" : : "r" (size));
+    __asm__ volatile ("csrw 0x802, %0" : : "r" ((uint32_t)brev_log2));
+}
+
+// x = **p, then *p steps back one sample through the circular buffer
+static inline int16_t load_circ_dec_16(const int16_t **p) {
+    int32_t result;
+    __asm__ volatile (".insn i 0x7B, 1, %0, %1, 2046" : "=&r" (result), "+r" (*p) : : "memory");
+    return (int16_t)result;
+}
+
+// Word at the bit-reversed index of *p, then *p steps one word
+static inline int32_t load_brev_32(const int32_t **p) {
+    int32_t result;
+    __asm__ volatile (".insn i 0x7B, 2, %0, %1, -2044" : "=&r" (result), "+r" (*p) : : "memory");
     return result;
 }
 
+// **p = value, then *p steps one word
+static inline void store_inc_32(int32_t **p, int32_t value) {
+    __asm__ volatile (".insn s 0x7B, 6, %1, 4(%0)" : "+r" (*p) : "r" (value) : "memory");
+}
+
+#else
+
+// Portable addressing state: base, size in bytes, brev_log2
+static inline uintptr_t *addr_state(void) {
+    static uintptr_t state[3];
+    return state;
+}
+
+static inline void addr_setup(const void *base, uint32_t size, int16_t brev_log2) {
+    uintptr_t *state = addr_state();
+    state[0] = (uintptr_t)base;
+    state[1] = size;
+    state[2] = (uintptr_t)brev_log2;
+}
+
+static inline int16_t load_circ_dec_16(const int16_t **p) {
+    const uintptr_t *state = addr_state();
+    int16_t result = **p;
+    if ((uintptr_t)*p == state[0]) {
+        *p += state[1] / sizeof(int16_t);
+    }
+    (*p)--;
+    return result;
+}
+
+static inline int32_t load_brev_32(const int32_t **p) {
+    const uintptr_t *state = addr_state();
+    const int32_t *base = (const int32_t *)state[0];
+    uint32_t index = (uint32_t)(*p - base);
+    uint32_t reversed = 0;
+    for (uintptr_t i = 0; i < state[2]; i++) {
+        reversed = (reversed << 1) | ((index >> i) & 1);
+    }
+    (*p)++;
+    return base[reversed];
+}
+
+static inline void store_inc_32(int32_t **p, int32_t value) {
+    **p = value;
+    (*p)++;
+}
+
+#endif
+
+// Dual-bank data memory: bank X at 0x0000-0x0FFF, bank Y at 0x1000-0x1FFF
+// (software/riscv_dsp.ld). DSP_XMEM and DSP_YMEM place an array in a bank;
+// put coefficients in X and samples in Y. macc_xy and macc2_xy read one
+// operand from each bank in the same cycle and accumulate their product,
+// stepping both pointers. The X pointer steps forward; the Y pointer steps
+// back through the circular buffer set up with addr_setup (macc_xy) or
+// forward (macc2_xy).
+#if defined(__riscv)
+
+#define DSP_XMEM __attribute__((section(".xdata")))
+#define DSP_YMEM __attribute__((section(".ydata")))
+
+// acc += (*x)[0] * (*y)[0], then *x steps forward and *y back one sample
+static inline void macc_xy(const int16_t **x, const int16_t **y) {
+    __asm__ volatile (".insn r 0x2B, 4, 5, %0, %0, %1" : "+r" (*x), "+r" (*y) : : "memory");
+}
+
+// acc += both halfword products of (*x)[0] and (*y)[0], then both step one word
+static inline void macc2_xy(const int32_t **x, const int32_t **y) {
+    __asm__ volatile (".insn r 0x2B, 5, 0, %0, %0, %1" : "+r" (*x), "+r" (*y) : : "memory");
+}
+
+#else
+
+#define DSP_XMEM
+#define DSP_YMEM
+
+static inline void macc_xy(const int16_t **x, const int16_t **y) {
+    int16_t sample = load_circ_dec_16(y);
+    macc(*(*x)++, sample);
+}
+
+static inline void macc2_xy(const int32_t **x, const int32_t **y) {
+    macc2(*(*x)++, *(*y)++);
+}
+
+#endif
+
+// DMA controller (CSRs 0x810-0x815). Each channel streams 16-bit samples
+// between the external port and a ping-pong pair of len-sample halves, the
+// pong half directly after the ping half. A done bit is set, and the DMA
+// interrupt raised if enabled, each time a half completes; the half bits
+// give the half the channel is on, so firmware works on the other one.
+#define DMA_RX_ENABLE  0x1
+#define DMA_TX_ENABLE  0x2
+#define DMA_RX_IRQ     0x4
+#define DMA_TX_IRQ     0x8
+
+#define DMA_RX_DONE    0x01
+#define DMA_TX_DONE    0x02
+#define DMA_RX_HALF    0x04
+#define DMA_TX_HALF    0x08
+#define DMA_RX_OVERRUN 0x10
+#define DMA_TX_UNDERRUN 0x20
+
+#if defined(__riscv)
+
+// Point both channels at their buffers (2 * len samples each)
+static inline void dma_setup(int16_t *rx, int16_t *tx, uint16_t len) {
+    __asm__ volatile ("csrw 0x812, %0" : : "r" (rx));
+    __asm__ volatile ("csrw 0x813, %0" : : "r" ((uint32_t)len));
+    __asm__ volatile ("csrw 0x814, %0" : : "r" (tx));
+    __asm__ volatile ("csrw 0x815, %0" : : "r" ((uint32_t)len));
+}
+
+// Set or clear DMA_*_ENABLE and DMA_*_IRQ bits
+static inline void dma_start(uint32_t flags) {
+    __asm__ volatile ("csrs 0x810, %0" : : "r" (flags) : "memory");
+}
+
+static inline void dma_stop(uint32_t flags) {
+    __asm__ volatile ("csrc 0x810, %0" : : "r" (flags) : "memory");
+}
+
+static inline uint32_t dma_status(void) {
+    uint32_t status;
+    __asm__ volatile ("csrr %0, 0x811" : "=r" (status) : : "memory");
+    return status;
+}
+
+// Clear DMA_*_DONE, DMA_RX_OVERRUN and DMA_TX_UNDERRUN bits
+static inline void dma_ack(uint32_t bits) {
+    __asm__ volatile ("csrc 0x811, %0" : : "r" (bits) : "memory");
+}
+
+#else
+
+// No stream on the host: the registers are kept, the channels never move
+static inline uint32_t *dma_state(void) {
+    static uint32_t state[2];   // ctrl, status
+    return state;
+}
+
+static inline void dma_setup(int16_t *rx, int16_t *tx, uint16_t len) {
+    (void)rx;
+    (void)tx;
+    (void)len;
+}
+
+static inline void dma_start(uint32_t flags) {
+    dma_state()[0] |= flags;
+}
+
+static inline void dma_stop(uint32_t flags) {
+    dma_state()[0] &= ~flags;
+}
+
+static inline uint32_t dma_status(void) {
+    return dma_state()[1];
+}
+
+static inline void dma_ack(uint32_t bits) {
+    dma_state()[1] &= ~bits;
+}
+
+#endif
+
 // Saturation function
 static inline int16_t saturate_16(int32_t value) {
     if (value > 32767) return 32767;
@@ -38,6 +448,14 @@ static inline int16_t saturate_16(int32_t value) {
     return (int16_t)value;
 }
 
+// Scale by 2^exponent with rounding and saturation (block floating point to fixed)
+static inline int16_t scale_exp_16(int32_t value, int16_t exponent) {
+    if (exponent > 16) return (value > 0) ? 32767 : (value < 0) ? -32768 : 0;
+    if (exponent >= 0) return saturate_16(value << exponent);
+    if (exponent < -31) return 0;
+    return saturate_16((value + (1 << (-exponent - 1))) >> -exponent);
+}
+
 // Clipping function
 static inline int16_t clip(int16_t value, int16_t min_val, int16_t max_val) {
     if (value < min_val) return min_val;
@@ -65,27 +483,41 @@ static inline int16_t min_16(int16_t a, int16_t b) {
     return (a < b) ? a : b;
 }
 
-// Square root (using Newton's method)
+// Fixed-point elementary functions (dsp_math.c). Angles are binary: the full
+// circle is 65536, so 16384 = pi/2 and -32768 = -pi.
+
+// Square root of a Q15 value, Q15 result (max error 0.5 LSB)
 int16_t sqrt_16(int16_t value);
 
-// Sine function (lookup table based)
+// Sine and cosine, Q15 result (quarter-wave table, max error 1 LSB)
 int16_t sin_16(int16_t angle);
-
-// Cosine function (lookup table based)
 int16_t cos_16(int16_t angle);
 
-// Arctangent function
+// Arctangent of y/x as a binary angle (CORDIC, max error 0.6 LSB)
 int16_t atan2_16(int16_t y, int16_t x);
 
-// Logarithm function (base 10)
+// Logarithm (base 10) of a Q15 value, Q12 result (max error 1 LSB)
 int16_t log10_16(int16_t value);
 
-// Exponential function
+// Exponential of a Q12 value, Q15 result (max error 1.1 LSB)
 int16_t exp_16(int16_t value);
 
-// Power function
+// Power: Q15 base, Q12 exponent, Q15 result (max error 4.1 LSB)
 int16_t pow_16(int16_t base, int16_t exponent);
 
+// Building blocks for the above: log2 of a positive integer in Q16 (max
+// error 2^-14) and 2^t for a Q16 t, Q15 result saturated to 32767
+int32_t log2_q16(uint32_t x);
+int16_t exp2_q15(int32_t t);
+
+// Batch sine/cosine of an angle array
+void sin_16_block(const int16_t *angles, int16_t *output, int16_t length);
+void cos_16_block(const int16_t *angles, int16_t *output, int16_t length);
+
+// Oscillators: output[n] = sin/cos(start + n * step)
+void sin_16_ramp(int16_t *output, int16_t length, int16_t start, int16_t step);
+void cos_16_ramp(int16_t *output, int16_t length, int16_t start, int16_t step);
+
 // Convolution function
 void convolution_16(int16_t *input, int16_t *kernel, int16_t *output, 
                    int16_t input_len, int16_t kernel_len);
@@ -94,11 +526,12 @@ void convolution_16(int16_t *input, int16_t *kernel, int16_t *output,
 void correlation_16(int16_t *input1, int16_t *input2, int16_t *output, 
                    int16_t len1, int16_t len2);
 
-// Moving average filter
+// Moving average and median filters. They allocate a sliding window on the
+// heap per call; DSP_NO_MALLOC builds use window_init_arena instead.
+#if !defined(DSP_NO_MALLOC)
 void moving_average_16(int16_t *input, int16_t *output, int16_t length, int16_t window_size);
-
-// Median filter
 void median_filter_16(int16_t *input, int16_t *output, int16_t length, int16_t window_size);
+#endif
 
 // Peak detection
 int16_t find_peaks_16(int16_t *input, int16_t *peaks, int16_t length, int16_t threshold);
@@ -124,7 +557,7 @@ void mul_16(int16_t *input1, int16_t *input2, int16_t *output, int16_t length);
 // Signal division
 void div_16(int16_t *input1, int16_t *input2, int16_t *output, int16_t length);
 
-// Window functions
+// Window functions, symmetric (w[0] = w[length - 1]) in Q15
 void hamming_window_16(int16_t *window, int16_t length);
 void hanning_window_16(int16_t *window, int16_t length);
 void blackman_window_16(int16_t *window, int16_t length);
@@ -140,9 +573,12 @@ void qpsk_modulate_16(int16_t *bits, int16_t *output, int16_t length);
 void bpsk_demodulate_16(int16_t *input, int16_t *bits, int16_t length);
 void qpsk_demodulate_16(int16_t *input, int16_t *bits, int16_t length);
 
-// Pulse shaping
+// Pulse shaping. Heap buffers per call; DSP_NO_MALLOC builds use
+// raised_cosine_design and interpolator_init with their own storage.
+#if !defined(DSP_NO_MALLOC)
 void raised_cosine_filter_16(int16_t *input, int16_t *output, int16_t length, 
                             int16_t rolloff_factor, int16_t samples_per_symbol);
+#endif
 
 // Timing recovery
 int16_t timing_recovery_16(int16_t *input, int16_t length);
@@ -161,4 +597,8 @@ void awgn_16(int16_t *output, int16_t length, int16_t snr_db);
 int16_t snr_estimate_16(int16_t *signal, int16_t *noise, int16_t length);
 int16_t ber_estimate_16(int16_t *transmitted, int16_t *received, int16_t length);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif // DSP_MATH_H
@@ -0,0 +1,361 @@
+//=============================================================================
+// Compile-Time DSP Tables for RISC-V DSP Processor
+// constexpr filter design, FFT tables and fixed-tap FIR kernels (C++17)
+//=============================================================================
+//
+// Header-only mirror of the runtime design code: every table comes out
+// bit-identical to fir_design_*(), the window functions and fft_init(), but
+// is evaluated by the compiler and lands in .rodata. Firmware then starts
+// with its coefficients and twiddles in place and needs neither the design
+// code nor libm. See rom_tables.cpp for the tables main.c uses.
+//
+//   static constexpr auto lowpass = dsp::fir_lowpass<64, 1000, 10000>();
+//   static constexpr auto plan = dsp::fft_tables<256>();
+//   dsp::fir_fixed<lowpass>::process_block(&fir, input, output, length);
+
+#ifndef DSP_TABLES_HPP
+#define DSP_TABLES_HPP
+
+#include <stdint.h>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+#include "dsp_math.h"
+#include "fir_filter.h"
+#include "fft.h"
+
+namespace dsp {
+
+// Fixed-size table usable in constant expressions
+template <typename T, int N>
+struct table {
+    T data[N];
+
+    static constexpr int size = N;
+    constexpr T &operator[](int i) { return data[i]; }
+    constexpr const T &operator[](int i) const { return data[i]; }
+};
+
+//=============================================================================
+// Fixed-point elementary functions, as in dsp_math.c
+//=============================================================================
+
+namespace detail {
+
+constexpr double pi = 3.14159265358979323846;
+
+// sin(x) for 0 <= x <= pi/2 by its Taylor series; only ever run by the
+// compiler, so the target needs no floating point
+constexpr double sin_series(double x) {
+    double term = x;
+    double sum = x;
+    for (int k = 1; k < 16; k++) {
+        term *= -x * x / ((2 * k) * (2 * k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+// The quarter-wave table of dsp_math.c: round(32768 sin(pi i / 512)),
+// clipped to 32767
+constexpr table<int16_t, 257> make_sin_table() {
+    table<int16_t, 257> t{};
+    for (int i = 0; i <= 256; i++) {
+        int32_t value = (int32_t)(32768.0 * sin_series(pi * i / 512) + 0.5);
+        t[i] = (int16_t)((value > 32767) ? 32767 : value);
+    }
+    return t;
+}
+
+inline constexpr table<int16_t, 257> sin_table = make_sin_table();
+
+constexpr int16_t sin_quarter(int32_t r) {
+    int32_t index = r >> 6;
+    int32_t frac = r & 63;
+
+    if (index == 256) {
+        return sin_table[256];
+    }
+    int32_t delta = sin_table[index + 1] - sin_table[index];
+    return (int16_t)(sin_table[index] + ((delta * frac + 32) >> 6));
+}
+
+constexpr int16_t saturate(int32_t value) {
+    return (value > 32767) ? 32767 : (value < -32768) ? -32768 : (int16_t)value;
+}
+
+constexpr int16_t log2_size(int n) {
+    int16_t bits = 0;
+    while ((1 << bits) < n) {
+        bits++;
+    }
+    return bits;
+}
+
+} // namespace detail
+
+// Sine and cosine of a binary angle, Q15; equal to sin_16/cos_16
+constexpr int16_t sin_16(int16_t angle) {
+    uint16_t a = (uint16_t)angle;
+    int32_t r = a & 0x3FFF;
+
+    switch (a >> 14) {
+        case 0:  return detail::sin_quarter(r);
+        case 1:  return detail::sin_quarter(16384 - r);
+        case 2:  return (int16_t)-detail::sin_quarter(r);
+        default: return (int16_t)-detail::sin_quarter(16384 - r);
+    }
+}
+
+constexpr int16_t cos_16(int16_t angle) {
+    return sin_16((int16_t)(uint16_t)((uint16_t)angle + 16384));
+}
+
+//=============================================================================
+// Windows: symmetric, Q15, equal to hamming/hanning/blackman_window_16
+//=============================================================================
+
+enum class window { rectangular, hamming, hanning, blackman };
+
+constexpr int16_t window_value(window type, int n, int length) {
+    int32_t a0 = 32767, a1 = 0, a2 = 0;
+
+    switch (type) {
+        case window::rectangular: return 32767;
+        case window::hamming:     a0 = 17695; a1 = 15073; break;
+        case window::hanning:     a0 = 16384; a1 = 16384; break;
+        case window::blackman:    a0 = 13763; a1 = 16384; a2 = 2621; break;
+    }
+    if (length == 1) {
+        return 32767;
+    }
+    int16_t angle = (int16_t)(((int32_t)n << 16) / (length - 1));
+    int32_t w = a0 - ((a1 * cos_16(angle) + 16384) >> 15)
+                   + ((a2 * cos_16((int16_t)(2 * angle)) + 16384) >> 15);
+    return detail::saturate(w);
+}
+
+template <int Length, window Type>
+constexpr table<int16_t, Length> make_window() {
+    table<int16_t, Length> t{};
+    for (int n = 0; n < Length; n++) {
+        t[n] = window_value(Type, n, Length);
+    }
+    return t;
+}
+
+//=============================================================================
+// FIR design over tap count, cutoff and window. The Hamming designs equal
+// fir_design_lowpass/highpass/bandpass; other windows use the same sinc.
+//=============================================================================
+
+namespace detail {
+
+// fir_lowpass_coeff in fir_filter.c, with the window as a parameter
+constexpr int16_t lowpass_coeff(int i, int taps, int cutoff_freq, int sample_rate, window type) {
+    int32_t omega_c = ((int32_t)cutoff_freq << 16) / sample_rate;
+    int32_t n = i - taps / 2;
+
+    if (n == 0) {
+        return saturate((2 * (int32_t)cutoff_freq * 32767) / sample_rate);
+    }
+    int32_t sinc_val = ((int32_t)sin_16((int16_t)(omega_c * n)) * 10430 / n + 16384) >> 15;
+    return (int16_t)((sinc_val * window_value(type, i, taps) + 16384) >> 15);
+}
+
+} // namespace detail
+
+template <int Taps, int CutoffFreq, int SampleRate, window Type = window::hamming>
+constexpr table<int16_t, Taps> fir_lowpass() {
+    static_assert(Taps > 1 && CutoffFreq > 0 && 2 * CutoffFreq <= SampleRate && SampleRate <= 32767,
+                  "cutoff must be below Nyquist and the rate must fit in int16_t");
+    table<int16_t, Taps> t{};
+    for (int i = 0; i < Taps; i++) {
+        t[i] = detail::lowpass_coeff(i, Taps, CutoffFreq, SampleRate, Type);
+    }
+    return t;
+}
+
+template <int Taps, int CutoffFreq, int SampleRate, window Type = window::hamming>
+constexpr table<int16_t, Taps> fir_highpass() {
+    table<int16_t, Taps> t = fir_lowpass<Taps, CutoffFreq, SampleRate, Type>();
+    for (int i = 0; i < Taps; i++) {
+        t[i] = (int16_t)-t[i];
+    }
+    t[Taps / 2] = (int16_t)(t[Taps / 2] + 32767);
+    return t;
+}
+
+template <int Taps, int LowFreq, int HighFreq, int SampleRate, window Type = window::hamming>
+constexpr table<int16_t, Taps> fir_bandpass() {
+    static_assert(LowFreq < HighFreq, "band edges out of order");
+    table<int16_t, Taps> high = fir_lowpass<Taps, HighFreq, SampleRate, Type>();
+    table<int16_t, Taps> low = fir_lowpass<Taps, LowFreq, SampleRate, Type>();
+    table<int16_t, Taps> t{};
+    for (int i = 0; i < Taps; i++) {
+        t[i] = detail::saturate((int32_t)high[i] - low[i]);
+    }
+    return t;
+}
+
+//=============================================================================
+// FFT tables in the layout of fft_init: stage-ordered twiddles, radix-4
+// triples and the bit-reversal permutation. The twiddles of the N/2 plan
+// are the first N/2 entries of the N-point ones, so fft_real's half-size
+// plan can share them.
+//=============================================================================
+
+template <int N>
+struct fft_table_set {
+    table<complex_t, N> twiddles;
+    table<complex_t, N> radix4_twiddles;
+    table<int16_t, N> bit_reverse;
+};
+
+// fft_real's half-size plan: it borrows the N-point twiddles, so only its
+// radix-4 triples and permutation are built
+template <int N>
+struct fft_half_table_set {
+    table<complex_t, N / 2> radix4_twiddles;
+    table<int16_t, N / 2> bit_reverse;
+};
+
+namespace detail {
+
+template <int N>
+constexpr void fft_bit_reverse(table<int16_t, N> &t) {
+    constexpr int16_t log2_n = log2_size(N);
+    for (int i = 0; i < N; i++) {
+        int16_t result = 0;
+        int16_t x = (int16_t)i;
+        for (int b = 0; b < log2_n; b++) {
+            result = (int16_t)((result << 1) | (x & 1));
+            x >>= 1;
+        }
+        t[i] = result;
+    }
+}
+
+template <int N>
+constexpr void fft_radix4_twiddles(table<complex_t, N> &t) {
+    constexpr int16_t log2_n = log2_size(N);
+    int r = 0;
+    for (int group_size = (log2_n & 1) ? 2 : 1; 4 * group_size <= N; group_size <<= 2) {
+        for (int k = 0; k < group_size; k++) {
+            for (int m = 1; m <= 3; m++) {
+                int16_t angle = (int16_t)(-16384 / group_size * m * k);
+                t[r++] = complex_t{cos_16(angle), sin_16(angle)};
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+template <int N>
+constexpr fft_table_set<N> fft_tables() {
+    static_assert(N >= 2 && (N & (N - 1)) == 0 && N <= (1 << FFT_MAX_LOG2_SIZE), "FFT size must be a power of two");
+    fft_table_set<N> t{};
+
+    detail::fft_bit_reverse<N>(t.bit_reverse);
+    for (int group_size = 1; group_size < N; group_size <<= 1) {
+        for (int k = 0; k < group_size; k++) {
+            int16_t angle = (int16_t)(-32768 / group_size * k);
+            t.twiddles[group_size - 1 + k] = complex_t{cos_16(angle), sin_16(angle)};
+        }
+    }
+    detail::fft_radix4_twiddles<N>(t.radix4_twiddles);
+    return t;
+}
+
+template <int N>
+constexpr fft_half_table_set<N> fft_half_tables() {
+    static_assert(N >= 4 && (N & (N - 1)) == 0 && N <= (1 << FFT_MAX_LOG2_SIZE), "FFT size must be a power of two");
+    fft_half_table_set<N> t{};
+
+    detail::fft_bit_reverse<N / 2>(t.bit_reverse);
+    detail::fft_radix4_twiddles<N / 2>(t.radix4_twiddles);
+    return t;
+}
+
+//=============================================================================
+// Fixed-tap FIR kernels. The coefficients are template arguments, so the
+// tap loop is fully unrolled with each coefficient an immediate operand and
+// no loop counter or coefficient loads. Works on an fir_filter_t set up by
+// fir_init with the same table and is bit-exact with fir_process and
+// fir_process_block; calls to either may be mixed on one filter.
+//=============================================================================
+
+template <const auto &Coeffs>
+struct fir_fixed {
+    static constexpr int taps = std::remove_reference_t<decltype(Coeffs)>::size;
+
+    static int16_t process(fir_filter_t *fir, int16_t input) {
+        if (fir->index == FIR_DELAY_LINE_LEN(taps)) {
+            rewind(fir);
+        }
+        int16_t *x = &fir->delay_line[fir->index];
+        x[0] = input;
+        fir->index++;
+        return saturate_16(dot(x, std::make_index_sequence<taps>()));
+    }
+
+    // Four outputs per pass, as fir_process_block
+    static void process_block(fir_filter_t *fir, const int16_t *input, int16_t *output, int16_t length) {
+        int n = 0;
+
+        if (taps >= FIR_BLOCK_OUTPUTS) {
+            for (; n + FIR_BLOCK_OUTPUTS <= length; n += FIR_BLOCK_OUTPUTS) {
+                if (fir->index + FIR_BLOCK_OUTPUTS > FIR_DELAY_LINE_LEN(taps)) {
+                    rewind(fir);
+                }
+                int16_t *x = &fir->delay_line[fir->index];
+                x[0] = input[n];
+                x[1] = input[n + 1];
+                x[2] = input[n + 2];
+                x[3] = input[n + 3];
+
+                int32_t acc[FIR_BLOCK_OUTPUTS] = {0, 0, 0, 0};
+                dot4(acc, x, std::make_index_sequence<taps>());
+                fir->index += FIR_BLOCK_OUTPUTS;
+
+                output[n] = saturate_16(acc[0]);
+                output[n + 1] = saturate_16(acc[1]);
+                output[n + 2] = saturate_16(acc[2]);
+                output[n + 3] = saturate_16(acc[3]);
+            }
+        }
+        for (; n < length; n++) {
+            output[n] = process(fir, input[n]);
+        }
+    }
+
+private:
+    // As fir_rewind: keep the last taps - 1 samples at the start
+    static void rewind(fir_filter_t *fir) {
+        int16_t *history = &fir->delay_line[fir->index - taps + 1];
+        for (int i = 0; i < taps - 1; i++) {
+            fir->delay_line[i] = history[i];
+        }
+        fir->index = taps - 1;
+    }
+
+    template <size_t... I>
+    static int32_t dot(const int16_t *x, std::index_sequence<I...>) {
+        int32_t acc = 0;
+        ((acc = mac(acc, Coeffs[I], x[-(int)I])), ...);
+        return acc;
+    }
+
+    template <size_t... I>
+    static void dot4(int32_t *acc, const int16_t *x, std::index_sequence<I...>) {
+        ((acc[0] = mac(acc[0], Coeffs[I], x[-(int)I]),
+          acc[1] = mac(acc[1], Coeffs[I], x[1 - (int)I]),
+          acc[2] = mac(acc[2], Coeffs[I], x[2 - (int)I]),
+          acc[3] = mac(acc[3], Coeffs[I], x[3 - (int)I])), ...);
+    }
+};
+
+} // namespace dsp
+
+#endif // DSP_TABLES_HPP
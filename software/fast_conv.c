@@ -0,0 +1,288 @@
+//=============================================================================
+// Streaming Fast Convolution for RISC-V DSP Processor
+// Uniformly partitioned overlap-save FIR built on the FFT and FIR kernels
+//=============================================================================
+
+#include "dsp_math.h"
+#include "fast_conv.h"
+
+// Exponent given to all-zero partitions; low enough to never be the maximum
+#define FAST_CONV_ZERO_EXPONENT (-16384)
+
+// Approximate multiplies per block for each mode. The FFT estimate counts a
+// radix-4 transform as 1.5 * M * log2(M) real multiplies and doubles the
+// transform cost to cover the block floating point passes.
+static int32_t direct_cost(int16_t taps, int16_t block_size) {
+    return (int32_t)taps * block_size;
+}
+
+static int32_t fft_cost(int16_t taps, int16_t block_size, int16_t log2_block) {
+    int32_t partitions = (taps + block_size - 1) / block_size;
+    int32_t forward = 3 * block_size * log2_block / 2 + 4 * block_size;
+    int32_t inverse = 3 * block_size * (log2_block + 1);
+    return 2 * (forward + inverse) + 4 * partitions * (block_size + 1);
+}
+
+// Number of significant bits in a magnitude
+static int16_t magnitude_bits(uint32_t value) {
+    int16_t bits = 0;
+    while (bits < 32 && (value >> bits) != 0) {
+        bits++;
+    }
+    return bits;
+}
+
+// Mode selection: overlap-save needs a power-of-two block size
+static int16_t fast_conv_use_fft(int16_t taps, int16_t block_size) {
+    int16_t log2_block = 0;
+    while ((1 << log2_block) < block_size) {
+        log2_block++;
+    }
+    return (1 << log2_block) == block_size &&
+           log2_block < FFT_MAX_LOG2_SIZE &&
+           fft_cost(taps, block_size, log2_block) < direct_cost(taps, block_size);
+}
+
+// Bytes fast_conv_init_arena takes, not counting the cached FFT plan
+uint32_t fast_conv_workspace_size(int16_t taps, int16_t block_size) {
+    if (!fast_conv_use_fft(taps, block_size)) {
+        return ARENA_BLOCK_SIZE(taps * sizeof(int16_t)) +
+               ARENA_BLOCK_SIZE(FIR_DELAY_LINE_LEN(taps) * sizeof(int16_t));
+    }
+
+    int32_t fft_size = 2 * block_size;
+    int32_t bins = block_size + 1;
+    int32_t partitions = (taps + block_size - 1) / block_size;
+    return 2 * ARENA_BLOCK_SIZE(partitions * bins * sizeof(complex_t)) +
+           2 * ARENA_BLOCK_SIZE(partitions * sizeof(int16_t)) +
+           ARENA_BLOCK_SIZE(fft_size * sizeof(int16_t)) +
+           2 * ARENA_BLOCK_SIZE(fft_size * sizeof(complex_t)) +
+           ARENA_BLOCK_SIZE(2 * bins * sizeof(int32_t));
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Initialize convolver
+int16_t fast_conv_init(fast_conv_t *conv, const int16_t *coeffs, int16_t taps, int16_t block_size) {
+    return fast_conv_init_arena(conv, coeffs, taps, block_size, NULL);
+}
+#endif
+
+// Initialize convolver from an arena (or the heap for NULL)
+int16_t fast_conv_init_arena(fast_conv_t *conv, const int16_t *coeffs, int16_t taps, int16_t block_size,
+                             arena_t *arena) {
+    uint32_t mark = arena_mark(arena);
+
+    conv->tap_count = taps;
+    conv->block_size = block_size;
+    conv->use_fft = fast_conv_use_fft(taps, block_size);
+    conv->arena = arena;
+
+    if (!conv->use_fft) {
+        conv->coeffs = (int16_t*)dsp_alloc(arena, taps * sizeof(int16_t));
+        conv->delay_line = (int16_t*)dsp_alloc(arena, FIR_DELAY_LINE_LEN(taps) * sizeof(int16_t));
+        if (!conv->coeffs || !conv->delay_line) {
+            fast_conv_cleanup(conv);
+            arena_release(arena, mark);
+            return 0;
+        }
+        for (int i = 0; i < taps; i++) {
+            conv->coeffs[i] = coeffs[i];
+        }
+        fir_init(&conv->fir, conv->coeffs, conv->delay_line, taps);
+        return 1;
+    }
+
+    int16_t fft_size = 2 * block_size;
+    int16_t bins = block_size + 1;
+    int16_t partitions = (taps + block_size - 1) / block_size;
+
+    conv->plan = fft_plan_get(fft_size);
+    conv->partition_count = partitions;
+    conv->partitions = (complex_t*)dsp_alloc(arena, partitions * bins * sizeof(complex_t));
+    conv->partition_exponents = (int16_t*)dsp_alloc(arena, partitions * sizeof(int16_t));
+    conv->fdl = (complex_t*)dsp_alloc(arena, partitions * bins * sizeof(complex_t));
+    conv->fdl_exponents = (int16_t*)dsp_alloc(arena, partitions * sizeof(int16_t));
+    conv->fdl_head = 0;
+    conv->input_buffer = (int16_t*)dsp_alloc(arena, fft_size * sizeof(int16_t));
+    conv->spectrum = (complex_t*)dsp_alloc(arena, fft_size * sizeof(complex_t));
+    conv->time_buffer = (complex_t*)dsp_alloc(arena, fft_size * sizeof(complex_t));
+    conv->accumulator = (int32_t*)dsp_alloc(arena, 2 * bins * sizeof(int32_t));
+    if (!conv->plan || !conv->partitions || !conv->partition_exponents || !conv->fdl ||
+        !conv->fdl_exponents || !conv->input_buffer || !conv->spectrum || !conv->time_buffer ||
+        !conv->accumulator) {
+        fast_conv_cleanup(conv);
+        arena_release(arena, mark);
+        return 0;
+    }
+
+    // Partition spectra: B taps zero-padded to 2B, each normalized to full
+    // scale with its own exponent
+    int16_t *padded = conv->input_buffer;
+    for (int p = 0; p < partitions; p++) {
+        for (int i = 0; i < fft_size; i++) {
+            int32_t tap = p * block_size + i;
+            padded[i] = (i < block_size && tap < taps) ? coeffs[tap] : 0;
+        }
+
+        int16_t exponent = fft_real(conv->plan, padded, conv->spectrum);
+
+        uint16_t max_val = 0;
+        for (int k = 0; k < bins; k++) {
+            max_val |= (uint16_t)abs_16(conv->spectrum[k].real) | (uint16_t)abs_16(conv->spectrum[k].imag);
+        }
+        int16_t up = (max_val == 0) ? 0 : 15 - magnitude_bits(max_val);
+        if (up < 0) {
+            up = 0;
+        }
+
+        complex_t *h = &conv->partitions[p * bins];
+        for (int k = 0; k < bins; k++) {
+            h[k].real = conv->spectrum[k].real << up;
+            h[k].imag = conv->spectrum[k].imag << up;
+        }
+        // An all-zero partition must not set the common exponent
+        conv->partition_exponents[p] = (max_val == 0) ? FAST_CONV_ZERO_EXPONENT : exponent - up;
+    }
+
+    // Clear streaming state
+    for (int i = 0; i < fft_size; i++) {
+        conv->input_buffer[i] = 0;
+    }
+    for (int i = 0; i < partitions * bins; i++) {
+        conv->fdl[i].real = 0;
+        conv->fdl[i].imag = 0;
+    }
+    for (int p = 0; p < partitions; p++) {
+        conv->fdl_exponents[p] = FAST_CONV_ZERO_EXPONENT;
+    }
+    return 1;
+}
+
+// Overlap-save block: transform the last 2B inputs, multiply-accumulate
+// against every partition, inverse transform and keep the last B samples
+static void fast_conv_process_fft(fast_conv_t *conv, const int16_t *input, int16_t *output) {
+    int16_t block_size = conv->block_size;
+    int16_t fft_size = 2 * block_size;
+    int16_t bins = block_size + 1;
+    int16_t partitions = conv->partition_count;
+    int32_t *acc = conv->accumulator;
+
+    // Slide the new block into the input buffer
+    for (int i = 0; i < block_size; i++) {
+        conv->input_buffer[i] = conv->input_buffer[block_size + i];
+        conv->input_buffer[block_size + i] = input[i];
+    }
+
+    // Newest input spectrum goes into the frequency-domain delay line
+    conv->fdl_head = (conv->fdl_head == 0) ? partitions - 1 : conv->fdl_head - 1;
+    int16_t exponent = fft_real(conv->plan, conv->input_buffer, conv->spectrum);
+    complex_t *x = &conv->fdl[conv->fdl_head * bins];
+    uint16_t input_max = 0;
+    for (int k = 0; k < bins; k++) {
+        x[k] = conv->spectrum[k];
+        input_max |= (uint16_t)x[k].real | (uint16_t)x[k].imag;
+    }
+    // An all-zero window, like an all-zero partition, drops out of the sum
+    conv->fdl_exponents[conv->fdl_head] = (input_max == 0) ? FAST_CONV_ZERO_EXPONENT : exponent;
+
+    // Common exponent of all partition products
+    int16_t max_exponent = FAST_CONV_ZERO_EXPONENT;
+    int16_t slot = conv->fdl_head;
+    for (int p = 0; p < partitions; p++) {
+        if (conv->fdl_exponents[slot] != FAST_CONV_ZERO_EXPONENT &&
+            conv->partition_exponents[p] != FAST_CONV_ZERO_EXPONENT) {
+            int16_t e = conv->fdl_exponents[slot] + conv->partition_exponents[p];
+            if (e > max_exponent) {
+                max_exponent = e;
+            }
+        }
+        slot = (slot + 1 == partitions) ? 0 : slot + 1;
+    }
+    if (max_exponent == FAST_CONV_ZERO_EXPONENT) {
+        for (int n = 0; n < block_size; n++) {
+            output[n] = 0;
+        }
+        return;
+    }
+
+    // Y = sum over p of X[newest - p] * H[p], products in Q15 aligned to max_exponent
+    for (int k = 0; k < 2 * bins; k++) {
+        acc[k] = 0;
+    }
+    slot = conv->fdl_head;
+    for (int p = 0; p < partitions; p++) {
+        int16_t shift = max_exponent - conv->fdl_exponents[slot] - conv->partition_exponents[p];
+        const complex_t *xp = &conv->fdl[slot * bins];
+        const complex_t *hp = &conv->partitions[p * bins];
+
+        // Full-precision complex product, rounded once to the common
+        // exponent. Rounding in two steps keeps the 32-bit sum from
+        // overflowing; past a shift of 16 every product rounds to zero.
+        if (conv->fdl_exponents[slot] != FAST_CONV_ZERO_EXPONENT &&
+            conv->partition_exponents[p] != FAST_CONV_ZERO_EXPONENT && shift <= 16) {
+            int16_t down = 14 + shift;
+            for (int k = 0; k < bins; k++) {
+                int32_t packed_x = pack_complex(xp[k]);
+                int32_t packed_h = pack_complex(hp[k]);
+                acc[2 * k] += ((simd_dots2(packed_x, packed_h) >> down) + 1) >> 1;
+                acc[2 * k + 1] += ((simd_dot2(packed_x, swap_complex(packed_h)) >> down) + 1) >> 1;
+            }
+        }
+        slot = (slot + 1 == partitions) ? 0 : slot + 1;
+    }
+
+    // Bring the accumulator back to 16 bits
+    uint32_t max_val = 0;
+    for (int k = 0; k < 2 * bins; k++) {
+        max_val |= (uint32_t)((acc[k] < 0) ? -acc[k] : acc[k]);
+    }
+    int16_t shift = magnitude_bits(max_val) - 15;
+    if (shift < 0) {
+        shift = 0;
+    }
+
+    // Full 2B-point spectrum by conjugate symmetry
+    complex_t *y = conv->spectrum;
+    int32_t round = (shift > 0) ? 1 << (shift - 1) : 0;
+    for (int k = 0; k < bins; k++) {
+        y[k].real = saturate_16((acc[2 * k] + round) >> shift);
+        y[k].imag = saturate_16((acc[2 * k + 1] + round) >> shift);
+    }
+    for (int k = 1; k < block_size; k++) {
+        y[fft_size - k].real = y[k].real;
+        y[fft_size - k].imag = -y[k].imag;
+    }
+
+    exponent = ifft_radix4(conv->plan, y, conv->time_buffer) + 15 + max_exponent + shift;
+
+    // The last B samples are free of circular wrap-around
+    for (int n = 0; n < block_size; n++) {
+        output[n] = scale_exp_16(conv->time_buffer[block_size + n].real, exponent);
+    }
+}
+
+// Filter one block
+void fast_conv_process(fast_conv_t *conv, const int16_t *input, int16_t *output) {
+    if (conv->use_fft) {
+        fast_conv_process_fft(conv, input, output);
+    } else {
+        fir_process_block(&conv->fir, input, output, conv->block_size);
+    }
+}
+
+// Cleanup convolver resources
+void fast_conv_cleanup(fast_conv_t *conv) {
+    if (conv->use_fft) {
+        dsp_free(conv->arena, conv->partitions);
+        dsp_free(conv->arena, conv->partition_exponents);
+        dsp_free(conv->arena, conv->fdl);
+        dsp_free(conv->arena, conv->fdl_exponents);
+        dsp_free(conv->arena, conv->input_buffer);
+        dsp_free(conv->arena, conv->spectrum);
+        dsp_free(conv->arena, conv->time_buffer);
+        dsp_free(conv->arena, conv->accumulator);
+    } else {
+        dsp_free(conv->arena, conv->coeffs);
+        dsp_free(conv->arena, conv->delay_line);
+    }
+}
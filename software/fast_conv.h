@@ -0,0 +1,60 @@
+//=============================================================================
+// Streaming Fast Convolution for RISC-V DSP Processor
+// Uniformly partitioned overlap-save FIR built on the FFT and FIR kernels
+//=============================================================================
+
+#ifndef FAST_CONV_H
+#define FAST_CONV_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fft.h"
+
+// Convolver structure. Filters fixed-size blocks with the same output
+// convention as fir_process (saturate_16 of the full tap sum).
+typedef struct {
+    int16_t tap_count;          // Number of filter taps
+    int16_t block_size;         // Samples per fast_conv_process call (B)
+    int16_t use_fft;            // 1: overlap-save, 0: direct-form FIR
+
+    // Direct mode
+    fir_filter_t fir;           // Direct-form filter state
+    int16_t *coeffs;            // Copy of the coefficients
+    int16_t *delay_line;        // FIR delay line
+
+    // Overlap-save mode
+    fft_t *plan;                // 2B-point plan from the plan cache
+    int16_t partition_count;    // Number of B-tap partitions (P)
+    complex_t *partitions;      // Partition spectra, B + 1 bins each
+    int16_t *partition_exponents;
+    complex_t *fdl;             // Frequency-domain delay line, P input spectra
+    int16_t *fdl_exponents;
+    int16_t fdl_head;           // Slot holding the newest input spectrum
+    int16_t *input_buffer;      // Previous and current input block (2B)
+    complex_t *spectrum;        // 2B-point work buffer
+    complex_t *time_buffer;     // 2B-point work buffer
+    int32_t *accumulator;       // Spectral accumulator, (B + 1) complex
+
+    arena_t *arena;             // Where the buffers came from (NULL: heap)
+} fast_conv_t;
+
+// Initialize from a coefficient array; selects direct or FFT mode. Returns 0
+// if an allocation fails or no plan could be built.
+#if !defined(DSP_NO_MALLOC)
+int16_t fast_conv_init(fast_conv_t *conv, const int16_t *coeffs, int16_t taps, int16_t block_size);
+#endif
+
+// Same, with the buffers (fast_conv_workspace_size bytes) taken from an
+// arena. The FFT plan comes from the plan cache and is sized separately.
+// Returns 0 if the arena is too small or no plan could be built.
+int16_t fast_conv_init_arena(fast_conv_t *conv, const int16_t *coeffs, int16_t taps, int16_t block_size,
+                             arena_t *arena);
+uint32_t fast_conv_workspace_size(int16_t taps, int16_t block_size);
+
+// Filter one block of block_size samples
+void fast_conv_process(fast_conv_t *conv, const int16_t *input, int16_t *output);
+
+// Release convolver resources
+void fast_conv_cleanup(fast_conv_t *conv);
+
+#endif // FAST_CONV_H
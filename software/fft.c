@@ -4,23 +4,39 @@
 //=============================================================================
 
 #include "dsp_math.h"
+#include "fft.h"
+#include <string.h>
 
-// Complex number structure
-typedef struct {
-    int16_t real;
-    int16_t imag;
-} complex_t;
+// Plan cache, indexed by log2 of the FFT size, and where new plans come from
+static fft_t fft_plan_cache[FFT_MAX_LOG2_SIZE + 1];
+static arena_t *fft_plan_arena = NULL;
 
-// FFT structure
-typedef struct {
-    complex_t *twiddle_factors;  // Twiddle factors
-    complex_t *temp_buffer;      // Temporary buffer
-    int16_t fft_size;           // FFT size (power of 2)
-    int16_t log2_size;          // Log2 of FFT size
-} fft_t;
+// Bit-reverse function using hardware support
+int16_t bit_reverse(int16_t x, int16_t log2_size) {
+    int16_t result = 0;
+    for (int i = 0; i < log2_size; i++) {
+        result = (result << 1) | (x & 1);
+        x >>= 1;
+    }
+    return result;
+}
 
+// Bytes fft_init_arena takes
+uint32_t fft_workspace_size(int16_t size) {
+    return 3 * ARENA_BLOCK_SIZE(size * sizeof(complex_t)) + ARENA_BLOCK_SIZE(size * sizeof(int16_t));
+}
+
+#if !defined(DSP_NO_MALLOC)
 // Initialize FFT
 void fft_init(fft_t *fft, int16_t size) {
+    fft_init_arena(fft, size, NULL);
+}
+#endif
+
+// Initialize FFT from an arena (or the heap for NULL)
+int16_t fft_init_arena(fft_t *fft, int16_t size, arena_t *arena) {
+    uint32_t mark = arena_mark(arena);
+    
     fft->fft_size = size;
     fft->log2_size = 0;
     
@@ -31,36 +47,132 @@ void fft_init(fft_t *fft, int16_t size) {
         fft->log2_size++;
     }
     
-    // Allocate memory for twiddle factors and temp buffer
-    fft->twiddle_factors = (complex_t*)malloc(size * sizeof(complex_t));
-    fft->temp_buffer = (complex_t*)malloc(size * sizeof(complex_t));
+    // Allocate memory for twiddle factors, permutation and temp buffer
+    complex_t *twiddle_factors = (complex_t*)dsp_alloc(arena, size * sizeof(complex_t));
+    complex_t *radix4_twiddles = (complex_t*)dsp_alloc(arena, size * sizeof(complex_t));
+    int16_t *bit_reverse_table = (int16_t*)dsp_alloc(arena, size * sizeof(int16_t));
+    fft->twiddle_factors = twiddle_factors;
+    fft->radix4_twiddles = radix4_twiddles;
+    fft->bit_reverse_table = bit_reverse_table;
+    fft->temp_buffer = (complex_t*)dsp_alloc(arena, size * sizeof(complex_t));
+    fft->static_tables = (arena != NULL);
     
-    // Generate twiddle factors
+    // Arena blocks are only dropped (fft_cleanup frees heap plans alone)
+    if (!twiddle_factors || !radix4_twiddles || !bit_reverse_table || !fft->temp_buffer) {
+        fft_cleanup(fft);
+        arena_release(arena, mark);
+        return 0;
+    }
+    
+    // Bit-reversal permutation
     for (int i = 0; i < size; i++) {
-        float angle = -2.0 * M_PI * i / size;
-        fft->twiddle_factors[i].real = (int16_t)(cos(angle) * 32767);
-        fft->twiddle_factors[i].imag = (int16_t)(sin(angle) * 32767);
+        bit_reverse_table[i] = bit_reverse(i, fft->log2_size);
     }
+    
+    // Generate twiddle factors in stage order: the stage with group size g
+    // uses W_N^(k * N / 2g) for k = 0..g-1, stored at offset g - 1
+    for (int group_size = 1; group_size < size; group_size <<= 1) {
+        complex_t *stage_twiddles = &twiddle_factors[group_size - 1];
+        for (int k = 0; k < group_size; k++) {
+            int16_t angle = (int16_t)(-32768 / group_size * k);
+            stage_twiddles[k].real = cos_16(angle);
+            stage_twiddles[k].imag = sin_16(angle);
+        }
+    }
+    
+    // Radix-4 twiddles: the stage combining four groups of size g stores
+    // W^k, W^2k, W^3k (W = W_4g) for k = 0..g-1, stages back to back
+    for (int group_size = (fft->log2_size & 1) ? 2 : 1; 4 * group_size <= size; group_size <<= 2) {
+        for (int k = 0; k < group_size; k++) {
+            for (int m = 1; m <= 3; m++) {
+                int16_t angle = (int16_t)(-16384 / group_size * m * k);
+                radix4_twiddles->real = cos_16(angle);
+                radix4_twiddles->imag = sin_16(angle);
+                radix4_twiddles++;
+            }
+        }
+    }
+    return 1;
 }
 
-// Bit-reverse function using hardware support
-int16_t bit_reverse(int16_t x, int16_t log2_size) {
-    int16_t result = 0;
-    for (int i = 0; i < log2_size; i++) {
-        result = (result << 1) | (x & 1);
-        x >>= 1;
+// Plan over caller-owned tables
+void fft_init_static(fft_t *fft, int16_t size, const complex_t *twiddles, const complex_t *radix4_twiddles,
+                     const int16_t *bit_reverse_table, complex_t *temp_buffer) {
+    fft->fft_size = size;
+    fft->log2_size = 0;
+    while ((1 << fft->log2_size) < size) {
+        fft->log2_size++;
+    }
+    
+    fft->twiddle_factors = twiddles;
+    fft->radix4_twiddles = radix4_twiddles;
+    fft->bit_reverse_table = bit_reverse_table;
+    fft->temp_buffer = temp_buffer;
+    fft->static_tables = 1;
+}
+
+// Look up the plan for a size, creating it on first use
+fft_t *fft_plan_get(int16_t size) {
+    int16_t log2_size = 0;
+    while ((1 << log2_size) < size) {
+        log2_size++;
+    }
+    
+    if (size < 1 || (1 << log2_size) != size || log2_size > FFT_MAX_LOG2_SIZE) {
+        return NULL;
+    }
+    
+    fft_t *plan = &fft_plan_cache[log2_size];
+    if (plan->twiddle_factors == NULL) {
+        uint32_t mark = arena_mark(fft_plan_arena);
+        if (!fft_init_arena(plan, size, fft_plan_arena)) {
+            return NULL;
+        }
+        
+        // fft_real runs on the half-size plan; create it now rather than on
+        // first use, and give up on both if it cannot be built
+        if (size > 1 && fft_plan_get(size >> 1) == NULL) {
+            fft_cleanup(plan);
+            arena_release(fft_plan_arena, mark);
+            return NULL;
+        }
+    }
+    
+    return plan;
+}
+
+// Build later plans in an arena
+void fft_plan_cache_arena(arena_t *arena) {
+    fft_plan_arena = arena;
+}
+
+// Adopt a prebuilt plan for its size
+int16_t fft_plan_install(const fft_t *plan) {
+    if (plan->log2_size > FFT_MAX_LOG2_SIZE || fft_plan_cache[plan->log2_size].twiddle_factors != NULL) {
+        return 0;
+    }
+    
+    fft_plan_cache[plan->log2_size] = *plan;
+    return 1;
+}
+
+// Release every cached plan
+void fft_plan_cache_clear(void) {
+    for (int i = 0; i <= FFT_MAX_LOG2_SIZE; i++) {
+        fft_cleanup(&fft_plan_cache[i]);
     }
-    return result;
 }
 
 // Complex multiplication using hardware MAC
 complex_t complex_mul(complex_t a, complex_t b) {
     complex_t result;
     
-    // Use hardware MAC for complex multiplication
+    // Use the dual-MAC SIMD dot products for complex multiplication
     // (a + jb) * (c + jd) = (ac - bd) + j(ad + bc)
-    int32_t real_part = mac(0, a.real, b.real) - mac(0, a.imag, b.imag);
-    int32_t imag_part = mac(0, a.real, b.imag) + mac(0, a.imag, b.real);
+    int32_t packed_a = pack_complex(a);
+    int32_t packed_b = pack_complex(b);
+    int32_t real_part = simd_dots2(packed_a, packed_b);
+    int32_t imag_part = simd_dot2(packed_a, swap_complex(packed_b));
     
     result.real = saturate_16(real_part);
     result.imag = saturate_16(imag_part);
@@ -84,26 +196,65 @@ complex_t complex_sub(complex_t a, complex_t b) {
     return result;
 }
 
+// output[i] = input[bit_reverse(i)]. On the DSP core the address generator
+// reverses the index during the load, so the copy is one load and one store
+// per point; elsewhere the permutation table is used.
+static void bit_reverse_copy(const fft_t *fft, const complex_t *input, complex_t *output) {
+#if defined(__riscv)
+    const int32_t *src = (const int32_t *)input;
+    int32_t *dst = (int32_t *)output;
+    addr_setup(input, 0, fft->log2_size);
+    for (int i = 0; i < fft->fft_size; i++) {
+        store_inc_32(&dst, load_brev_32(&src));
+    }
+#else
+    const int16_t *reversed_index = fft->bit_reverse_table;
+    for (int i = 0; i < fft->fft_size; i++) {
+        output[i] = input[reversed_index[i]];
+    }
+#endif
+}
+
+// Bit-reversed copy that also returns the OR of all component magnitudes
+// (the permutation does not change it), so the first stage needs no scan
+static uint16_t bit_reverse_copy_max(const fft_t *fft, const complex_t *input, complex_t *output) {
+    uint16_t max_val = 0;
+#if defined(__riscv)
+    const int32_t *src = (const int32_t *)input;
+    int32_t *dst = (int32_t *)output;
+    addr_setup(input, 0, fft->log2_size);
+    for (int i = 0; i < fft->fft_size; i++) {
+        int32_t packed = load_brev_32(&src);
+        max_val |= (uint16_t)abs_16((int16_t)packed) | (uint16_t)abs_16((int16_t)(packed >> 16));
+        store_inc_32(&dst, packed);
+    }
+#else
+    const int16_t *reversed_index = fft->bit_reverse_table;
+    for (int i = 0; i < fft->fft_size; i++) {
+        complex_t x = input[reversed_index[i]];
+        max_val |= (uint16_t)abs_16(x.real) | (uint16_t)abs_16(x.imag);
+        output[i] = x;
+    }
+#endif
+    return max_val;
+}
+
 // Radix-2 FFT implementation
 void fft_radix2(fft_t *fft, complex_t *input, complex_t *output) {
     int16_t size = fft->fft_size;
     int16_t log2_size = fft->log2_size;
     
     // Bit-reverse the input
-    for (int i = 0; i < size; i++) {
-        int16_t reversed_index = bit_reverse(i, log2_size);
-        output[i] = input[reversed_index];
-    }
+    bit_reverse_copy(fft, input, output);
     
     // FFT computation
     for (int stage = 0; stage < log2_size; stage++) {
         int16_t group_size = 1 << stage;
-        int16_t twiddle_step = size >> (stage + 1);
+        const complex_t *stage_twiddles = &fft->twiddle_factors[group_size - 1];
         
         for (int group = 0; group < size; group += 2 * group_size) {
             for (int k = 0; k < group_size; k++) {
-                int16_t twiddle_index = k * twiddle_step;
-                complex_t twiddle = fft->twiddle_factors[twiddle_index];
+                complex_t twiddle = stage_twiddles[k];
                 
                 int16_t index1 = group + k;
                 int16_t index2 = group + k + group_size;
@@ -119,6 +270,143 @@ void fft_radix2(fft_t *fft, complex_t *input, complex_t *output) {
     }
 }
 
+// Q15 twiddle multiply with 32-bit result, two products per dot product.
+// Twiddles stay within +/-32767, so the sums never saturate.
+static inline void twiddle_mul(int32_t *re, int32_t *im, complex_t x, complex_t w) {
+    int32_t packed_x = pack_complex(x);
+    int32_t packed_w = pack_complex(w);
+    *re = (simd_dots2(packed_x, packed_w) + 16384) >> 15;
+    *im = (simd_dot2(packed_x, swap_complex(packed_w)) + 16384) >> 15;
+}
+
+// Shift that keeps a stage with the given growth (in bits) inside 16 bits,
+// from the OR of the magnitudes of the stage input
+static int16_t magnitude_shift(uint16_t max_val, int16_t growth_bits) {
+    int16_t bits = 0;
+    while (bits < 16 && (max_val >> bits) != 0) {
+        bits++;
+    }
+    
+    int16_t shift = bits + growth_bits - 15;
+    return (shift > 0) ? shift : 0;
+}
+
+// Store one butterfly output component and return its magnitude for the
+// next stage's maximum
+static inline uint16_t store_tracked(int16_t *dst, int32_t value) {
+    int16_t v = (int16_t)value;
+    *dst = v;
+    return (uint16_t)abs_16(v);
+}
+
+// Radix-4 FFT with block floating point scaling. The magnitude maximum that
+// sets each stage's shift is gathered while the previous stage (or the
+// bit-reversed copy) writes its outputs, so every stage is a single pass.
+// *max_out receives the maximum of the final output.
+static int16_t fft_radix4_tracked(fft_t *fft, complex_t *input, complex_t *output, uint16_t *max_out) {
+    int16_t size = fft->fft_size;
+    const complex_t *twiddles = fft->radix4_twiddles;
+    int16_t exponent = 0;
+    int16_t group_size = 1;
+    
+    // Bit-reverse the input
+    uint16_t max_val = bit_reverse_copy_max(fft, input, output);
+    
+    // Radix-2 first stage for odd log2 sizes (twiddles are all 1)
+    if (fft->log2_size & 1) {
+        int16_t shift = magnitude_shift(max_val, 1);
+        exponent += shift;
+        max_val = 0;
+        
+        for (int i = 0; i < size; i += 2) {
+            complex_t x0 = output[i];
+            complex_t x1 = output[i + 1];
+            uint16_t m0 = store_tracked(&output[i].real, (x0.real + x1.real) >> shift) |
+                          store_tracked(&output[i].imag, (x0.imag + x1.imag) >> shift);
+            uint16_t m1 = store_tracked(&output[i + 1].real, (x0.real - x1.real) >> shift) |
+                          store_tracked(&output[i + 1].imag, (x0.imag - x1.imag) >> shift);
+            max_val |= m0 | m1;
+        }
+        group_size = 2;
+    }
+    
+    // Radix-4 stages: each merges two radix-2 stages. Component growth per
+    // stage is below 4 * sqrt(2), so three guard bits are reserved.
+    for (; group_size < size; group_size <<= 2) {
+        int16_t shift = magnitude_shift(max_val, 3);
+        exponent += shift;
+        max_val = 0;
+        
+        for (int group = 0; group < size; group += 4 * group_size) {
+            for (int k = 0; k < group_size; k++) {
+                complex_t *x = &output[group + k];
+                int32_t t0r = x[0].real, t0i = x[0].imag;
+                int32_t t1r, t1i, t2r, t2i, t3r, t3i;
+                
+                // t1 = W^2k B1, t2 = W^k B2, t3 = W^3k B3
+                if (k == 0) {
+                    t1r = x[group_size].real;     t1i = x[group_size].imag;
+                    t2r = x[2 * group_size].real; t2i = x[2 * group_size].imag;
+                    t3r = x[3 * group_size].real; t3i = x[3 * group_size].imag;
+                } else {
+                    const complex_t *w = &twiddles[3 * k];
+                    twiddle_mul(&t1r, &t1i, x[group_size], w[1]);
+                    twiddle_mul(&t2r, &t2i, x[2 * group_size], w[0]);
+                    twiddle_mul(&t3r, &t3i, x[3 * group_size], w[2]);
+                }
+                
+                int32_t ar = t0r + t1r, ai = t0i + t1i;
+                int32_t br = t0r - t1r, bi = t0i - t1i;
+                int32_t cr = t2r + t3r, ci = t2i + t3i;
+                int32_t dr = t2r - t3r, di = t2i - t3i;
+                
+                // Magnitudes are OR-ed pairwise so the tracking adds no
+                // serial dependency chain to the butterfly
+                uint16_t m0 = store_tracked(&x[0].real, (ar + cr) >> shift) |
+                              store_tracked(&x[0].imag, (ai + ci) >> shift);
+                uint16_t m1 = store_tracked(&x[group_size].real, (br + di) >> shift) |
+                              store_tracked(&x[group_size].imag, (bi - dr) >> shift);
+                uint16_t m2 = store_tracked(&x[2 * group_size].real, (ar - cr) >> shift) |
+                              store_tracked(&x[2 * group_size].imag, (ai - ci) >> shift);
+                uint16_t m3 = store_tracked(&x[3 * group_size].real, (br - di) >> shift) |
+                              store_tracked(&x[3 * group_size].imag, (bi + dr) >> shift);
+                max_val |= (m0 | m1) | (m2 | m3);
+            }
+        }
+        twiddles += 3 * group_size;
+    }
+    
+    *max_out = max_val;
+    return exponent;
+}
+
+// Radix-4 FFT with block floating point scaling
+int16_t fft_radix4(fft_t *fft, complex_t *input, complex_t *output) {
+    uint16_t max_val;
+    return fft_radix4_tracked(fft, input, output, &max_val);
+}
+
+// Inverse radix-4 FFT: conj(FFT(conj(X))) / N
+int16_t ifft_radix4(fft_t *fft, complex_t *input, complex_t *output) {
+    int16_t size = fft->fft_size;
+    
+    // Conjugate the input
+    for (int i = 0; i < size; i++) {
+        input[i].imag = -input[i].imag;
+    }
+    
+    int16_t exponent = fft_radix4(fft, input, output);
+    
+    // Restore the input and conjugate the output
+    for (int i = 0; i < size; i++) {
+        input[i].imag = -input[i].imag;
+        output[i].imag = -output[i].imag;
+    }
+    
+    // The 1/N scaling is folded into the exponent
+    return exponent - fft->log2_size;
+}
+
 // Inverse FFT
 void ifft_radix2(fft_t *fft, complex_t *input, complex_t *output) {
     int16_t size = fft->fft_size;
@@ -138,19 +426,77 @@ void ifft_radix2(fft_t *fft, complex_t *input, complex_t *output) {
     }
 }
 
-// Real-valued FFT (input is real, output is complex)
-void fft_real(fft_t *fft, int16_t *input, complex_t *output) {
+// Real-valued FFT (input is real, output is complex). The N reals are packed
+// into N/2 complex samples, transformed on the half-size plan and split into
+// the N-point spectrum. Returns the block exponent of the output, or
+// FFT_NO_PLAN (output untouched) if the half-size plan is not available.
+int16_t fft_real(fft_t *fft, int16_t *input, complex_t *output) {
     int16_t size = fft->fft_size;
-    complex_t *temp = fft->temp_buffer;
+    int16_t half = size >> 1;
+    complex_t *packed = &output[half];
+    complex_t *z = fft->temp_buffer;
+    fft_t *half_plan = fft_plan_get(half);
     
-    // Convert real input to complex
-    for (int i = 0; i < size; i++) {
-        temp[i].real = input[i];
-        temp[i].imag = 0;
+    if (half_plan == NULL) {
+        return FFT_NO_PLAN;
+    }
+    
+    // Normalize small inputs up to full scale so the transform keeps precision
+    int16_t max_val = 0;
+    for (int n = 0; n < size; n++) {
+        max_val |= abs_16(input[n]);
+    }
+    int16_t up = 0;
+    while (max_val != 0 && ((uint16_t)max_val << up) < 0x4000) {
+        up++;
+    }
+    
+    // Pack even samples into the real part and odd samples into the imaginary part
+    for (int n = 0; n < half; n++) {
+        packed[n].real = input[2 * n] << up;
+        packed[n].imag = input[2 * n + 1] << up;
+    }
+    
+    // Half-size complex FFT
+    uint16_t half_max;
+    int16_t exponent = fft_radix4_tracked(half_plan, packed, z, &half_max) - up;
+    
+    // Leave one guard bit for the split so A and B below fit in 16 bits
+    int16_t shift = magnitude_shift(half_max, 2);
+    exponent += shift;
+    for (int k = 0; k < half; k++) {
+        z[k].real >>= shift;
+        z[k].imag >>= shift;
+    }
+    
+    // Split: X[k] = (A - j W^k B) / 2 with A = Z[k] + conj(Z[N/2-k]),
+    // B = Z[k] - conj(Z[N/2-k]); W^k = W_N^k is the plan's last-stage twiddle
+    const complex_t *w = &fft->twiddle_factors[half - 1];
+    for (int k = 0; k < half; k++) {
+        complex_t zk = z[k];
+        complex_t zm = z[(half - k) & (half - 1)];
+        complex_t b;
+        int32_t ar = zk.real + zm.real;
+        int32_t ai = zk.imag - zm.imag;
+        b.real = zk.real - zm.real;
+        b.imag = zk.imag + zm.imag;
+        
+        int32_t p, q;
+        twiddle_mul(&p, &q, b, w[k]);
+        
+        output[k].real = (ar + q) >> 1;
+        output[k].imag = (ai - p) >> 1;
     }
     
-    // Perform FFT
-    fft_radix2(fft, temp, output);
+    // Nyquist bin and the conjugate-symmetric upper half
+    output[half].real = (z[0].real - z[0].imag);
+    output[half].imag = 0;
+    for (int k = 1; k < half; k++) {
+        output[size - k].real = output[k].real;
+        output[size - k].imag = -output[k].imag;
+    }
+    
+    return exponent;
 }
 
 // Real-valued IFFT (input is complex, output is real)
@@ -167,29 +513,72 @@ void ifft_real(fft_t *fft, complex_t *input, int16_t *output) {
     }
 }
 
-// Power spectrum calculation
-void fft_power_spectrum(fft_t *fft, complex_t *fft_output, int16_t *power_spectrum) {
+// log2(1 + (i + 0.5) / 64) in Q8, for the fractional part of log2_q8
+static const uint8_t log2_frac_q8[64] = {
+      3,   9,  14,  20,  25,  30,  36,  41,  46,  51,  56,  61,  66,  71,  75,  80,
+     85,  89,  94,  98, 103, 107, 111, 116, 120, 124, 128, 132, 136, 140, 144, 148,
+    152, 155, 159, 163, 167, 170, 174, 178, 181, 185, 188, 192, 195, 198, 202, 205,
+    208, 212, 215, 218, 221, 224, 228, 231, 234, 237, 240, 243, 246, 249, 252, 255
+};
+
+// Integer log2 in Q8 (x >= 1), max error 0.011
+static int16_t log2_q8(uint32_t x) {
+    int16_t msb = 0;
+    while ((x >> msb) > 1) {
+        msb++;
+    }
+    
+    // Six bits below the leading one index the fraction table
+    uint32_t frac = (msb >= 6) ? (x >> (msb - 6)) : (x << (6 - msb));
+    return (msb << 8) + log2_frac_q8[frac & 63];
+}
+
+// Power spectrum calculation in dB, without floating point.
+// exponent is the block exponent of fft_output (see fft_radix4/fft_real).
+void fft_power_spectrum(fft_t *fft, complex_t *fft_output, int16_t exponent, int16_t *power_spectrum) {
     int16_t size = fft->fft_size;
     
     for (int i = 0; i < size / 2; i++) {
-        int32_t real_sq = mac(0, fft_output[i].real, fft_output[i].real);
-        int32_t imag_sq = mac(0, fft_output[i].imag, fft_output[i].imag);
-        int32_t power = real_sq + imag_sq;
+        uint32_t real_sq = (uint32_t)mac(0, fft_output[i].real, fft_output[i].real);
+        uint32_t imag_sq = (uint32_t)mac(0, fft_output[i].imag, fft_output[i].imag);
+        uint32_t power = real_sq + imag_sq;
         
-        // Convert to dB scale (approximate)
-        power_spectrum[i] = (int16_t)(10 * log10(power + 1));
+        // 10 * log10(p) = log2(p) * 3.0103; 771 is 3.0103 in Q8
+        int32_t log2_power = log2_q8(power + 1) + (exponent << 9);
+        power_spectrum[i] = (int16_t)((log2_power * 771 + 32768) >> 16);
     }
 }
 
+// Bytes fft_filter_arena borrows while it runs
+uint32_t fft_filter_workspace_size(int16_t size) {
+    return ARENA_BLOCK_SIZE(size * sizeof(complex_t));
+}
+
+#if !defined(DSP_NO_MALLOC)
 // Frequency domain filtering
 void fft_filter(fft_t *fft, int16_t *input, int16_t *filter_response, int16_t *output) {
+    fft_filter_arena(fft, input, filter_response, output, NULL);
+}
+#endif
+
+// Frequency domain filtering, spectrum buffer from the arena
+int16_t fft_filter_arena(fft_t *fft, int16_t *input, int16_t *filter_response, int16_t *output, arena_t *arena) {
     int16_t size = fft->fft_size;
+    uint32_t mark = arena_mark(arena);
     complex_t *fft_input = fft->temp_buffer;
-    complex_t *fft_output = (complex_t*)malloc(size * sizeof(complex_t));
+    complex_t *fft_output = (complex_t*)dsp_alloc(arena, size * sizeof(complex_t));
+    
+    if (!fft_output) {
+        return 0;
+    }
     
     // Forward FFT
-    fft_real(fft, input, fft_input);
-    fft_radix2(fft, fft_input, fft_output);
+    int16_t exponent = fft_real(fft, input, fft_output);
+    if (exponent == FFT_NO_PLAN) {
+        dsp_free(arena, fft_output);
+        arena_release(arena, mark);
+        return 0;
+    }
     
     // Apply filter in frequency domain
     for (int i = 0; i < size; i++) {
@@ -198,19 +587,27 @@ void fft_filter(fft_t *fft, int16_t *input, int16_t *filter_response, int16_t *o
     }
     
     // Inverse FFT
-    ifft_real(fft, fft_output, output);
+    exponent += ifft_radix4(fft, fft_output, fft_input);
+    for (int i = 0; i < size; i++) {
+        output[i] = scale_exp_16(fft_input[i].real, exponent);
+    }
     
-    free(fft_output);
+    dsp_free(arena, fft_output);
+    arena_release(arena, mark);
+    return 1;
 }
 
 // Cleanup FFT resources
 void fft_cleanup(fft_t *fft) {
-    if (fft->twiddle_factors) {
-        free(fft->twiddle_factors);
-        fft->twiddle_factors = NULL;
-    }
-    if (fft->temp_buffer) {
-        free(fft->temp_buffer);
-        fft->temp_buffer = NULL;
+    if (!fft->static_tables) {
+        dsp_free(NULL, (void*)fft->twiddle_factors);
+        dsp_free(NULL, (void*)fft->radix4_twiddles);
+        dsp_free(NULL, fft->temp_buffer);
+        dsp_free(NULL, (void*)fft->bit_reverse_table);
     }
+    fft->twiddle_factors = NULL;
+    fft->radix4_twiddles = NULL;
+    fft->temp_buffer = NULL;
+    fft->bit_reverse_table = NULL;
+    fft->static_tables = 0;
 }
@@ -0,0 +1,117 @@
+//=============================================================================
+// FFT Interface for RISC-V DSP Processor
+// Optimized for hardware MAC unit and bit-reverse addressing
+//=============================================================================
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <string.h>
+#include "dsp_arena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest FFT handled by the plan cache (2^14 points)
+#define FFT_MAX_LOG2_SIZE 14
+
+// fft_real result when the half-size plan cannot be built
+#define FFT_NO_PLAN INT16_MIN
+
+// Complex number structure
+typedef struct {
+    int16_t real;
+    int16_t imag;
+} complex_t;
+
+// A complex_t as one SIMD operand (real in the low halfword, imag in the high)
+static inline int32_t pack_complex(complex_t x) {
+    int32_t packed;
+    memcpy(&packed, &x, sizeof(packed));
+    return packed;
+}
+
+// Swap the halfwords of a packed complex_t: (imag, real)
+static inline int32_t swap_complex(int32_t packed) {
+    return (int32_t)(((uint32_t)packed << 16) | ((uint32_t)packed >> 16));
+}
+
+// FFT structure
+typedef struct {
+    const complex_t *twiddle_factors;  // Twiddle factors, contiguous per stage
+    const complex_t *radix4_twiddles;  // (W^k, W^2k, W^3k) triples per radix-4 stage
+    complex_t *temp_buffer;      // Temporary buffer
+    const int16_t *bit_reverse_table;  // Bit-reversal permutation
+    int16_t fft_size;           // FFT size (power of 2)
+    int16_t log2_size;          // Log2 of FFT size
+    int16_t static_tables;      // Tables and buffer not owned by the plan (static or arena)
+} fft_t;
+
+// Plan setup; all allocation and trig calls happen here. fft_init_arena
+// takes fft_workspace_size(size) bytes and returns 0 if they do not fit.
+#if !defined(DSP_NO_MALLOC)
+void fft_init(fft_t *fft, int16_t size);
+#endif
+int16_t fft_init_arena(fft_t *fft, int16_t size, arena_t *arena);
+uint32_t fft_workspace_size(int16_t size);
+void fft_cleanup(fft_t *fft);
+
+// Plan over tables built elsewhere, e.g. the compile-time tables of
+// dsp_tables.hpp (same layout and values as fft_init). Nothing is allocated
+// or computed; temp_buffer holds size entries. fft_cleanup leaves them alone.
+void fft_init_static(fft_t *fft, int16_t size, const complex_t *twiddles, const complex_t *radix4_twiddles,
+                     const int16_t *bit_reverse_table, complex_t *temp_buffer);
+
+// Plan cache: one plan per size, created on first use together with the
+// smaller sizes fft_real needs. Returns NULL if they cannot all be built (no
+// room in the cache arena, or no arena at all in a DSP_NO_MALLOC build).
+fft_t *fft_plan_get(int16_t size);
+void fft_plan_cache_clear(void);
+
+// Build the plans created from now on in 'arena' (NULL: the heap). Size it
+// with fft_workspace_size for each plan and its half-size companion.
+void fft_plan_cache_arena(arena_t *arena);
+
+// Put a plan (typically static) in the cache for its size, so fft_plan_get
+// returns it without building one. fft_real also needs the half-size plan.
+// Returns 0 if the size already has a plan.
+int16_t fft_plan_install(const fft_t *plan);
+
+// Transforms
+int16_t bit_reverse(int16_t x, int16_t log2_size);
+void fft_radix2(fft_t *fft, complex_t *input, complex_t *output);
+void ifft_radix2(fft_t *fft, complex_t *input, complex_t *output);
+int16_t fft_real(fft_t *fft, int16_t *input, complex_t *output);  // FFT_NO_PLAN on failure
+void ifft_real(fft_t *fft, complex_t *input, int16_t *output);
+
+// Radix-4 FFT (radix-2 first stage for odd log2 sizes) with block floating
+// point scaling. Returns the block exponent: output * 2^exponent is the DFT.
+int16_t fft_radix4(fft_t *fft, complex_t *input, complex_t *output);
+
+// Inverse of fft_radix4, including the 1/N. Returns the block exponent.
+int16_t ifft_radix4(fft_t *fft, complex_t *input, complex_t *output);
+
+// Spectrum and filtering
+void fft_power_spectrum(fft_t *fft, complex_t *fft_output, int16_t exponent, int16_t *power_spectrum);
+#if !defined(DSP_NO_MALLOC)
+void fft_filter(fft_t *fft, int16_t *input, int16_t *filter_response, int16_t *output);
+#endif
+
+// fft_filter with its spectrum buffer (fft_filter_workspace_size) taken from
+// the arena and returned before it exits; 0 if the arena is too small or
+// fft_real has no half-size plan
+int16_t fft_filter_arena(fft_t *fft, int16_t *input, int16_t *filter_response, int16_t *output, arena_t *arena);
+uint32_t fft_filter_workspace_size(int16_t size);
+
+// Complex arithmetic
+complex_t complex_mul(complex_t a, complex_t b);
+complex_t complex_add(complex_t a, complex_t b);
+complex_t complex_sub(complex_t a, complex_t b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FFT_H
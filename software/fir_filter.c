@@ -4,47 +4,62 @@
 //=============================================================================
 
 #include "dsp_math.h"
-
-// FIR filter structure
-typedef struct {
-    int16_t *coeffs;        // Filter coefficients
-    int16_t *delay_line;    // Delay line buffer
-    int16_t tap_count;      // Number of filter taps
-    int16_t index;          // Current delay line index
-} fir_filter_t;
+#include "fir_filter.h"
 
 // Initialize FIR filter
-void fir_init(fir_filter_t *fir, int16_t *coeffs, int16_t *delay_line, int16_t taps) {
+void fir_init(fir_filter_t *fir, const int16_t *coeffs, int16_t *delay_line, int16_t taps) {
     fir->coeffs = coeffs;
     fir->delay_line = delay_line;
     fir->tap_count = taps;
-    fir->index = 0;
+    fir->index = taps - 1;
     
     // Clear delay line
-    for (int i = 0; i < taps; i++) {
+    for (int i = 0; i < FIR_DELAY_LINE_LEN(taps); i++) {
         delay_line[i] = 0;
     }
 }
 
+// Move the most recent (taps - 1) samples back to the start of the delay line
+static void fir_rewind(fir_filter_t *fir) {
+    int16_t taps = fir->tap_count;
+    int16_t *history = &fir->delay_line[fir->index - taps + 1];
+    
+    for (int i = 0; i < taps - 1; i++) {
+        fir->delay_line[i] = history[i];
+    }
+    fir->index = taps - 1;
+}
+
+// Append a sample to the history without computing an output
+void fir_push(fir_filter_t *fir, int16_t input) {
+    if (fir->index == FIR_DELAY_LINE_LEN(fir->tap_count)) {
+        fir_rewind(fir);
+    }
+    
+    fir->delay_line[fir->index] = input;
+    fir->index++;
+}
+
 // FIR filter processing using hardware MAC unit
 int16_t fir_process(fir_filter_t *fir, int16_t input) {
     int32_t acc = 0;
     int16_t output;
     
-    // Store input in delay line
-    fir->delay_line[fir->index] = input;
+    if (fir->index == FIR_DELAY_LINE_LEN(fir->tap_count)) {
+        fir_rewind(fir);
+    }
+    
+    // Store input in delay line; the tap window ends at the new sample
+    int16_t *x = &fir->delay_line[fir->index];
+    x[0] = input;
     
     // Perform MAC operations
     for (int i = 0; i < fir->tap_count; i++) {
-        int16_t coeff = fir->coeffs[i];
-        int16_t sample = fir->delay_line[(fir->index - i + fir->tap_count) % fir->tap_count];
-        
         // Use hardware MAC instruction
-        acc = mac(acc, coeff, sample);
+        acc = mac(acc, fir->coeffs[i], x[-i]);
     }
     
-    // Update delay line index
-    fir->index = (fir->index + 1) % fir->tap_count;
+    fir->index++;
     
     // Apply saturation and rounding
     output = saturate_16(acc);
@@ -52,64 +67,116 @@ int16_t fir_process(fir_filter_t *fir, int16_t input) {
     return output;
 }
 
+// FIR block processing: FIR_BLOCK_OUTPUTS outputs per pass over the coefficients
+void fir_process_block(fir_filter_t *fir, const int16_t *input, int16_t *output, int16_t length) {
+    int16_t taps = fir->tap_count;
+    int n = 0;
+    
+    if (taps >= FIR_BLOCK_OUTPUTS) {
+        for (; n + FIR_BLOCK_OUTPUTS <= length; n += FIR_BLOCK_OUTPUTS) {
+            if (fir->index + FIR_BLOCK_OUTPUTS > FIR_DELAY_LINE_LEN(taps)) {
+                fir_rewind(fir);
+            }
+            
+            // Store the input group; x[j] is the newest sample seen by output n + j
+            int16_t *x = &fir->delay_line[fir->index];
+            x[0] = input[n];
+            x[1] = input[n + 1];
+            x[2] = input[n + 2];
+            x[3] = input[n + 3];
+            
+            // Each coefficient is loaded once and used by all four outputs
+            int32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+            for (int i = 0; i < taps; i++) {
+                int16_t coeff = fir->coeffs[i];
+                acc0 = mac(acc0, coeff, x[-i]);
+                acc1 = mac(acc1, coeff, x[1 - i]);
+                acc2 = mac(acc2, coeff, x[2 - i]);
+                acc3 = mac(acc3, coeff, x[3 - i]);
+            }
+            
+            fir->index += FIR_BLOCK_OUTPUTS;
+            
+            output[n] = saturate_16(acc0);
+            output[n + 1] = saturate_16(acc1);
+            output[n + 2] = saturate_16(acc2);
+            output[n + 3] = saturate_16(acc3);
+        }
+    }
+    
+    // Remaining samples
+    for (; n < length; n++) {
+        output[n] = fir_process(fir, input[n]);
+    }
+}
+
 // FIR filter processing using SIMD operations (4 parallel MACs)
 void fir_process_simd(fir_filter_t *fir, int16_t *input, int16_t *output, int16_t length) {
-    int32_t acc0, acc1, acc2, acc3;
-    int16_t coeffs_simd[4];
+    int16_t taps = fir->tap_count;
     int16_t samples_simd[4];
     
     for (int n = 0; n < length; n++) {
+        if (fir->index == FIR_DELAY_LINE_LEN(taps)) {
+            fir_rewind(fir);
+        }
+        
         // Store input in delay line
-        fir->delay_line[fir->index] = input[n];
+        int16_t *x = &fir->delay_line[fir->index];
+        x[0] = input[n];
         
-        // Initialize accumulators
-        acc0 = acc1 = acc2 = acc3 = 0;
+        int32_t acc = 0;
+        int i = 0;
         
         // Process 4 taps at a time using SIMD
-        for (int i = 0; i < fir->tap_count; i += 4) {
-            // Load coefficients for SIMD
-            coeffs_simd[0] = fir->coeffs[i];
-            coeffs_simd[1] = fir->coeffs[i + 1];
-            coeffs_simd[2] = fir->coeffs[i + 2];
-            coeffs_simd[3] = fir->coeffs[i + 3];
+        for (; i + 4 <= taps; i += 4) {
+            // Load samples for SIMD (coefficients are already contiguous)
+            samples_simd[0] = x[-i];
+            samples_simd[1] = x[-i - 1];
+            samples_simd[2] = x[-i - 2];
+            samples_simd[3] = x[-i - 3];
             
-            // Load samples for SIMD
-            samples_simd[0] = fir->delay_line[(fir->index - i + fir->tap_count) % fir->tap_count];
-            samples_simd[1] = fir->delay_line[(fir->index - i - 1 + fir->tap_count) % fir->tap_count];
-            samples_simd[2] = fir->delay_line[(fir->index - i - 2 + fir->tap_count) % fir->tap_count];
-            samples_simd[3] = fir->delay_line[(fir->index - i - 3 + fir->tap_count) % fir->tap_count];
-            
-            // SIMD MAC operation
-            int32_t simd_result = simd_mac4(coeffs_simd, samples_simd);
-            
-            // Accumulate results
-            acc0 += (simd_result >> 24) & 0xFF;
-            acc1 += (simd_result >> 16) & 0xFF;
-            acc2 += (simd_result >> 8) & 0xFF;
-            acc3 += simd_result & 0xFF;
+            // SIMD MAC operation: sum of the four products
+            acc += simd_mac4(&fir->coeffs[i], samples_simd);
         }
         
-        // Update delay line index
-        fir->index = (fir->index + 1) % fir->tap_count;
+        // Remaining taps
+        for (; i < taps; i++) {
+            acc = mac(acc, fir->coeffs[i], x[-i]);
+        }
+        
+        fir->index++;
         
         // Apply saturation and store output
-        output[n] = saturate_16(acc0);
+        output[n] = saturate_16(acc);
+    }
+}
+
+// Windowed-sinc low-pass coefficient i. Integer-only: the sinc and Hamming
+// terms use sin_16/cos_16 with binary angles. dsp_tables.hpp mirrors this
+// arithmetic at compile time, so keep the two in step.
+static int16_t fir_lowpass_coeff(int16_t i, int16_t taps, int16_t cutoff_freq, int16_t sample_rate) {
+    // Cutoff as a binary angle: omega_c = 2 * pi * cutoff_freq / sample_rate
+    int32_t omega_c = ((int32_t)cutoff_freq << 16) / sample_rate;
+    int32_t n = i - taps / 2;
+    
+    if (n == 0) {
+        // omega_c / pi in Q15
+        return saturate_16((2 * (int32_t)cutoff_freq * 32767) / sample_rate);
     }
+    
+    // sin(omega_c * n) / (pi * n) in Q15; 10430 is 1 / pi in Q15
+    int32_t sinc_val = ((int32_t)sin_16((int16_t)(omega_c * n)) * 10430 / n + 16384) >> 15;
+    
+    // 0.54 - 0.46 * cos(2 * pi * i / (taps - 1)) in Q15
+    int16_t angle = (int16_t)(((int32_t)i << 16) / (taps - 1));
+    int16_t hamming_window = 17695 - (int16_t)((15073 * (int32_t)cos_16(angle) + 16384) >> 15);
+    return (int16_t)((sinc_val * hamming_window + 16384) >> 15);
 }
 
 // Low-pass FIR filter design using windowing method
 void fir_design_lowpass(int16_t *coeffs, int16_t taps, int16_t cutoff_freq, int16_t sample_rate) {
-    float omega_c = 2.0 * M_PI * cutoff_freq / sample_rate;
-    float hamming_window;
-    
     for (int i = 0; i < taps; i++) {
-        if (i == taps / 2) {
-            coeffs[i] = (int16_t)(omega_c / M_PI * 32767);
-        } else {
-            float sinc_val = sin(omega_c * (i - taps / 2)) / (M_PI * (i - taps / 2));
-            hamming_window = 0.54 - 0.46 * cos(2.0 * M_PI * i / (taps - 1));
-            coeffs[i] = (int16_t)(sinc_val * hamming_window * 32767);
-        }
+        coeffs[i] = fir_lowpass_coeff(i, taps, cutoff_freq, sample_rate);
     }
 }
 
@@ -125,24 +192,11 @@ void fir_design_highpass(int16_t *coeffs, int16_t taps, int16_t cutoff_freq, int
     coeffs[taps / 2] += 32767; // Add impulse at center
 }
 
-// Band-pass FIR filter design
+// Band-pass FIR filter design: the difference of the low-passes at the two
+// edges, which is the pass band on the same window and delay
 void fir_design_bandpass(int16_t *coeffs, int16_t taps, int16_t low_freq, int16_t high_freq, int16_t sample_rate) {
-    int16_t *lowpass_coeffs = (int16_t*)malloc(taps * sizeof(int16_t));
-    int16_t *highpass_coeffs = (int16_t*)malloc(taps * sizeof(int16_t));
-    
-    // Design low-pass and high-pass filters
-    fir_design_lowpass(lowpass_coeffs, taps, high_freq, sample_rate);
-    fir_design_highpass(highpass_coeffs, taps, low_freq, sample_rate);
-    
-    // Convolve the two filters
     for (int i = 0; i < taps; i++) {
-        coeffs[i] = 0;
-        for (int j = 0; j <= i; j++) {
-            coeffs[i] += lowpass_coeffs[j] * highpass_coeffs[i - j];
-        }
-        coeffs[i] >>= 15; // Scale down
+        coeffs[i] = saturate_16((int32_t)fir_lowpass_coeff(i, taps, high_freq, sample_rate)
+                                - fir_lowpass_coeff(i, taps, low_freq, sample_rate));
     }
-    
-    free(lowpass_coeffs);
-    free(highpass_coeffs);
 }
@@ -0,0 +1,56 @@
+//=============================================================================
+// FIR Filter Interface for RISC-V DSP Processor
+// Optimized for hardware MAC unit and SIMD operations
+//=============================================================================
+
+#ifndef FIR_FILTER_H
+#define FIR_FILTER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Delay line length required by fir_init. The history is kept linear in a
+// double-length buffer so the tap loops never wrap; it is slid back to the
+// start once every tap_count samples.
+#define FIR_DELAY_LINE_LEN(taps) (2 * (taps))
+
+// Number of outputs computed per pass over the coefficients
+#define FIR_BLOCK_OUTPUTS 4
+
+// FIR filter structure
+typedef struct {
+    const int16_t *coeffs;  // Filter coefficients
+    int16_t *delay_line;    // Delay line buffer (FIR_DELAY_LINE_LEN(taps))
+    int16_t tap_count;      // Number of filter taps
+    int16_t index;          // Next write position in the delay line
+} fir_filter_t;
+
+// Initialize FIR filter
+void fir_init(fir_filter_t *fir, const int16_t *coeffs, int16_t *delay_line, int16_t taps);
+
+// Single sample processing using MAC
+int16_t fir_process(fir_filter_t *fir, int16_t input);
+
+// Append a sample to the history without computing an output; the newest
+// sample is then at delay_line[index - 1]
+void fir_push(fir_filter_t *fir, int16_t input);
+
+// Block processing, bit-exact with fir_process applied sample by sample
+void fir_process_block(fir_filter_t *fir, const int16_t *input, int16_t *output, int16_t length);
+
+// Block processing using SIMD (4 taps per instruction)
+void fir_process_simd(fir_filter_t *fir, int16_t *input, int16_t *output, int16_t length);
+
+// Filter design
+void fir_design_lowpass(int16_t *coeffs, int16_t taps, int16_t cutoff_freq, int16_t sample_rate);
+void fir_design_highpass(int16_t *coeffs, int16_t taps, int16_t cutoff_freq, int16_t sample_rate);
+void fir_design_bandpass(int16_t *coeffs, int16_t taps, int16_t low_freq, int16_t high_freq, int16_t sample_rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIR_FILTER_H
@@ -0,0 +1,337 @@
+//=============================================================================
+// IIR Filter Implementation for RISC-V DSP Processor
+// Fixed-point biquad cascades (transposed direct form II)
+//=============================================================================
+
+#include "dsp_math.h"
+#include "iir_filter.h"
+
+// Section output: acc (Q29) rounded to Q15 with saturation. The shift is
+// split so the rounding term cannot overflow.
+static inline int16_t iir_round(int32_t acc) {
+    return saturate_16(((acc >> 13) + 1) >> 1);
+}
+
+// Wrapping 32-bit addition, as the MAC unit accumulates
+static inline int32_t iir_add(int32_t a, int32_t b) {
+    return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+// Initialize IIR cascade
+void iir_init(iir_filter_t *iir, const int16_t *coeffs, int32_t *state, int16_t sections) {
+    iir->coeffs = coeffs;
+    iir->state = state;
+    iir->section_count = sections;
+    iir_reset(iir);
+}
+
+void iir_reset(iir_filter_t *iir) {
+    for (int i = 0; i < IIR_STATE_LEN(iir->section_count); i++) {
+        iir->state[i] = 0;
+    }
+}
+
+// Single sample processing:
+//   y  = b0 * x + s1
+//   s1 = b1 * x - a1 * y + s2
+//   s2 = b2 * x - a2 * y
+int16_t iir_process(iir_filter_t *iir, int16_t input) {
+    int16_t x = input;
+
+    for (int s = 0; s < iir->section_count; s++) {
+        const int16_t *h = &iir->coeffs[s * IIR_COEFFS_PER_SECTION];
+        int32_t *st = &iir->state[2 * s];
+
+        int16_t y = iir_round(mac(st[0], h[0], x));
+        st[0] = mac(mac(st[1], h[1], x), h[3], y);
+        st[1] = mac(mac(0, h[2], x), h[4], y);
+        x = y;
+    }
+    return x;
+}
+
+// Block processing: each section runs over the whole block with its
+// coefficients and state in registers, writing in place into output
+void iir_process_block(iir_filter_t *iir, const int16_t *input, int16_t *output, int16_t length) {
+    const int16_t *x = input;
+
+    for (int s = 0; s < iir->section_count; s++) {
+        const int16_t *h = &iir->coeffs[s * IIR_COEFFS_PER_SECTION];
+        int16_t b0 = h[0], b1 = h[1], b2 = h[2], na1 = h[3], na2 = h[4];
+        int32_t s1 = iir->state[2 * s];
+        int32_t s2 = iir->state[2 * s + 1];
+
+        for (int n = 0; n < length; n++) {
+            int16_t in = x[n];
+            int16_t y = iir_round(mac(s1, b0, in));
+            s1 = mac(mac(s2, b1, in), na1, y);
+            s2 = mac(mac(0, b2, in), na2, y);
+            output[n] = y;
+        }
+
+        iir->state[2 * s] = s1;
+        iir->state[2 * s + 1] = s2;
+        x = output;
+    }
+}
+
+// Block processing using the dual MAC: (x, y) is packed once per sample
+// and dotted with (b1, -a1) and (b2, -a2)
+void iir_process_simd(iir_filter_t *iir, const int16_t *input, int16_t *output, int16_t length) {
+    const int16_t *x = input;
+
+    for (int s = 0; s < iir->section_count; s++) {
+        const int16_t *h = &iir->coeffs[s * IIR_COEFFS_PER_SECTION];
+        int16_t b0 = h[0];
+        int32_t h1 = pack_16x2(h[1], h[3]);
+        int32_t h2 = pack_16x2(h[2], h[4]);
+        int32_t s1 = iir->state[2 * s];
+        int32_t s2 = iir->state[2 * s + 1];
+
+        for (int n = 0; n < length; n++) {
+            int16_t in = x[n];
+            int16_t y = iir_round(mac(s1, b0, in));
+            int32_t xy = pack_16x2(in, y);
+            s1 = iir_add(s2, simd_dot2(h1, xy));
+            s2 = simd_dot2(h2, xy);
+            output[n] = y;
+        }
+
+        iir->state[2 * s] = s1;
+        iir->state[2 * s + 1] = s2;
+        x = output;
+    }
+}
+
+// Initialize IIR bank
+void iir_bank_init(iir_bank_t *bank, const int16_t *coeffs, int32_t *state, int16_t sections,
+                   int16_t channels) {
+    bank->coeffs = coeffs;
+    bank->state = state;
+    bank->section_count = sections;
+    bank->channel_count = channels;
+
+    for (int i = 0; i < IIR_BANK_STATE_LEN(sections, channels); i++) {
+        state[i] = 0;
+    }
+}
+
+#if defined(DSP_BACKEND_X86)
+// Four channels of one section step. pmaddwd gives the dual-MAC dot
+// products; its wrapped corner case is stepped back to 0x7fffffff as
+// simd_dot2 saturates.
+static inline __m128i iir_dot2_x4(__m128i xy, __m128i h) {
+    __m128i dots = _mm_madd_epi16(xy, h);
+    return _mm_add_epi32(dots, _mm_cmpeq_epi32(dots, _mm_set1_epi32(INT32_MIN)));
+}
+#endif
+
+// Bank processing: sections outer, frames inner, channels across lanes
+void iir_bank_process(iir_bank_t *bank, const int16_t *input, int16_t *output, int16_t frames) {
+    int16_t channels = bank->channel_count;
+    int32_t samples = (int32_t)frames * channels;
+
+    if (output != input) {
+        for (int32_t i = 0; i < samples; i++) {
+            output[i] = input[i];
+        }
+    }
+
+    for (int s = 0; s < bank->section_count; s++) {
+        const int16_t *h = &bank->coeffs[s * IIR_COEFFS_PER_SECTION];
+        int16_t b0 = h[0];
+        int32_t h1 = pack_16x2(h[1], h[3]);
+        int32_t h2 = pack_16x2(h[2], h[4]);
+        int32_t *s1 = &bank->state[(2 * s) * channels];
+        int32_t *s2 = &bank->state[(2 * s + 1) * channels];
+
+        for (int n = 0; n < frames; n++) {
+            int16_t *frame = &output[n * channels];
+            int c = 0;
+#if defined(DSP_BACKEND_X86)
+            __m128i vb0 = _mm_set1_epi32(pack_16x2(b0, 0));
+            __m128i vh1 = _mm_set1_epi32(h1);
+            __m128i vh2 = _mm_set1_epi32(h2);
+            for (; c + 4 <= channels; c += 4) {
+                __m128i x = _mm_loadl_epi64((const __m128i *)&frame[c]);
+                __m128i acc = _mm_add_epi32(_mm_loadu_si128((const __m128i *)&s1[c]),
+                                            _mm_madd_epi16(_mm_unpacklo_epi16(x, _mm_setzero_si128()), vb0));
+                __m128i y = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(acc, 13), _mm_set1_epi32(1)), 1);
+                y = _mm_packs_epi32(y, y);
+                __m128i xy = _mm_unpacklo_epi16(x, y);
+                _mm_storeu_si128((__m128i *)&s1[c], _mm_add_epi32(_mm_loadu_si128((const __m128i *)&s2[c]),
+                                                                 iir_dot2_x4(xy, vh1)));
+                _mm_storeu_si128((__m128i *)&s2[c], iir_dot2_x4(xy, vh2));
+                _mm_storel_epi64((__m128i *)&frame[c], y);
+            }
+#endif
+            for (; c < channels; c++) {
+                int16_t in = frame[c];
+                int16_t y = iir_round(mac(s1[c], b0, in));
+                int32_t xy = pack_16x2(in, y);
+                s1[c] = iir_add(s2[c], simd_dot2(h1, xy));
+                s2[c] = simd_dot2(h2, xy);
+                frame[c] = y;
+            }
+        }
+    }
+}
+
+//=============================================================================
+// Design
+//=============================================================================
+
+// Clamp a Q14 coefficient. -32768 is avoided so no coefficient can hit the
+// dual MAC's saturating corner.
+static int16_t iir_coeff(int64_t q) {
+    if (q > 32767) return 32767;
+    if (q < -32767) return -32767;
+    return (int16_t)q;
+}
+
+// Q30 to a Q14 coefficient, rounded
+static int16_t iir_q14(int64_t value) {
+    return iir_coeff((value + ((int64_t)1 << 15)) >> 16);
+}
+
+// a * b in Q30, with b split so the products stay within 64 bits for the
+// large K of cutoffs near Nyquist
+static int64_t iir_mul30(int64_t a, int64_t b) {
+    return ((a * (b >> 15)) >> 15) + ((a * (b & 0x7FFF)) >> 30);
+}
+
+// num / den in Q30. Both are scaled down together until num << 30 fits.
+static int64_t iir_div30(int64_t num, int64_t den) {
+    while (num >= ((int64_t)1 << 32) || num <= -((int64_t)1 << 32)) {
+        num >>= 1;
+        den >>= 1;
+    }
+    return (num * ((int64_t)1 << 30) + den / 2) / den;
+}
+
+// Numerator from the quantized denominator so the passband gain is exact:
+// sum holds the denominator's gain at z = 1 (low-pass) or z = -1 (high-pass)
+// in Q14 and gain is a Q15 scale (32768 = unity). Second-order numerators
+// are (1 +/- z^-1)^2, first-order ones 1 +/- z^-1.
+static void iir_numerator(int16_t *h, int32_t sum, int32_t gain, int16_t highpass, int16_t first_order) {
+    int32_t total = (int32_t)(((int64_t)sum * gain + 16384) >> 15);
+    int32_t sign = highpass ? -1 : 1;
+
+    if (first_order) {
+        h[0] = iir_coeff((total + 1) >> 1);
+        h[1] = iir_coeff(sign * (total - h[0]));
+        h[2] = 0;
+    } else {
+        h[0] = iir_coeff((total + 2) >> 2);
+        h[1] = iir_coeff(sign * (total - 2 * h[0]));
+        h[2] = h[0];
+    }
+}
+
+// Bilinear transform of an analog prototype normalized to a cutoff of
+// 1 rad/s. Pole pairs are at -sinh(v) sin(t) +/- j cosh(v) cos(t),
+// t = pi (2k + 1) / (2N), plus a real pole at -sinh(v) for odd N;
+// Butterworth is sinh(v) = cosh(v) = 1. With K = tan(pi fc / fs) a pair
+// becomes
+//   low-pass:  den = (1 + BK + AK^2) + 2(AK^2 - 1) z^-1 + (1 - BK + AK^2) z^-2
+//   high-pass: den = (A + BK + K^2) + 2(K^2 - A) z^-1 + (A - BK + K^2) z^-2
+// for A = |p|^2, B = -2 Re(p). Sections run from the lowest Q to the
+// highest, with the prototype gain on the first.
+static int16_t iir_design(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                          int16_t highpass, int64_t sinh_v, int64_t cosh_v, int32_t gain) {
+    const int64_t one = (int64_t)1 << 30;
+
+    if (order < 1) order = 1;
+    if (order > 16) order = 16;
+
+    int16_t angle = (int16_t)(((int32_t)cutoff_freq << 15) / sample_rate);
+    int64_t k = ((int64_t)sin_16(angle) << 30) / cos_16(angle);
+    int16_t *h = coeffs;
+
+    if (order & 1) {
+        int64_t sk = iir_mul30(sinh_v, k);
+        int64_t a1 = highpass ? iir_div30(k - sinh_v, k + sinh_v) : iir_div30(sk - one, sk + one);
+        h[3] = iir_q14(-a1);
+        h[4] = 0;
+        iir_numerator(h, highpass ? 16384 + h[3] : 16384 - h[3], gain, highpass, 1);
+        gain = 32768;
+        h += IIR_COEFFS_PER_SECTION;
+    }
+
+    for (int p = order / 2 - 1; p >= 0; p--) {
+        int16_t t = (int16_t)((16384 * (2 * p + 1)) / order);
+        int64_t sigma = (sinh_v * sin_16(t)) >> 15;
+        int64_t omega = (cosh_v * cos_16(t)) >> 15;
+        int64_t a = iir_mul30(sigma, sigma) + iir_mul30(omega, omega);
+        int64_t bk = iir_mul30(2 * sigma, k);
+        int64_t kk = iir_mul30(k, k);
+        int64_t a1, a2;
+
+        if (highpass) {
+            int64_t den = a + bk + kk;
+            a1 = iir_div30(2 * (kk - a), den);
+            a2 = iir_div30(a - bk + kk, den);
+        } else {
+            int64_t akk = iir_mul30(a, kk);
+            int64_t den = one + bk + akk;
+            a1 = iir_div30(2 * (akk - one), den);
+            a2 = iir_div30(one - bk + akk, den);
+        }
+        h[3] = iir_q14(-a1);
+        h[4] = iir_q14(-a2);
+        iir_numerator(h, highpass ? 16384 + h[3] - h[4] : 16384 - h[3] - h[4], gain, highpass, 0);
+        gain = 32768;
+        h += IIR_COEFFS_PER_SECTION;
+    }
+
+    return IIR_SECTIONS(order);
+}
+
+int16_t iir_design_butterworth_lowpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate) {
+    return iir_design(coeffs, order, cutoff_freq, sample_rate, 0, (int64_t)1 << 30, (int64_t)1 << 30, 32768);
+}
+
+int16_t iir_design_butterworth_highpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate) {
+    return iir_design(coeffs, order, cutoff_freq, sample_rate, 1, (int64_t)1 << 30, (int64_t)1 << 30, 32768);
+}
+
+// Chebyshev prototype from the ripple. With u = 10^(-ripple / 10) = 1 / (1 + eps^2),
+// e^(N v) = (1 + sqrt(1 + eps^2)) / eps = (1 + sqrt(u)) / sqrt(1 - u), and even
+// orders are scaled by sqrt(u) so the ripple peaks at 0 dB.
+static int16_t iir_design_chebyshev(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                                    int16_t ripple_db, int16_t highpass) {
+    if (ripple_db < 1) ripple_db = 1;
+    if (order < 1) order = 1;
+    if (order > 16) order = 16;
+
+    // ripple / 10 * log2(10) in Q16; 21771 is log2(10) / 10 in Q16
+    int32_t x = ((int32_t)ripple_db * 21771) >> 8;
+    int32_t u = exp2_q15(-x);
+    int32_t root_u = sqrt_16((int16_t)u);
+    int32_t rest = 32768 - u;
+    int32_t root_rest = sqrt_16((int16_t)(rest > 32767 ? 32767 : rest));
+    if (root_rest < 1) root_rest = 1;
+
+    // e^-v = ((1 + sqrt(u)) / sqrt(1 - u))^(-1 / N)
+    uint32_t growth = ((uint32_t)(32768 + root_u) << 16) / (uint32_t)root_rest;
+    int32_t log_growth = log2_q16(growth) - (16 << 16);
+    int64_t w = exp2_q15(-log_growth / order);
+    if (w < 1) w = 1;
+
+    int64_t inv_w = ((int64_t)1 << 45) / w;
+    int64_t sinh_v = (inv_w - (w << 15)) / 2;
+    int64_t cosh_v = (inv_w + (w << 15)) / 2;
+    int32_t gain = (order & 1) ? 32768 : root_u;
+
+    return iir_design(coeffs, order, cutoff_freq, sample_rate, highpass, sinh_v, cosh_v, gain);
+}
+
+int16_t iir_design_chebyshev_lowpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                                     int16_t ripple_db) {
+    return iir_design_chebyshev(coeffs, order, cutoff_freq, sample_rate, ripple_db, 0);
+}
+
+int16_t iir_design_chebyshev_highpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                                      int16_t ripple_db) {
+    return iir_design_chebyshev(coeffs, order, cutoff_freq, sample_rate, ripple_db, 1);
+}
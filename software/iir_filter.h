@@ -0,0 +1,88 @@
+//=============================================================================
+// IIR Filter Interface for RISC-V DSP Processor
+// Fixed-point biquad cascades (transposed direct form II)
+//=============================================================================
+
+#ifndef IIR_FILTER_H
+#define IIR_FILTER_H
+
+#include <stdint.h>
+
+// Second-order sections for a filter of the given order (odd orders end in
+// a first-order section with b2 = a2 = 0)
+#define IIR_SECTIONS(order) (((order) + 1) / 2)
+
+// Storage required by iir_init and iir_bank_init
+#define IIR_COEFFS_PER_SECTION 5
+#define IIR_COEFFS_LEN(sections) (IIR_COEFFS_PER_SECTION * (sections))
+#define IIR_STATE_LEN(sections) (2 * (sections))
+#define IIR_BANK_STATE_LEN(sections, channels) (IIR_STATE_LEN(sections) * (channels))
+
+// Coefficients are Q14 (-2.0 to 2.0), stored per section as
+// b0, b1, b2, -a1, -a2 for
+//   H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+// The state holds the full 32-bit products (Q29 for Q15 samples); each
+// section rounds its output to 16 bits with saturation before feeding it
+// back and on to the next section. Intermediate sums wrap like mac().
+
+// IIR cascade structure
+typedef struct {
+    const int16_t *coeffs;      // IIR_COEFFS_LEN(sections) coefficients
+    int32_t *state;             // s1, s2 per section (IIR_STATE_LEN)
+    int16_t section_count;      // Number of second-order sections
+} iir_filter_t;
+
+// Initialize IIR cascade and clear the state
+void iir_init(iir_filter_t *iir, const int16_t *coeffs, int32_t *state, int16_t sections);
+
+// Clear the state, keeping the coefficients
+void iir_reset(iir_filter_t *iir);
+
+// Single sample processing using MAC
+int16_t iir_process(iir_filter_t *iir, int16_t input);
+
+// Block processing, one section at a time over the block; bit-exact with
+// iir_process applied sample by sample. output may alias input.
+void iir_process_block(iir_filter_t *iir, const int16_t *input, int16_t *output, int16_t length);
+
+// Block processing using the dual MAC: the four feedforward/feedback
+// products per sample are two simd_dot2 operations. Bit-exact with
+// iir_process_block unless a coefficient pair and its samples are all
+// -32768, where the dual MAC saturates. output may alias input.
+void iir_process_simd(iir_filter_t *iir, const int16_t *input, int16_t *output, int16_t length);
+
+// IIR bank structure. All channels share the coefficients; the state is
+// channel-interleaved (state word j of channel c at j * channel_count + c),
+// so each section step runs across channels in SIMD lanes.
+typedef struct {
+    const int16_t *coeffs;      // Shared cascade coefficients
+    int32_t *state;             // Interleaved state (IIR_BANK_STATE_LEN)
+    int16_t section_count;      // Number of second-order sections
+    int16_t channel_count;      // Number of channels
+} iir_bank_t;
+
+// Initialize IIR bank and clear the state
+void iir_bank_init(iir_bank_t *bank, const int16_t *coeffs, int32_t *state, int16_t sections,
+                   int16_t channels);
+
+// Filter 'frames' interleaved frames (input[n * channels + c]). Each channel
+// is bit-exact with iir_process_simd. output may alias input.
+void iir_bank_process(iir_bank_t *bank, const int16_t *input, int16_t *output, int16_t frames);
+
+// Filter design by bilinear transform with the cutoff prewarped. Coefficients
+// are written for IIR_SECTIONS(order) sections (order 1 to 16) and the number
+// of sections is returned. Passband gain is exact at DC (low-pass) or
+// Nyquist (high-pass) after quantization. Poles very close to z = 1, i.e.
+// cutoffs well below sample_rate / 100 at high orders, lose accuracy in Q14.
+int16_t iir_design_butterworth_lowpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate);
+int16_t iir_design_butterworth_highpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate);
+
+// Chebyshev type I: equiripple passband of ripple_db (Q8, 0.5 dB = 128)
+// ending at the cutoff. Even orders peak at 0 dB, so the DC (Nyquist) gain
+// is -ripple_db.
+int16_t iir_design_chebyshev_lowpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                                     int16_t ripple_db);
+int16_t iir_design_chebyshev_highpass(int16_t *coeffs, int16_t order, int16_t cutoff_freq, int16_t sample_rate,
+                                      int16_t ripple_db);
+
+#endif // IIR_FILTER_H
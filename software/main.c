@@ -5,41 +5,97 @@
 
 #include "dsp_math.h"
 #include "fir_filter.h"
+#include "iir_filter.h"
 #include "fft.h"
+#include "stream.h"
+#include "dsp_arena.h"
+#include "rom_tables.h"
 #include <stdio.h>
+#include <stdlib.h>
 
-#define FFT_SIZE 256
-#define FIR_TAPS 64
+#define FFT_SIZE ROM_FFT_SIZE
+#define FIR_TAPS ROM_LOWPASS_TAPS
+#define IIR_ORDER 4
 #define BUFFER_SIZE 1024
+#define STREAM_RING_SIZE 1024
+#define DMA_BLOCK 64
+#define STREAM_TONES 3
+#define WORKSPACE_SIZE 8192
+
+// Interrupt entry points; host builds call them as plain functions
+#if defined(__riscv)
+#define DSP_ISR __attribute__((interrupt))
+#else
+#define DSP_ISR
+#endif
 
 // Global variables
 int16_t input_buffer[BUFFER_SIZE];
 int16_t output_buffer[BUFFER_SIZE];
-int16_t fir_coeffs[FIR_TAPS];
-int16_t fir_delay_line[FIR_TAPS];
+int16_t fir_delay_line[FIR_DELAY_LINE_LEN(FIR_TAPS)] DSP_YMEM;
+int16_t iir_coeffs[IIR_COEFFS_LEN(IIR_SECTIONS(IIR_ORDER))];
+int32_t iir_state[IIR_STATE_LEN(IIR_SECTIONS(IIR_ORDER))];
+int16_t iir_output[BUFFER_SIZE];
 complex_t fft_output[FFT_SIZE];
 int16_t power_spectrum[FFT_SIZE/2];
 
+// Real-time streaming state: the ISRs only touch the rings
+fir_filter_t stream_fir;
+int16_t stream_delay_line[FIR_DELAY_LINE_LEN(FIR_TAPS)] DSP_YMEM;
+stream_pipeline_t dsp_stream;
+const int16_t stream_tone_bins[STREAM_TONES] = {
+    500 * FFT_SIZE / 10000,     // 500Hz component
+    1500 * FFT_SIZE / 10000,    // 1.5kHz component
+    3000 * FFT_SIZE / 10000     // 3kHz component
+};
+int16_t dma_rx_buffer[2 * DMA_BLOCK] DSP_YMEM;
+int16_t dma_tx_buffer[2 * DMA_BLOCK] DSP_YMEM;
+volatile int16_t report_due = 0;
+
+// Every run-time buffer the library needs comes from this one block
+uint8_t dsp_workspace[WORKSPACE_SIZE];
+arena_t dsp_arena;
+
 // Function prototypes
 void generate_test_signal(int16_t *signal, int16_t length);
 void process_fir_filter(int16_t *input, int16_t *output, int16_t length);
+void process_iir_filter(int16_t *input, int16_t *output, int16_t length);
 void process_fft(int16_t *input, int16_t length);
 void display_results(int16_t *input, int16_t *output, int16_t length);
+void dsp_background_task(void);
 
 int main() {
     printf("RISC-V DSP Processor Test Application\n");
     printf("=====================================\n\n");
     
-    // Initialize FIR filter
-    fir_filter_t fir_filter;
-    fir_init(&fir_filter, fir_coeffs, fir_delay_line, FIR_TAPS);
+    // The low-pass FIR (1kHz cutoff, 10kHz sample rate) and the FFT plan
+    // tables are built at compile time (rom_tables.cpp); installing the plan
+    // up front means the ISRs only ever hit the cache
+    rom_fft_install();
+    
+    // Anything else allocated at startup, including plans for other sizes,
+    // comes from the static workspace rather than the heap
+    arena_init(&dsp_arena, dsp_workspace, sizeof(dsp_workspace));
+    fft_plan_cache_arena(&dsp_arena);
+    
+    // Streaming pipeline: FFT_SIZE-sample blocks, FIR then spectrum
+    fir_init(&stream_fir, rom_lowpass_coeffs, stream_delay_line, FIR_TAPS);
+    if (!stream_init_arena(&dsp_stream, &stream_fir, fft_plan_get(FFT_SIZE), FFT_SIZE, STREAM_RING_SIZE,
+                           &dsp_arena)) {
+        printf("Workspace too small: %lu bytes needed\n",
+               (unsigned long)stream_workspace_size(FFT_SIZE, STREAM_RING_SIZE, 1, STREAM_TONES));
+        return 1;
+    }
     
-    // Design low-pass FIR filter (cutoff at 0.1 * fs)
-    fir_design_lowpass(fir_coeffs, FIR_TAPS, 1000, 10000); // 1kHz cutoff, 10kHz sample rate
+    // Only the test tones are monitored, so a Goertzel bank can replace the FFT
+    if (stream_watch_bins(&dsp_stream, stream_tone_bins, STREAM_TONES)) {
+        printf("Stream spectrum: Goertzel bank, %ld MACs/block vs %ld for the FFT\n",
+               (long)tone_bank_cost(TONE_GOERTZEL, STREAM_TONES, FFT_SIZE, 0), (long)tone_fft_cost(FFT_SIZE));
+    }
     
-    // Initialize FFT
-    fft_t fft;
-    fft_init(&fft, FFT_SIZE);
+    // The DMA controller moves the ADC and DAC samples; dma_isr sees blocks
+    dma_setup(dma_rx_buffer, dma_tx_buffer, DMA_BLOCK);
+    dma_start(DMA_RX_ENABLE | DMA_TX_ENABLE | DMA_RX_IRQ | DMA_TX_IRQ);
     
     printf("Generated test signal with multiple frequency components...\n");
     generate_test_signal(input_buffer, BUFFER_SIZE);
@@ -47,6 +103,9 @@ int main() {
     printf("Processing signal through FIR low-pass filter...\n");
     process_fir_filter(input_buffer, output_buffer, BUFFER_SIZE);
     
+    printf("Processing signal through IIR low-pass filter...\n");
+    process_iir_filter(input_buffer, iir_output, BUFFER_SIZE);
+    
     printf("Performing FFT analysis...\n");
     process_fft(output_buffer, FFT_SIZE);
     
@@ -54,7 +113,12 @@ int main() {
     display_results(input_buffer, output_buffer, BUFFER_SIZE);
     
     // Cleanup
-    fft_cleanup(&fft);
+    dma_stop(DMA_RX_ENABLE | DMA_TX_ENABLE);
+    stream_cleanup(&dsp_stream);
+    fft_plan_cache_clear();
+    
+    printf("\nWorkspace: %lu of %lu bytes, peak %lu\n", (unsigned long)dsp_arena.used,
+           (unsigned long)dsp_arena.capacity, (unsigned long)dsp_arena.peak);
     
     printf("\nDSP processing completed successfully!\n");
     return 0;
@@ -62,49 +126,67 @@ int main() {
 
 // Generate test signal with multiple frequency components
 void generate_test_signal(int16_t *signal, int16_t length) {
+    // Phase steps as binary angles per sample at the 10kHz sample rate
+    const int16_t step[4] = {
+        (int16_t)(500L * 65536 / 10000),    // 500Hz component
+        (int16_t)(1500L * 65536 / 10000),   // 1.5kHz component
+        (int16_t)(3000L * 65536 / 10000),   // 3kHz component
+        (int16_t)(5000L * 65536 / 10000)    // 5kHz component
+    };
+    const int16_t amplitude[4] = { 16384, 9830, 6554, 3277 };  // 0.5, 0.3, 0.2, 0.1 in Q15
+    uint16_t phase[4] = { 0, 0, 0, 0 };
+    
     for (int i = 0; i < length; i++) {
-        float t = (float)i / 10000.0; // 10kHz sample rate
-        float signal_val = 0;
+        int32_t signal_val = 0;
         
         // Add multiple frequency components
-        signal_val += 0.5 * sin(2 * M_PI * 500 * t);   // 500Hz component
-        signal_val += 0.3 * sin(2 * M_PI * 1500 * t);  // 1.5kHz component
-        signal_val += 0.2 * sin(2 * M_PI * 3000 * t);  // 3kHz component
-        signal_val += 0.1 * sin(2 * M_PI * 5000 * t);  // 5kHz component
+        for (int k = 0; k < 4; k++) {
+            signal_val = mac(signal_val, amplitude[k], sin_16((int16_t)phase[k]));
+            phase[k] += (uint16_t)step[k];
+        }
+        signal_val >>= 15;
         
-        // Add noise
-        signal_val += 0.05 * ((float)rand() / RAND_MAX - 0.5);
+        // Add noise (+/-0.025 full scale)
+        signal_val += rand() % 1639 - 819;
         
-        // Convert to 16-bit fixed point
-        signal[i] = (int16_t)(signal_val * 32767);
+        signal[i] = saturate_16(signal_val);
     }
 }
 
 // Process signal through FIR filter
 void process_fir_filter(int16_t *input, int16_t *output, int16_t length) {
     fir_filter_t fir_filter;
-    fir_init(&fir_filter, fir_coeffs, fir_delay_line, FIR_TAPS);
+    fir_init(&fir_filter, rom_lowpass_coeffs, fir_delay_line, FIR_TAPS);
     
-    // Process signal sample by sample
-    for (int i = 0; i < length; i++) {
-        output[i] = fir_process(&fir_filter, input[i]);
-    }
+    // Process signal as one block with the unrolled kernel for these taps
+    rom_lowpass_process_block(&fir_filter, input, output, length);
     
     printf("FIR filter processing completed. Filter taps: %d\n", FIR_TAPS);
 }
 
+// Process signal through a Butterworth IIR with the FIR's cutoff
+void process_iir_filter(int16_t *input, int16_t *output, int16_t length) {
+    iir_filter_t iir_filter;
+    int16_t sections = iir_design_butterworth_lowpass(iir_coeffs, IIR_ORDER, 1000, 10000);
+    iir_init(&iir_filter, iir_coeffs, iir_state, sections);
+    
+    iir_process_simd(&iir_filter, input, output, length);
+    
+    printf("IIR filter processing completed. Order: %d (%d MACs/sample vs %d)\n",
+           IIR_ORDER, sections * IIR_COEFFS_PER_SECTION, FIR_TAPS);
+}
+
 // Process signal through FFT
 void process_fft(int16_t *input, int16_t length) {
-    fft_t fft;
-    fft_init(&fft, FFT_SIZE);
+    fft_t *fft = fft_plan_get(FFT_SIZE);
+    (void)length;   // The transform size is fixed by the ROM plan
     
     // Perform FFT on first FFT_SIZE samples
-    fft_real(&fft, input, fft_output);
+    int16_t exponent = fft_real(fft, input, fft_output);
     
     // Calculate power spectrum
-    fft_power_spectrum(&fft, fft_output, power_spectrum);
+    fft_power_spectrum(fft, fft_output, exponent, power_spectrum);
     
-    fft_cleanup(&fft);
     printf("FFT processing completed. FFT size: %d\n", FFT_SIZE);
 }
 
@@ -162,43 +244,39 @@ void display_results(int16_t *input, int16_t *output, int16_t length) {
     }
 }
 
-// Interrupt service routine for real-time processing
-void __attribute__((interrupt)) dsp_isr() {
-    static int16_t sample_count = 0;
-    static int16_t adc_sample;
+// DMA block-complete interrupt: hand over the half each channel has just
+// finished, the filtering runs in dsp_background_task
+void DSP_ISR dma_isr() {
+    uint32_t status = dma_status();
     
-    // Read ADC sample
-    adc_sample = read_adc();
-    
-    // Process through FIR filter
-    input_buffer[sample_count] = adc_sample;
-    output_buffer[sample_count] = fir_process(&fir_filter, adc_sample);
-    
-    // Update sample count
-    sample_count = (sample_count + 1) % BUFFER_SIZE;
-    
-    // Trigger FFT processing when buffer is full
-    if (sample_count == 0) {
-        process_fft(output_buffer, FFT_SIZE);
-    }
+    dma_ack(status & (DMA_RX_DONE | DMA_TX_DONE));
+    stream_dma_block(&dsp_stream,
+                     (status & DMA_RX_DONE) ? dma_rx_buffer + ((status & DMA_RX_HALF) ? 0 : DMA_BLOCK) : NULL,
+                     (status & DMA_TX_DONE) ? dma_tx_buffer + ((status & DMA_TX_HALF) ? 0 : DMA_BLOCK) : NULL,
+                     DMA_BLOCK);
 }
 
-// ADC read function (hardware specific)
-int16_t read_adc() {
-    // This would interface with the actual ADC hardware
-    // For simulation, return a random value
-    return (int16_t)(rand() % 65536 - 32768);
+// Background loop body: run the deferred FIR/FFT stages
+void dsp_background_task(void) {
+    stream_process(&dsp_stream);
+    
+    if (report_due) {
+        report_due = 0;
+        printf("Blocks: %u  Overruns: %u  Underruns: %u  Worst latency: %u\n",
+               dsp_stream.blocks_processed, dsp_stream.overruns,
+               dsp_stream.underruns, dsp_stream.max_latency);
+    }
 }
 
 // Timer interrupt for periodic processing
-void __attribute__((interrupt)) timer_isr() {
+void DSP_ISR timer_isr() {
     static int16_t timer_count = 0;
     
     timer_count++;
     
-    // Process FFT every 100 timer interrupts
+    // Request a pipeline report every 100 timer interrupts
     if (timer_count >= 100) {
         timer_count = 0;
-        process_fft(output_buffer, FFT_SIZE);
+        report_due = 1;
     }
 }
@@ -0,0 +1,142 @@
+//=============================================================================
+// Multichannel Batch Processing for RISC-V DSP Processor
+// Many channels or frames through one coefficient set / FFT plan
+//=============================================================================
+
+#include "dsp_math.h"
+#include "multichannel.h"
+#include "worker_pool.h"
+#include <stddef.h>
+
+// Work item for a slice of channels
+typedef struct {
+    fir_bank_t *bank;
+    const int16_t *input;
+    int16_t *output;
+    int16_t frames;
+} fir_bank_job_t;
+
+// Work item for a slice of FFT frames
+typedef struct {
+    fft_t *fft;
+    complex_t *input;
+    complex_t *output;
+    int16_t *exponents;
+} fft_batch_job_t;
+
+// Initialize FIR bank
+void fir_bank_init(fir_bank_t *bank, const int16_t *coeffs, int16_t *delay_line, int32_t *accumulator,
+                   int16_t taps, int16_t channels) {
+    bank->coeffs = coeffs;
+    bank->delay_line = delay_line;
+    bank->accumulator = accumulator;
+    bank->tap_count = taps;
+    bank->channel_count = channels;
+    bank->stride = FIR_BANK_STRIDE(channels);
+    bank->index = taps - 1;
+
+    // Clear delay line
+    for (int32_t i = 0; i < FIR_BANK_DELAY_LINE_LEN(taps, channels); i++) {
+        delay_line[i] = 0;
+    }
+}
+
+// Filter channels [begin, end) over the whole block. Every slice follows the
+// same index sequence, so each one rewinds only its own columns.
+static void fir_bank_task(void *arg, int32_t begin, int32_t end) {
+    fir_bank_job_t *job = (fir_bank_job_t*)arg;
+    fir_bank_t *bank = job->bank;
+    int16_t taps = bank->tap_count;
+    int16_t channels = bank->channel_count;
+    int16_t stride = bank->stride;
+    int32_t *acc = bank->accumulator;
+    int16_t index = bank->index;
+
+    for (int n = 0; n < job->frames; n++) {
+        if (index == FIR_DELAY_LINE_LEN(taps)) {
+            for (int i = 0; i < taps - 1; i++) {
+                int16_t *dst = &bank->delay_line[i * stride];
+                const int16_t *src = &bank->delay_line[(index - taps + 1 + i) * stride];
+                for (int32_t c = begin; c < end; c++) {
+                    dst[c] = src[c];
+                }
+            }
+            index = taps - 1;
+        }
+
+        // Store the input frame; row i back from x holds sample n - i
+        int16_t *x = &bank->delay_line[index * stride];
+        const int16_t *in = &job->input[n * channels];
+        for (int32_t c = begin; c < end; c++) {
+            x[c] = in[c];
+            acc[c] = 0;
+        }
+
+        // One coefficient per pass across the channels
+        for (int i = 0; i < taps; i++) {
+            int16_t h = bank->coeffs[i];
+            const int16_t *row = x - i * stride;
+            for (int32_t c = begin; c < end; c++) {
+                acc[c] = mac(acc[c], h, row[c]);
+            }
+        }
+
+        int16_t *out = &job->output[n * channels];
+        for (int32_t c = begin; c < end; c++) {
+            out[c] = saturate_16(acc[c]);
+        }
+        index++;
+    }
+}
+
+// FIR bank block processing
+void fir_bank_process(fir_bank_t *bank, const int16_t *input, int16_t *output, int16_t frames) {
+    fir_bank_job_t job = { bank, input, output, frames };
+
+    worker_pool_run_aligned(fir_bank_task, &job, bank->channel_count, FIR_BANK_LINE_CHANNELS);
+
+    // Advance the shared index the same way every slice did
+    for (int n = 0; n < frames; n++) {
+        if (bank->index == FIR_DELAY_LINE_LEN(bank->tap_count)) {
+            bank->index = bank->tap_count - 1;
+        }
+        bank->index++;
+    }
+}
+
+// fft_radix2 and fft_radix4 only read the plan, so frames run concurrently
+static void fft_radix2_task(void *arg, int32_t begin, int32_t end) {
+    fft_batch_job_t *job = (fft_batch_job_t*)arg;
+    int16_t size = job->fft->fft_size;
+
+    for (int32_t f = begin; f < end; f++) {
+        fft_radix2(job->fft, &job->input[f * size], &job->output[f * size]);
+    }
+}
+
+static void fft_radix4_task(void *arg, int32_t begin, int32_t end) {
+    fft_batch_job_t *job = (fft_batch_job_t*)arg;
+    int16_t size = job->fft->fft_size;
+
+    for (int32_t f = begin; f < end; f++) {
+        job->exponents[f] = fft_radix4(job->fft, &job->input[f * size], &job->output[f * size]);
+    }
+}
+
+// Frames per slice so that a slice covers whole cache lines
+static int32_t fft_batch_grain(const fft_t *fft) {
+    int32_t frame_bytes = fft->fft_size * (int32_t)sizeof(complex_t);
+    return (frame_bytes < MULTICHANNEL_CACHE_LINE) ? MULTICHANNEL_CACHE_LINE / frame_bytes : 1;
+}
+
+// Batched radix-2 FFT
+void fft_radix2_batch(fft_t *fft, complex_t *input, complex_t *output, int16_t frames) {
+    fft_batch_job_t job = { fft, input, output, NULL };
+    worker_pool_run_aligned(fft_radix2_task, &job, frames, fft_batch_grain(fft));
+}
+
+// Batched radix-4 FFT; one block exponent per frame
+void fft_radix4_batch(fft_t *fft, complex_t *input, complex_t *output, int16_t frames, int16_t *exponents) {
+    fft_batch_job_t job = { fft, input, output, exponents };
+    worker_pool_run_aligned(fft_radix4_task, &job, frames, fft_batch_grain(fft));
+}
@@ -0,0 +1,54 @@
+//=============================================================================
+// Multichannel Batch Processing for RISC-V DSP Processor
+// Many channels or frames through one coefficient set / FFT plan
+//=============================================================================
+
+#ifndef MULTICHANNEL_H
+#define MULTICHANNEL_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fft.h"
+
+// Host cache line. Threads get slices of whole lines (FIR channels, or FFT
+// frames when a frame is shorter than a line) so that no line is written by
+// two threads.
+#define MULTICHANNEL_CACHE_LINE 64
+#define FIR_BANK_LINE_CHANNELS (MULTICHANNEL_CACHE_LINE / (int16_t)sizeof(int16_t))
+
+// Delay line row: one sample per channel, padded to whole cache lines
+#define FIR_BANK_STRIDE(channels) \
+    (((channels) + FIR_BANK_LINE_CHANNELS - 1) / FIR_BANK_LINE_CHANNELS * FIR_BANK_LINE_CHANNELS)
+
+// Delay line length for fir_bank_init: FIR_DELAY_LINE_LEN rows
+#define FIR_BANK_DELAY_LINE_LEN(taps, channels) (FIR_DELAY_LINE_LEN(taps) * FIR_BANK_STRIDE(channels))
+
+// FIR bank structure. All channels share the coefficients; the history is
+// channel-interleaved (frame n of channel c at n * stride + c), so the inner
+// loop runs across channels with one coefficient per pass. Align the delay
+// line and accumulator to MULTICHANNEL_CACHE_LINE to avoid false sharing.
+typedef struct {
+    const int16_t *coeffs;      // Shared filter coefficients
+    int16_t *delay_line;        // Interleaved history (FIR_BANK_DELAY_LINE_LEN)
+    int32_t *accumulator;       // One accumulator per channel
+    int16_t tap_count;          // Number of filter taps
+    int16_t channel_count;      // Number of channels
+    int16_t stride;             // Delay line row length (FIR_BANK_STRIDE)
+    int16_t index;              // Next frame written in the delay line
+} fir_bank_t;
+
+// Initialize FIR bank; accumulator needs channel_count entries
+void fir_bank_init(fir_bank_t *bank, const int16_t *coeffs, int16_t *delay_line, int32_t *accumulator,
+                   int16_t taps, int16_t channels);
+
+// Filter 'frames' interleaved frames (input[n * channels + c]). Each channel
+// is bit-exact with fir_process; channels are split across the worker pool
+// in slices of FIR_BANK_LINE_CHANNELS.
+void fir_bank_process(fir_bank_t *bank, const int16_t *input, int16_t *output, int16_t frames);
+
+// Transform 'frames' consecutive fft_size-point frames with one shared plan,
+// split across the worker pool
+void fft_radix2_batch(fft_t *fft, complex_t *input, complex_t *output, int16_t frames);
+void fft_radix4_batch(fft_t *fft, complex_t *input, complex_t *output, int16_t frames, int16_t *exponents);
+
+#endif // MULTICHANNEL_H
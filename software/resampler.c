@@ -0,0 +1,140 @@
+//=============================================================================
+// Polyphase Resampler for RISC-V DSP Processor
+// Rational L/M rate change built on the FIR delay line and MAC kernels
+//=============================================================================
+
+#include "dsp_math.h"
+#include "resampler.h"
+#if !defined(DSP_NO_MALLOC)
+#include <stdlib.h>
+#endif
+
+// Initialize resampler. Branch p holds prototype taps p, p + L, p + 2L, ...
+// so output phase p of the upsampled stream is one dot product with the input
+// history and the inserted zeros are never multiplied.
+void resampler_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t up, int16_t down,
+                    int16_t *phase_coeffs, int16_t *delay_line) {
+    int16_t subtaps = RESAMPLER_SUBTAPS(taps, up);
+
+    for (int p = 0; p < up; p++) {
+        for (int k = 0; k < subtaps; k++) {
+            int32_t tap = p + k * up;
+            phase_coeffs[p * subtaps + k] = (tap < taps) ? coeffs[tap] : 0;
+        }
+    }
+
+    fir_init(&rs->fir, phase_coeffs, delay_line, subtaps);
+    rs->up_factor = up;
+    rs->down_factor = down;
+    rs->phase = 0;
+}
+
+void decimator_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t factor,
+                    int16_t *phase_coeffs, int16_t *delay_line) {
+    resampler_init(rs, coeffs, taps, 1, factor, phase_coeffs, delay_line);
+}
+
+void interpolator_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t factor,
+                       int16_t *phase_coeffs, int16_t *delay_line) {
+    resampler_init(rs, coeffs, taps, factor, 1, phase_coeffs, delay_line);
+}
+
+// Resample a block. Output j sits at position j * M of the upsampled grid;
+// once input n is in the history, every output at positions n * L .. n * L + L - 1
+// is computed from branch (position - n * L). Inputs that no output needs are
+// only written to the history.
+int16_t resampler_process(resampler_t *rs, const int16_t *input, int16_t *output, int16_t length) {
+    int16_t subtaps = rs->fir.tap_count;
+    int16_t up = rs->up_factor;
+    int16_t down = rs->down_factor;
+    int16_t phase = rs->phase;
+    int16_t count = 0;
+
+    for (int n = 0; n < length; n++) {
+        fir_push(&rs->fir, input[n]);
+
+        const int16_t *x = &rs->fir.delay_line[rs->fir.index - 1];
+        while (phase < up) {
+            const int16_t *h = &rs->fir.coeffs[phase * subtaps];
+            int32_t acc = 0;
+            for (int k = 0; k < subtaps; k++) {
+                acc = mac(acc, h[k], x[-k]);
+            }
+            output[count++] = saturate_16((acc + (1 << 14)) >> 15);
+            phase += down;
+        }
+        phase -= up;
+    }
+
+    rs->phase = phase;
+    return count;
+}
+
+// Prototype low-pass for an L/M resampler
+void resampler_design(int16_t *coeffs, int16_t taps, int16_t up, int16_t down) {
+    int16_t rate = (up > down) ? up : down;
+
+    // Cutoff at 1 / (2 * max(L, M)) of the upsampled rate
+    fir_design_lowpass(coeffs, taps, 1, 2 * rate);
+
+    // Zero stuffing divides the signal by L; restore it in the passband
+    for (int i = 0; i < taps; i++) {
+        coeffs[i] = saturate_16((int32_t)coeffs[i] * up);
+    }
+}
+
+// Raised cosine pulse; rolloff_factor is Q15 (0 to 1). With t = n / sps:
+// h = sinc(t) * cos(pi * beta * t) / (1 - (2 * beta * t)^2), evaluated with
+// binary angles so no floating point is involved.
+void raised_cosine_design(int16_t *coeffs, int16_t taps, int16_t rolloff_factor, int16_t samples_per_symbol) {
+    int64_t b = 32768 * (int64_t)samples_per_symbol;
+
+    for (int i = 0; i < taps; i++) {
+        int32_t n = i - taps / 2;
+
+        // sinc(t) = sin(pi * t) / (pi * t) in Q15; 10430 is 1 / pi in Q15
+        int32_t sinc_val = 32767;
+        if (n != 0) {
+            int16_t angle = (int16_t)((32768 * n) / samples_per_symbol);
+            sinc_val = (int32_t)(((int64_t)sin_16(angle) * 10430 * samples_per_symbol / n + 16384) >> 15);
+        }
+
+        // 1 - (2 * beta * t)^2 in Q30
+        int64_t a = 2 * (int64_t)rolloff_factor * n;
+        int64_t denom = (b * b - a * a) / ((int64_t)samples_per_symbol * samples_per_symbol);
+        int32_t h;
+
+        if (denom > -(1 << 18) && denom < (1 << 18)) {
+            // Limit at t = +/-1 / (2 beta): (beta / 2) * sin(pi / (2 beta))
+            int16_t angle = (int16_t)(((int64_t)16384 * 32768) / rolloff_factor);
+            h = ((int32_t)rolloff_factor * sin_16(angle)) >> 16;
+        } else {
+            int16_t angle = (int16_t)(((int64_t)rolloff_factor * n) / samples_per_symbol);
+            int64_t num = (int64_t)sinc_val * cos_16(angle);
+            h = (int32_t)((num << 15) / denom);
+        }
+        coeffs[i] = saturate_16(h);
+    }
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Raised cosine pulse shaping: each symbol becomes samples_per_symbol output
+// samples through a polyphase interpolator, so the pulse is evaluated only
+// at the non-zero inputs. Output holds length * samples_per_symbol samples.
+void raised_cosine_filter_16(int16_t *input, int16_t *output, int16_t length,
+                            int16_t rolloff_factor, int16_t samples_per_symbol) {
+    int16_t taps = RAISED_COSINE_SPAN * samples_per_symbol + 1;
+    int16_t *coeffs = (int16_t*)malloc(taps * sizeof(int16_t));
+    int16_t *phase_coeffs = (int16_t*)malloc(RESAMPLER_PHASE_COEFFS_LEN(taps, samples_per_symbol) * sizeof(int16_t));
+    int16_t *delay_line = (int16_t*)malloc(RESAMPLER_DELAY_LINE_LEN(taps, samples_per_symbol) * sizeof(int16_t));
+    resampler_t rs;
+
+    raised_cosine_design(coeffs, taps, rolloff_factor, samples_per_symbol);
+    interpolator_init(&rs, coeffs, taps, samples_per_symbol, phase_coeffs, delay_line);
+    resampler_process(&rs, input, output, length);
+
+    free(coeffs);
+    free(phase_coeffs);
+    free(delay_line);
+}
+#endif
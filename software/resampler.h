@@ -0,0 +1,54 @@
+//=============================================================================
+// Polyphase Resampler for RISC-V DSP Processor
+// Rational L/M rate change built on the FIR delay line and MAC kernels
+//=============================================================================
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+
+// Taps per polyphase branch for a prototype of 'taps' taps split L ways
+#define RESAMPLER_SUBTAPS(taps, up) (((taps) + (up) - 1) / (up))
+
+// Storage required by resampler_init
+#define RESAMPLER_PHASE_COEFFS_LEN(taps, up) ((up) * RESAMPLER_SUBTAPS(taps, up))
+#define RESAMPLER_DELAY_LINE_LEN(taps, up) FIR_DELAY_LINE_LEN(RESAMPLER_SUBTAPS(taps, up))
+
+// Raised cosine pulse length in symbols
+#define RAISED_COSINE_SPAN 8
+
+// Resampler structure. The prototype is a Q15 low-pass at the L-times
+// upsampled rate; outputs are rounded from Q15, unlike fir_process.
+// Decimation is L = 1, interpolation is M = 1.
+typedef struct {
+    fir_filter_t fir;           // Input history; fir.coeffs holds the branches
+    int16_t up_factor;          // Interpolation factor (L)
+    int16_t down_factor;        // Decimation factor (M)
+    int16_t phase;              // Next output position on the upsampled grid,
+                                // relative to the newest input sample
+} resampler_t;
+
+// Split a prototype into L branches and clear the history
+void resampler_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t up, int16_t down,
+                    int16_t *phase_coeffs, int16_t *delay_line);
+
+// Consume 'length' inputs; returns the number of outputs written. Between
+// floor(length * L / M) and that plus one outputs are produced per call.
+int16_t resampler_process(resampler_t *rs, const int16_t *input, int16_t *output, int16_t length);
+
+// Convenience wrappers
+void decimator_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t factor,
+                    int16_t *phase_coeffs, int16_t *delay_line);
+void interpolator_init(resampler_t *rs, const int16_t *coeffs, int16_t taps, int16_t factor,
+                       int16_t *phase_coeffs, int16_t *delay_line);
+
+// Anti-alias / anti-image prototype: cutoff at the lower of the two Nyquist
+// rates with a passband gain of L
+void resampler_design(int16_t *coeffs, int16_t taps, int16_t up, int16_t down);
+
+// Raised cosine pulse sampled at samples_per_symbol, Q15 with unity peak
+void raised_cosine_design(int16_t *coeffs, int16_t taps, int16_t rolloff_factor, int16_t samples_per_symbol);
+
+#endif // RESAMPLER_H
@@ -0,0 +1,39 @@
+//=============================================================================
+// ROM Tables for RISC-V DSP Processor
+// Compile-time coefficients, FFT plans and FIR kernels for main.c
+//=============================================================================
+
+#include "dsp_tables.hpp"
+#include "rom_tables.h"
+
+static constexpr auto lowpass = dsp::fir_lowpass<ROM_LOWPASS_TAPS, 1000, 10000>();
+static constexpr auto fft_full = dsp::fft_tables<ROM_FFT_SIZE>();
+static constexpr auto fft_half = dsp::fft_half_tables<ROM_FFT_SIZE>();
+
+// All of these are .rodata, which the linker script places in bank X with
+// the other coefficients
+extern "C" const int16_t *const rom_lowpass_coeffs = lowpass.data;
+
+// Only the temporary buffers are RAM
+static complex_t fft_full_temp[ROM_FFT_SIZE];
+static complex_t fft_half_temp[ROM_FFT_SIZE / 2];
+
+int16_t rom_lowpass_process(fir_filter_t *fir, int16_t input) {
+    return dsp::fir_fixed<lowpass>::process(fir, input);
+}
+
+void rom_lowpass_process_block(fir_filter_t *fir, const int16_t *input, int16_t *output, int16_t length) {
+    dsp::fir_fixed<lowpass>::process_block(fir, input, output, length);
+}
+
+int16_t rom_fft_install(void) {
+    fft_t full;
+    fft_t half;
+
+    // The half-size plan shares the first half of the full twiddle table
+    fft_init_static(&full, ROM_FFT_SIZE, fft_full.twiddles.data, fft_full.radix4_twiddles.data,
+                    fft_full.bit_reverse.data, fft_full_temp);
+    fft_init_static(&half, ROM_FFT_SIZE / 2, fft_full.twiddles.data, fft_half.radix4_twiddles.data,
+                    fft_half.bit_reverse.data, fft_half_temp);
+    return fft_plan_install(&half) & fft_plan_install(&full);
+}
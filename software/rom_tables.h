@@ -0,0 +1,37 @@
+//=============================================================================
+// ROM Tables for RISC-V DSP Processor
+// Compile-time coefficients, FFT plans and FIR kernels for main.c
+//=============================================================================
+
+#ifndef ROM_TABLES_H
+#define ROM_TABLES_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Low-pass used by main.c: 64 taps, 1kHz cutoff at 10kHz, Hamming window.
+// Equal to fir_design_lowpass(coeffs, 64, 1000, 10000).
+#define ROM_LOWPASS_TAPS 64
+extern const int16_t *const rom_lowpass_coeffs;
+
+// Unrolled kernels for a filter set up with fir_init(fir, rom_lowpass_coeffs,
+// ...); bit-exact with fir_process and fir_process_block
+int16_t rom_lowpass_process(fir_filter_t *fir, int16_t input);
+void rom_lowpass_process_block(fir_filter_t *fir, const int16_t *input, int16_t *output, int16_t length);
+
+// Install the ROM_FFT_SIZE and ROM_FFT_SIZE / 2 plans (the latter for
+// fft_real) in the plan cache. Call before the first fft_plan_get of
+// these sizes; returns 0 if either size already had a plan.
+#define ROM_FFT_SIZE 256
+int16_t rom_fft_install(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROM_TABLES_H
@@ -0,0 +1,310 @@
+//=============================================================================
+// Sliding-Window Statistics for RISC-V DSP Processor
+// Streaming mean, median and min/max over the last N samples
+//=============================================================================
+
+#include "dsp_math.h"
+#include "sliding_window.h"
+
+// Deque setup on caller-provided storage
+static void deque_attach(window_deque_t *d, int16_t *values, uint32_t *positions, int16_t capacity) {
+    d->values = values;
+    d->positions = positions;
+    d->capacity = capacity;
+    d->head = 0;
+    d->count = 0;
+}
+
+// Drop entries that are 'window' or more samples older than 'position'
+static void deque_expire(window_deque_t *d, uint32_t position, int16_t window) {
+    while (d->count > 0 && position - d->positions[d->head] >= (uint32_t)window) {
+        d->head = (d->head + 1 == d->capacity) ? 0 : d->head + 1;
+        d->count--;
+    }
+}
+
+// Append at the back after removing every entry the new value dominates
+static void deque_push(window_deque_t *d, int16_t value, uint32_t position, int16_t keep_max) {
+    while (d->count > 0) {
+        int16_t back = d->head + d->count - 1;
+        if (back >= d->capacity) {
+            back -= d->capacity;
+        }
+        if (keep_max ? d->values[back] > value : d->values[back] < value) {
+            break;
+        }
+        d->count--;
+    }
+
+    int16_t slot = d->head + d->count;
+    if (slot >= d->capacity) {
+        slot -= d->capacity;
+    }
+    d->values[slot] = value;
+    d->positions[slot] = position;
+    d->count++;
+}
+
+// First index in sorted[0..n) whose value is >= value (lower) or > value (upper)
+static int16_t sorted_search(const int16_t *sorted, int16_t n, int16_t value, int16_t upper) {
+    int16_t lo = 0;
+    int16_t hi = n;
+
+    while (lo < hi) {
+        int16_t mid = (lo + hi) >> 1;
+        if (sorted[mid] < value || (upper && sorted[mid] == value)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Replace one occurrence of old_value by new_value; only the elements
+// between the two positions move
+static void sorted_replace(int16_t *sorted, int16_t n, int16_t old_value, int16_t new_value) {
+    int16_t i = sorted_search(sorted, n, old_value, 0);
+
+    if (new_value == old_value) {
+        return;
+    }
+    if (new_value > old_value) {
+        int16_t j = sorted_search(sorted, n, new_value, 0) - 1;
+        for (; i < j; i++) {
+            sorted[i] = sorted[i + 1];
+        }
+        sorted[j] = new_value;
+    } else {
+        int16_t j = sorted_search(sorted, n, new_value, 1);
+        for (; i > j; i--) {
+            sorted[i] = sorted[i - 1];
+        }
+        sorted[j] = new_value;
+    }
+}
+
+// Bytes window_init_arena takes
+uint32_t window_workspace_size(int16_t window_size, int16_t flags) {
+    uint32_t bytes = ARENA_BLOCK_SIZE(window_size * sizeof(int16_t));
+
+    if (flags & WINDOW_MEDIAN) {
+        bytes += ARENA_BLOCK_SIZE(window_size * sizeof(int16_t));
+    }
+    if (flags & WINDOW_MINMAX) {
+        bytes += 2 * (ARENA_BLOCK_SIZE(window_size * sizeof(int16_t)) +
+                      ARENA_BLOCK_SIZE(window_size * sizeof(uint32_t)));
+    }
+    return bytes;
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Initialize window
+void window_init(sliding_window_t *w, int16_t window_size, int16_t flags) {
+    window_init_arena(w, window_size, flags, NULL);
+}
+#endif
+
+// Initialize window from an arena (or the heap for NULL)
+int16_t window_init_arena(sliding_window_t *w, int16_t window_size, int16_t flags, arena_t *arena) {
+    uint32_t mark = arena_mark(arena);
+    int16_t ok;
+
+    w->window_size = window_size;
+    w->flags = flags;
+    w->arena = arena;
+    w->history = (int16_t*)dsp_alloc(arena, window_size * sizeof(int16_t));
+    w->reciprocal = (uint32_t)(((uint64_t)1 << 31) / window_size);
+    w->sorted = NULL;
+    ok = (w->history != NULL);
+    if (flags & WINDOW_MEDIAN) {
+        w->sorted = (int16_t*)dsp_alloc(arena, window_size * sizeof(int16_t));
+        ok = ok && w->sorted;
+    }
+    if (flags & WINDOW_MINMAX) {
+        deque_attach(&w->max_deque, (int16_t*)dsp_alloc(arena, window_size * sizeof(int16_t)),
+                     (uint32_t*)dsp_alloc(arena, window_size * sizeof(uint32_t)), window_size);
+        deque_attach(&w->min_deque, (int16_t*)dsp_alloc(arena, window_size * sizeof(int16_t)),
+                     (uint32_t*)dsp_alloc(arena, window_size * sizeof(uint32_t)), window_size);
+        ok = ok && w->max_deque.values && w->max_deque.positions &&
+             w->min_deque.values && w->min_deque.positions;
+    }
+    if (!ok) {
+        window_cleanup(w);
+        arena_release(arena, mark);
+        return 0;
+    }
+    window_reset(w);
+    return 1;
+}
+
+// Empty the window, keeping its buffers
+void window_reset(sliding_window_t *w) {
+    w->oldest = 0;
+    w->count = 0;
+    w->position = 0;
+    w->sum = 0;
+    w->max_deque.head = 0;
+    w->max_deque.count = 0;
+    w->min_deque.head = 0;
+    w->min_deque.count = 0;
+}
+
+// Add one sample
+void window_push(sliding_window_t *w, int16_t sample) {
+    if (w->count == w->window_size) {
+        int16_t old = w->history[w->oldest];
+        w->history[w->oldest] = sample;
+        w->oldest = (w->oldest + 1 == w->window_size) ? 0 : w->oldest + 1;
+
+        w->sum += sample - old;
+        if (w->flags & WINDOW_MEDIAN) {
+            sorted_replace(w->sorted, w->count, old, sample);
+        }
+    } else {
+        w->history[w->count] = sample;
+        w->sum += sample;
+        if (w->flags & WINDOW_MEDIAN) {
+            int16_t k = sorted_search(w->sorted, w->count, sample, 1);
+            for (int16_t i = w->count; i > k; i--) {
+                w->sorted[i] = w->sorted[i - 1];
+            }
+            w->sorted[k] = sample;
+        }
+        w->count++;
+    }
+
+    if (w->flags & WINDOW_MINMAX) {
+        deque_expire(&w->max_deque, w->position, w->window_size);
+        deque_expire(&w->min_deque, w->position, w->window_size);
+        deque_push(&w->max_deque, sample, w->position, 1);
+        deque_push(&w->min_deque, sample, w->position, 0);
+    }
+    w->position++;
+}
+
+// Mean by reciprocal multiply, rounded exactly: round(sum / n) is
+// floor((2 * sum + n) / 2n), and the estimate is off by at most one
+int16_t window_mean(const sliding_window_t *w) {
+    if (w->count == 0) {
+        return 0;
+    }
+
+    uint32_t reciprocal = w->reciprocal;
+    if (w->count < w->window_size) {
+        reciprocal = (uint32_t)(((uint64_t)1 << 31) / w->count);
+    }
+
+    int64_t num = 2 * (int64_t)w->sum + w->count;
+    int64_t den = 2 * (int64_t)w->count;
+    int64_t q = (num * reciprocal) >> 32;
+    if (q * den > num) {
+        q--;
+    } else if ((q + 1) * den <= num) {
+        q++;
+    }
+    return (int16_t)q;
+}
+
+int16_t window_median(const sliding_window_t *w) {
+    return (w->count == 0) ? 0 : w->sorted[w->count >> 1];
+}
+
+int16_t window_max(const sliding_window_t *w) {
+    return (w->count == 0) ? 0 : w->max_deque.values[w->max_deque.head];
+}
+
+int16_t window_min(const sliding_window_t *w) {
+    return (w->count == 0) ? 0 : w->min_deque.values[w->min_deque.head];
+}
+
+// Block processing
+void window_mean_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        window_push(w, input[i]);
+        output[i] = window_mean(w);
+    }
+}
+
+void window_median_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        window_push(w, input[i]);
+        output[i] = window_median(w);
+    }
+}
+
+void window_max_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        window_push(w, input[i]);
+        output[i] = window_max(w);
+    }
+}
+
+void window_min_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length) {
+    for (int i = 0; i < length; i++) {
+        window_push(w, input[i]);
+        output[i] = window_min(w);
+    }
+}
+
+// Cleanup window resources
+void window_cleanup(sliding_window_t *w) {
+    dsp_free(w->arena, w->history);
+    dsp_free(w->arena, w->sorted);
+    if (w->flags & WINDOW_MINMAX) {
+        dsp_free(w->arena, w->max_deque.values);
+        dsp_free(w->arena, w->max_deque.positions);
+        dsp_free(w->arena, w->min_deque.values);
+        dsp_free(w->arena, w->min_deque.positions);
+    }
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Moving average filter (causal, window_size samples)
+void moving_average_16(int16_t *input, int16_t *output, int16_t length, int16_t window_size) {
+    sliding_window_t w;
+
+    window_init(&w, window_size, WINDOW_MEAN);
+    window_mean_block(&w, input, output, length);
+    window_cleanup(&w);
+}
+
+// Median filter (causal, window_size samples)
+void median_filter_16(int16_t *input, int16_t *output, int16_t length, int16_t window_size) {
+    sliding_window_t w;
+
+    window_init(&w, window_size, WINDOW_MEDIAN);
+    window_median_block(&w, input, output, length);
+    window_cleanup(&w);
+}
+#endif
+
+// Peak detection: sample i is a peak when it is at least threshold and the
+// maximum of input[i - R .. i + R] (R = FIND_PEAKS_RADIUS). A running-max
+// deque runs R samples ahead of i; peaks closer than R + 1 samples keep the
+// first. Writes peak indices and returns their count.
+int16_t find_peaks_16(int16_t *input, int16_t *peaks, int16_t length, int16_t threshold) {
+    int16_t values[2 * FIND_PEAKS_RADIUS + 1];
+    uint32_t positions[2 * FIND_PEAKS_RADIUS + 1];
+    window_deque_t d;
+    int16_t count = 0;
+    int32_t last_peak = -(FIND_PEAKS_RADIUS + 1);
+
+    deque_attach(&d, values, positions, 2 * FIND_PEAKS_RADIUS + 1);
+
+    for (int32_t j = 0; j < length + FIND_PEAKS_RADIUS; j++) {
+        deque_expire(&d, (uint32_t)j, 2 * FIND_PEAKS_RADIUS + 1);
+        if (j < length) {
+            deque_push(&d, input[j], (uint32_t)j, 1);
+        }
+
+        int32_t i = j - FIND_PEAKS_RADIUS;
+        if (i >= 0 && input[i] >= threshold && input[i] == d.values[d.head] &&
+            i - last_peak > FIND_PEAKS_RADIUS) {
+            peaks[count++] = (int16_t)i;
+            last_peak = i;
+        }
+    }
+
+    return count;
+}
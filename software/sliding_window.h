@@ -0,0 +1,76 @@
+//=============================================================================
+// Sliding-Window Statistics for RISC-V DSP Processor
+// Streaming mean, median and min/max over the last N samples
+//=============================================================================
+
+#ifndef SLIDING_WINDOW_H
+#define SLIDING_WINDOW_H
+
+#include <stdint.h>
+#include "dsp_arena.h"
+
+// Statistics maintained by a window (window_init flags)
+#define WINDOW_MEAN    0x1
+#define WINDOW_MEDIAN  0x2
+#define WINDOW_MINMAX  0x4
+
+// find_peaks_16: a peak is the largest sample within +/- this many samples
+#define FIND_PEAKS_RADIUS 3
+
+// Monotonic deque of (value, position) pairs. Values are kept decreasing
+// (max) or increasing (min) from front to back, so the front is the extreme
+// of the window; each sample is pushed and popped at most once.
+typedef struct {
+    int16_t *values;            // Ring of values
+    uint32_t *positions;        // Stream position of each value
+    int16_t capacity;           // Ring size (window size)
+    int16_t head;               // Front slot
+    int16_t count;              // Entries in use
+} window_deque_t;
+
+// Sliding window. Until window_size samples have been pushed the
+// statistics cover the samples seen so far.
+typedef struct {
+    int16_t window_size;        // Window length (N)
+    int16_t flags;              // WINDOW_* statistics maintained
+    int16_t *history;           // Last N samples, circular
+    int16_t oldest;             // Slot of the oldest sample once full
+    int16_t count;              // Samples in the window (up to N)
+    uint32_t position;          // Samples pushed so far
+    int32_t sum;                // Running sum (WINDOW_MEAN)
+    uint32_t reciprocal;        // floor(2^32 / 2N) for the mean
+    int16_t *sorted;            // Window contents in ascending order (WINDOW_MEDIAN)
+    window_deque_t max_deque;   // WINDOW_MINMAX
+    window_deque_t min_deque;
+    arena_t *arena;             // Where the buffers came from (NULL: heap)
+} sliding_window_t;
+
+// Allocate a window for the statistics in flags; window_size up to 32767
+#if !defined(DSP_NO_MALLOC)
+void window_init(sliding_window_t *w, int16_t window_size, int16_t flags);
+#endif
+
+// Same, with the buffers (window_workspace_size bytes) taken from an arena;
+// 0 if they do not fit
+int16_t window_init_arena(sliding_window_t *w, int16_t window_size, int16_t flags, arena_t *arena);
+uint32_t window_workspace_size(int16_t window_size, int16_t flags);
+
+void window_reset(sliding_window_t *w);
+void window_cleanup(sliding_window_t *w);
+
+// Add one sample, dropping the oldest once the window is full
+void window_push(sliding_window_t *w, int16_t sample);
+
+// Statistics of the current window
+int16_t window_mean(const sliding_window_t *w);    // Rounded
+int16_t window_median(const sliding_window_t *w);  // Upper median for even counts
+int16_t window_max(const sliding_window_t *w);
+int16_t window_min(const sliding_window_t *w);
+
+// Block processing: push each input and store the statistic
+void window_mean_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length);
+void window_median_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length);
+void window_max_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length);
+void window_min_block(sliding_window_t *w, const int16_t *input, int16_t *output, int16_t length);
+
+#endif // SLIDING_WINDOW_H
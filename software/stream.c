@@ -0,0 +1,318 @@
+//=============================================================================
+// Streaming Pipeline for RISC-V DSP Processor
+// Lock-free sample rings between interrupts and deferred block processing
+//=============================================================================
+
+#include "dsp_math.h"
+#include "stream.h"
+
+#if !defined(__riscv)
+#include <time.h>
+#endif
+
+// Index publication: the data store must be visible before the index that
+// hands it over, and the index must be read before the data it covers
+#define RING_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RING_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+// Time base
+uint32_t stream_time(void) {
+#if defined(__riscv)
+    uint32_t cycles;
+    __asm__ volatile ("rdcycle %0" : "=r" (cycles));
+    return cycles;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000u + now.tv_nsec);
+#endif
+}
+
+// Initialize ring
+void ring_init(sample_ring_t *ring, int16_t *buffer, uint16_t capacity) {
+    ring->buffer = buffer;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+uint16_t ring_count(const sample_ring_t *ring) {
+    return (uint16_t)(RING_LOAD(&ring->head) - RING_LOAD(&ring->tail));
+}
+
+uint16_t ring_space(const sample_ring_t *ring) {
+    return ring->mask + 1 - ring_count(ring);
+}
+
+// Producer: single sample
+int16_t ring_push(sample_ring_t *ring, int16_t sample) {
+    uint16_t head = ring->head;
+
+    if ((uint16_t)(head - RING_LOAD(&ring->tail)) > ring->mask) {
+        return 0;
+    }
+    ring->buffer[head & ring->mask] = sample;
+    RING_STORE(&ring->head, (uint16_t)(head + 1));
+    return 1;
+}
+
+// Consumer: single sample
+int16_t ring_pop(sample_ring_t *ring, int16_t *sample) {
+    uint16_t tail = ring->tail;
+
+    if (RING_LOAD(&ring->head) == tail) {
+        return 0;
+    }
+    *sample = ring->buffer[tail & ring->mask];
+    RING_STORE(&ring->tail, (uint16_t)(tail + 1));
+    return 1;
+}
+
+// Producer: block, published with one index update
+void ring_write(sample_ring_t *ring, const int16_t *data, uint16_t length) {
+    uint16_t head = ring->head;
+
+    for (int i = 0; i < length; i++) {
+        ring->buffer[(uint16_t)(head + i) & ring->mask] = data[i];
+    }
+    RING_STORE(&ring->head, (uint16_t)(head + length));
+}
+
+// Consumer: block, released with one index update
+void ring_read(sample_ring_t *ring, int16_t *data, uint16_t length) {
+    uint16_t tail = ring->tail;
+
+    for (int i = 0; i < length; i++) {
+        data[i] = ring->buffer[(uint16_t)(tail + i) & ring->mask];
+    }
+    RING_STORE(&ring->tail, (uint16_t)(tail + length));
+}
+
+// Bytes stream_init_arena takes, plus stream_watch_bins when watch_count > 0
+uint32_t stream_workspace_size(int16_t block_size, uint16_t ring_capacity, int16_t has_fft, int16_t watch_count) {
+    uint32_t bytes = 2 * ARENA_BLOCK_SIZE(ring_capacity * sizeof(int16_t)) +
+                     3 * ARENA_BLOCK_SIZE(block_size * sizeof(int16_t)) +
+                     ARENA_BLOCK_SIZE((ring_capacity / block_size) * sizeof(uint32_t));
+
+    if (has_fft) {
+        bytes += ARENA_BLOCK_SIZE(block_size * sizeof(complex_t)) +
+                 ARENA_BLOCK_SIZE((block_size / 2) * sizeof(int16_t));
+    }
+    if (watch_count > 0) {
+        bytes += ARENA_BLOCK_SIZE(sizeof(tone_bank_t)) +
+                 tone_bank_workspace_size(TONE_GOERTZEL, watch_count, block_size);
+    }
+    return bytes;
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Initialize pipeline
+void stream_init(stream_pipeline_t *pipe, fir_filter_t *fir, fft_t *fft, int16_t block_size, uint16_t ring_capacity) {
+    stream_init_arena(pipe, fir, fft, block_size, ring_capacity, NULL);
+}
+#endif
+
+// Initialize pipeline from an arena (or the heap for NULL)
+int16_t stream_init_arena(stream_pipeline_t *pipe, fir_filter_t *fir, fft_t *fft, int16_t block_size,
+                          uint16_t ring_capacity, arena_t *arena) {
+    uint32_t mark = arena_mark(arena);
+    int16_t stamps = ring_capacity / block_size;
+
+    pipe->arena = arena;
+    pipe->fir = fir;
+    pipe->fft = fft;
+    pipe->block_size = block_size;
+    pipe->log2_block = 0;
+    while ((1 << pipe->log2_block) < block_size) {
+        pipe->log2_block++;
+    }
+
+    ring_init(&pipe->input, (int16_t*)dsp_alloc(arena, ring_capacity * sizeof(int16_t)), ring_capacity);
+    ring_init(&pipe->output, (int16_t*)dsp_alloc(arena, ring_capacity * sizeof(int16_t)), ring_capacity);
+
+    pipe->blocks[0] = (int16_t*)dsp_alloc(arena, block_size * sizeof(int16_t));
+    pipe->blocks[1] = (int16_t*)dsp_alloc(arena, block_size * sizeof(int16_t));
+    pipe->in_block = (int16_t*)dsp_alloc(arena, block_size * sizeof(int16_t));
+    pipe->active = 0;
+
+    pipe->spectrum = NULL;
+    pipe->power_spectrum = NULL;
+    if (fft) {
+        pipe->spectrum = (complex_t*)dsp_alloc(arena, block_size * sizeof(complex_t));
+        pipe->power_spectrum = (int16_t*)dsp_alloc(arena, (block_size / 2) * sizeof(int16_t));
+    }
+    pipe->spectrum_count = 0;
+    pipe->tones = NULL;
+
+    pipe->timestamps = (uint32_t*)dsp_alloc(arena, stamps * sizeof(uint32_t));
+    pipe->timestamp_mask = stamps - 1;
+    if (!pipe->input.buffer || !pipe->output.buffer || !pipe->blocks[0] || !pipe->blocks[1] ||
+        !pipe->in_block || (fft && (!pipe->spectrum || !pipe->power_spectrum)) || !pipe->timestamps) {
+        stream_cleanup(pipe);
+        arena_release(arena, mark);
+        return 0;
+    }
+    for (int i = 0; i < block_size; i++) {
+        pipe->blocks[0][i] = 0;
+        pipe->blocks[1][i] = 0;
+    }
+
+    pipe->overruns = 0;
+    pipe->underruns = 0;
+    pipe->blocks_processed = 0;
+    pipe->max_latency = 0;
+    pipe->max_process_time = 0;
+    return 1;
+}
+
+// Replace the FFT with a Goertzel bank when the cost model favours it
+int16_t stream_watch_bins(stream_pipeline_t *pipe, const int16_t *bins, int16_t count) {
+    if (!pipe->fft || pipe->tones || !tone_bank_preferred(TONE_GOERTZEL, count, pipe->block_size, 0)) {
+        return 0;
+    }
+
+    uint32_t mark = arena_mark(pipe->arena);
+    tone_bank_t *tones = (tone_bank_t*)dsp_alloc(pipe->arena, sizeof(tone_bank_t));
+    if (!tones) {
+        return 0;
+    }
+    if (!tone_bank_init_arena(tones, TONE_GOERTZEL, bins, count, pipe->block_size, NULL, pipe->arena)) {
+        dsp_free(pipe->arena, tones);
+        arena_release(pipe->arena, mark);
+        return 0;
+    }
+    pipe->tones = tones;
+    for (int i = 0; i < pipe->block_size / 2; i++) {
+        pipe->power_spectrum[i] = 0;
+    }
+    return 1;
+}
+
+// ADC interrupt: enqueue one sample. The first sample of each block is
+// timestamped for the latency measurement; a full ring drops the sample.
+// Dropped samples do not advance head, so blocks stay aligned.
+void stream_isr_push(stream_pipeline_t *pipe, int16_t sample) {
+    uint16_t head = pipe->input.head;
+
+    if (ring_space(&pipe->input) == 0) {
+        pipe->overruns++;
+        return;
+    }
+    if ((head & (pipe->block_size - 1)) == 0) {
+        pipe->timestamps[(head >> pipe->log2_block) & pipe->timestamp_mask] = stream_time();
+    }
+    ring_push(&pipe->input, sample);
+}
+
+// DAC interrupt: dequeue one filtered sample, or silence on underrun
+int16_t stream_isr_pop(stream_pipeline_t *pipe) {
+    int16_t sample;
+
+    if (!ring_pop(&pipe->output, &sample)) {
+        pipe->underruns++;
+        return 0;
+    }
+    return sample;
+}
+
+// DMA interrupt: whole halves go through the rings with one index update
+// each. A half that does not fit is dropped, like single samples.
+void stream_dma_block(stream_pipeline_t *pipe, const int16_t *rx, int16_t *tx, uint16_t length) {
+    if (rx != NULL) {
+        uint16_t head = pipe->input.head;
+
+        if (ring_space(&pipe->input) < length) {
+            pipe->overruns += length;
+        } else {
+            uint32_t now = stream_time();
+            for (uint16_t i = (uint16_t)-head & (pipe->block_size - 1); i < length; i += pipe->block_size) {
+                pipe->timestamps[((uint16_t)(head + i) >> pipe->log2_block) & pipe->timestamp_mask] = now;
+            }
+            ring_write(&pipe->input, rx, length);
+        }
+    }
+
+    if (tx != NULL) {
+        uint16_t available = ring_count(&pipe->output);
+
+        if (available >= length) {
+            ring_read(&pipe->output, tx, length);
+        } else {
+            ring_read(&pipe->output, tx, available);
+            for (uint16_t i = available; i < length; i++) {
+                tx[i] = 0;
+            }
+            pipe->underruns += length - available;
+        }
+    }
+}
+
+// Deferred consumer
+int16_t stream_process(stream_pipeline_t *pipe) {
+    int16_t block_size = pipe->block_size;
+    int16_t processed = 0;
+
+    while (ring_count(&pipe->input) >= block_size && ring_space(&pipe->output) >= block_size) {
+        uint32_t start = stream_time();
+        uint32_t enqueued = pipe->timestamps[(pipe->input.tail >> pipe->log2_block) & pipe->timestamp_mask];
+        int16_t *out = pipe->blocks[pipe->active];
+
+        // FIR stage
+        ring_read(&pipe->input, pipe->in_block, block_size);
+        fir_process_block(pipe->fir, pipe->in_block, out, block_size);
+        ring_write(&pipe->output, out, block_size);
+
+        // Spectrum stage on the block just completed; the bank sees exactly
+        // one block, so it completes once per call
+        if (pipe->tones) {
+            tone_bank_process(pipe->tones, out, block_size);
+            for (int b = 0; b < pipe->tones->bin_count; b++) {
+                int16_t bin = pipe->tones->bins[b];
+                if (bin < block_size / 2) {
+                    pipe->power_spectrum[bin] = pipe->tones->power[b];
+                }
+            }
+            pipe->spectrum_count++;
+        } else if (pipe->fft) {
+            int16_t exponent = fft_real(pipe->fft, out, pipe->spectrum);
+            if (exponent != FFT_NO_PLAN) {
+                fft_power_spectrum(pipe->fft, pipe->spectrum, exponent, pipe->power_spectrum);
+                pipe->spectrum_count++;
+            }
+        }
+
+        pipe->active ^= 1;
+        pipe->blocks_processed++;
+        processed++;
+
+        uint32_t end = stream_time();
+        if (end - enqueued > pipe->max_latency) {
+            pipe->max_latency = end - enqueued;
+        }
+        if (end - start > pipe->max_process_time) {
+            pipe->max_process_time = end - start;
+        }
+    }
+
+    return processed;
+}
+
+const int16_t *stream_last_block(const stream_pipeline_t *pipe) {
+    return pipe->blocks[pipe->active ^ 1];
+}
+
+// Cleanup pipeline resources
+void stream_cleanup(stream_pipeline_t *pipe) {
+    dsp_free(pipe->arena, pipe->input.buffer);
+    dsp_free(pipe->arena, pipe->output.buffer);
+    dsp_free(pipe->arena, pipe->blocks[0]);
+    dsp_free(pipe->arena, pipe->blocks[1]);
+    dsp_free(pipe->arena, pipe->in_block);
+    dsp_free(pipe->arena, pipe->spectrum);
+    dsp_free(pipe->arena, pipe->power_spectrum);
+    if (pipe->tones) {
+        tone_bank_cleanup(pipe->tones);
+        dsp_free(pipe->arena, pipe->tones);
+    }
+    dsp_free(pipe->arena, pipe->timestamps);
+}
@@ -0,0 +1,104 @@
+//=============================================================================
+// Streaming Pipeline for RISC-V DSP Processor
+// Lock-free sample rings between interrupts and deferred block processing
+//=============================================================================
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <stdint.h>
+#include "fir_filter.h"
+#include "fft.h"
+#include "tone_detector.h"
+
+// Single-producer/single-consumer sample ring. head is written only by the
+// producer and tail only by the consumer, so neither side takes a lock.
+// Capacity is a power of two no larger than 32768.
+typedef struct {
+    int16_t *buffer;            // Sample storage
+    uint16_t mask;              // Capacity - 1
+    uint16_t head;              // Free-running write count (producer)
+    uint16_t tail;              // Free-running read count (consumer)
+} sample_ring_t;
+
+void ring_init(sample_ring_t *ring, int16_t *buffer, uint16_t capacity);
+uint16_t ring_count(const sample_ring_t *ring);
+uint16_t ring_space(const sample_ring_t *ring);
+int16_t ring_push(sample_ring_t *ring, int16_t sample);            // 0 when full
+int16_t ring_pop(sample_ring_t *ring, int16_t *sample);            // 0 when empty
+void ring_write(sample_ring_t *ring, const int16_t *data, uint16_t length);  // Caller checks ring_space
+void ring_read(sample_ring_t *ring, int16_t *data, uint16_t length);         // Caller checks ring_count
+
+// Streaming pipeline: ADC ISR -> input ring -> block FIR (+ spectrum) ->
+// output ring -> DAC ISR. The ISRs only move single samples; all filtering
+// happens in stream_process, called from the background loop.
+typedef struct {
+    sample_ring_t input;        // ADC samples
+    sample_ring_t output;       // Filtered samples
+    fir_filter_t *fir;          // Block FIR stage
+    fft_t *fft;                 // Spectrum stage plan (fft_size == block_size), or NULL
+    int16_t block_size;         // Samples per block (power of two)
+    int16_t log2_block;
+
+    // Ping-pong output blocks: the spectrum stage and readers see the
+    // completed half while the other one is filled
+    int16_t *blocks[2];
+    int16_t active;             // Half written by the next block
+    int16_t *in_block;          // Block popped from the input ring
+    complex_t *spectrum;        // Spectrum stage work buffer
+    int16_t *power_spectrum;    // Latest power spectrum (block_size / 2 bins, dB)
+    uint32_t spectrum_count;    // Spectra produced so far
+    tone_bank_t *tones;         // Goertzel bank standing in for the FFT, or NULL
+
+    // Instrumentation
+    uint32_t *timestamps;       // Enqueue time of each block's first sample
+    uint16_t timestamp_mask;
+    volatile uint32_t overruns;     // ADC samples dropped on a full input ring
+    volatile uint32_t underruns;    // DAC reads from an empty output ring
+    uint32_t blocks_processed;
+    uint32_t max_latency;       // Worst first-sample enqueue to block output, in stream_time units
+    uint32_t max_process_time;  // Worst time spent on one block
+
+    arena_t *arena;             // Where the buffers came from (NULL: heap)
+} stream_pipeline_t;
+
+// Allocate the rings and blocks; ring_capacity is a power-of-two multiple
+// of block_size. No allocation happens after this call.
+#if !defined(DSP_NO_MALLOC)
+void stream_init(stream_pipeline_t *pipe, fir_filter_t *fir, fft_t *fft, int16_t block_size, uint16_t ring_capacity);
+#endif
+
+// Same, with the buffers taken from an arena; 0 if they do not fit. The
+// arena must hold stream_workspace_size bytes, where watch_count is the bin
+// count later passed to stream_watch_bins (0 if it is not called).
+int16_t stream_init_arena(stream_pipeline_t *pipe, fir_filter_t *fir, fft_t *fft, int16_t block_size,
+                          uint16_t ring_capacity, arena_t *arena);
+uint32_t stream_workspace_size(int16_t block_size, uint16_t ring_capacity, int16_t has_fft, int16_t watch_count);
+void stream_cleanup(stream_pipeline_t *pipe);
+
+// Spectrum stage only needs power at these bins (of block_size): when a
+// Goertzel bank over the bins costs less than the FFT, the stage switches
+// to it and power_spectrum holds just those bins, the rest read 0 dB.
+// Returns 1 if the bank was selected. Call after stream_init with a plan,
+// before streaming starts, since the bank is allocated here (from the
+// pipeline's arena, if it has one).
+int16_t stream_watch_bins(stream_pipeline_t *pipe, const int16_t *bins, int16_t count);
+
+// Interrupt side: one sample in, one sample out
+void stream_isr_push(stream_pipeline_t *pipe, int16_t sample);
+int16_t stream_isr_pop(stream_pipeline_t *pipe);
+
+// DMA interrupt side: enqueue a received half and refill a drained half
+// (either may be NULL), length samples each
+void stream_dma_block(stream_pipeline_t *pipe, const int16_t *rx, int16_t *tx, uint16_t length);
+
+// Deferred consumer: process every complete block; returns blocks processed
+int16_t stream_process(stream_pipeline_t *pipe);
+
+// Most recently completed filtered block
+const int16_t *stream_last_block(const stream_pipeline_t *pipe);
+
+// Free-running time base: cycle CSR on the target, nanoseconds on the host
+uint32_t stream_time(void);
+
+#endif // STREAM_H
@@ -0,0 +1,397 @@
+//=============================================================================
+// Tone Detector Bank for RISC-V DSP Processor
+// Goertzel and sliding DFT power at selected bins, without a full FFT
+//=============================================================================
+
+#include "dsp_math.h"
+#include "tone_detector.h"
+
+// Fractional bits of the Goertzel input and state
+#define GOERTZEL_FRAC_BITS 8
+
+// pi / 2 in Q30
+#define HALF_PI_Q30 1686629713
+
+static int16_t log2_ceil(int32_t n) {
+    int16_t bits = 0;
+    while ((1 << bits) < n) {
+        bits++;
+    }
+    return bits;
+}
+
+// |(re + j im) * 2^exponent|^2 in dB, scaled as fft_power_spectrum: both
+// parts are brought into 16 bits and the shift is added to the exponent.
+// 771 is 10 * log10(2) in Q8.
+static int16_t tone_power_db(int64_t re, int64_t im, int16_t exponent) {
+    while (re > 32767 || re < -32768 || im > 32767 || im < -32768) {
+        re >>= 1;
+        im >>= 1;
+        exponent++;
+    }
+    uint32_t power = (uint32_t)mac(0, (int16_t)re, (int16_t)re) + (uint32_t)mac(0, (int16_t)im, (int16_t)im);
+    int64_t log2_power = log2_q16(power + 1) + (int32_t)exponent * 131072;
+    return (int16_t)((log2_power * 771 + (1 << 23)) >> 24);
+}
+
+// cos and sin of a binary angle (2^32 per turn) in Q30, from the Taylor
+// series on the nearer half of the quadrant. Used once per bin at set-up,
+// where cos_16 (Q15, saturating at 32767) is too coarse for the Goertzel
+// coefficient at long blocks.
+static void sincos_q30(uint32_t angle, int32_t *cos_out, int32_t *sin_out) {
+    uint32_t quadrant = angle >> 30;
+    uint32_t fraction = angle & 0x3fffffff;
+    int16_t swap = fraction > 0x20000000;
+    if (swap) {
+        fraction = 0x40000000 - fraction;
+    }
+
+    // x in Q30 radians, at most pi / 4
+    int64_t x = ((int64_t)fraction * HALF_PI_Q30) >> 30;
+    int64_t x2 = (x * x) >> 30;
+    int64_t c = 1 << 30, s = x;
+    int64_t c_term = 1 << 30, s_term = x;
+    for (int k = 1; k <= 6; k++) {
+        c_term = -((c_term * x2) >> 30) / ((2 * k - 1) * (2 * k));
+        s_term = -((s_term * x2) >> 30) / ((2 * k) * (2 * k + 1));
+        c += c_term;
+        s += s_term;
+    }
+    if (swap) {
+        int64_t t = c;
+        c = s;
+        s = t;
+    }
+
+    switch (quadrant) {
+    case 0:  *cos_out = (int32_t)c;  *sin_out = (int32_t)s;  break;
+    case 1:  *cos_out = (int32_t)-s; *sin_out = (int32_t)c;  break;
+    case 2:  *cos_out = (int32_t)-c; *sin_out = (int32_t)-s; break;
+    default: *cos_out = (int32_t)s;  *sin_out = (int32_t)-c; break;
+    }
+}
+
+// Bytes tone_bank_init_arena takes
+uint32_t tone_bank_workspace_size(int16_t mode, int16_t bin_count, int16_t block_size) {
+    uint32_t bytes = 2 * ARENA_BLOCK_SIZE(bin_count * sizeof(int16_t));
+
+    if (mode == TONE_GOERTZEL) {
+        bytes += ARENA_BLOCK_SIZE(2 * bin_count * sizeof(int32_t)) +
+                 ARENA_BLOCK_SIZE(2 * bin_count * sizeof(int64_t)) +
+                 ARENA_BLOCK_SIZE(block_size * sizeof(int32_t));
+    } else {
+        bytes += ARENA_BLOCK_SIZE(block_size * sizeof(complex_t)) +
+                 ARENA_BLOCK_SIZE(bin_count * sizeof(int16_t)) +
+                 ARENA_BLOCK_SIZE(2 * bin_count * sizeof(int64_t)) +
+                 ARENA_BLOCK_SIZE(block_size * sizeof(int16_t));
+    }
+    return bytes;
+}
+
+#if !defined(DSP_NO_MALLOC)
+// Initialize bank
+void tone_bank_init(tone_bank_t *bank, int16_t mode, const int16_t *bins, int16_t bin_count,
+                    int16_t block_size, const int16_t *window) {
+    tone_bank_init_arena(bank, mode, bins, bin_count, block_size, window, NULL);
+}
+#endif
+
+// Initialize bank from an arena (or the heap for NULL)
+int16_t tone_bank_init_arena(tone_bank_t *bank, int16_t mode, const int16_t *bins, int16_t bin_count,
+                             int16_t block_size, const int16_t *window, arena_t *arena) {
+    uint32_t mark = arena_mark(arena);
+
+    bank->arena = arena;
+    bank->mode = mode;
+    bank->bin_count = bin_count;
+    bank->block_size = block_size;
+    bank->window = (mode == TONE_GOERTZEL) ? window : NULL;
+
+    bank->bins = (int16_t*)dsp_alloc(arena, bin_count * sizeof(int16_t));
+    bank->power = (int16_t*)dsp_alloc(arena, bin_count * sizeof(int16_t));
+    bank->coeffs = NULL;
+    bank->state = NULL;
+    bank->scratch = NULL;
+    bank->table = NULL;
+    bank->phase = NULL;
+    bank->sums = NULL;
+    bank->history = NULL;
+
+    if (mode == TONE_GOERTZEL) {
+        bank->coeffs = (int32_t*)dsp_alloc(arena, 2 * bin_count * sizeof(int32_t));
+        bank->state = (int64_t*)dsp_alloc(arena, 2 * bin_count * sizeof(int64_t));
+        bank->scratch = (int32_t*)dsp_alloc(arena, block_size * sizeof(int32_t));
+    } else {
+        bank->table = (complex_t*)dsp_alloc(arena, block_size * sizeof(complex_t));
+        bank->phase = (int16_t*)dsp_alloc(arena, bin_count * sizeof(int16_t));
+        bank->sums = (int64_t*)dsp_alloc(arena, 2 * bin_count * sizeof(int64_t));
+        bank->history = (int16_t*)dsp_alloc(arena, block_size * sizeof(int16_t));
+    }
+    if (!bank->bins || !bank->power ||
+        (mode == TONE_GOERTZEL ? !bank->coeffs || !bank->state || !bank->scratch
+                               : !bank->table || !bank->phase || !bank->sums || !bank->history)) {
+        tone_bank_cleanup(bank);
+        arena_release(arena, mark);
+        return 0;
+    }
+
+    for (int b = 0; b < bin_count; b++) {
+        bank->bins[b] = (int16_t)(bins[b] % block_size);
+    }
+
+    if (mode == TONE_GOERTZEL) {
+        for (int b = 0; b < bin_count; b++) {
+            uint32_t angle = (uint32_t)(((uint64_t)bank->bins[b] << 32) / block_size);
+            sincos_q30(angle, &bank->coeffs[2 * b], &bank->coeffs[2 * b + 1]);
+        }
+    } else {
+        for (int m = 0; m < block_size; m++) {
+            int16_t angle = (int16_t)(((int32_t)m << 16) / block_size);
+            bank->table[m].real = cos_16(angle);
+            bank->table[m].imag = (int16_t)-sin_16(angle);
+        }
+    }
+
+    tone_bank_reset(bank);
+    return 1;
+}
+
+void tone_bank_reset(tone_bank_t *bank) {
+    bank->position = 0;
+    bank->update_count = 0;
+
+    for (int b = 0; b < bank->bin_count; b++) {
+        bank->power[b] = 0;
+        if (bank->mode == TONE_GOERTZEL) {
+            bank->state[2 * b] = 0;
+            bank->state[2 * b + 1] = 0;
+        } else {
+            bank->phase[b] = 0;
+            bank->sums[2 * b] = 0;
+            bank->sums[2 * b + 1] = 0;
+        }
+    }
+    if (bank->mode == TONE_SLIDING_DFT) {
+        for (int m = 0; m < bank->block_size; m++) {
+            bank->history[m] = 0;
+        }
+    }
+}
+
+//=============================================================================
+// Goertzel: s[n] = x[n] + 2 cos(w) s[n - 1] - s[n - 2] over one block, then
+// |X(k)|^2 = |s[N - 1] - e^(-jw) s[N - 2]|^2. cos(w) and sin(w) are Q30 and
+// the state is 64-bit with GOERTZEL_FRAC_BITS fractional bits: near DC it
+// grows as N^2 / 2 times the input, 2^50 for a full-scale 16384-point block,
+// so no input shift is needed and small tones keep their precision.
+//=============================================================================
+
+// Input sample as it enters the recursion: windowed, GOERTZEL_FRAC_BITS
+static inline int32_t goertzel_input(const tone_bank_t *bank, int16_t sample, int16_t n) {
+    if (bank->window) {
+        int16_t shift = 15 - GOERTZEL_FRAC_BITS;
+        return ((int32_t)sample * bank->window[n] + (1 << (shift - 1))) >> shift;
+    }
+    return (int32_t)sample << GOERTZEL_FRAC_BITS;
+}
+
+// Rounded s * c / 2^shift for a state s and a Q30 coefficient c, as two
+// 32 x 32-bit products so nothing overflows 64 bits
+static inline int64_t goertzel_mul(int64_t s, int32_t c, int16_t shift) {
+    int64_t mask = ((int64_t)1 << shift) - 1;
+    return (s >> shift) * c + (((s & mask) * c + ((int64_t)1 << (shift - 1))) >> shift);
+}
+
+// 2 cos(w) s1 is the Q30 cosine over a 29-bit shift
+static inline int64_t goertzel_step(int64_t x, int32_t cos_w, int64_t s1, int64_t s2) {
+    return x + goertzel_mul(s1, cos_w, 29) - s2;
+}
+
+// End of block: store the powers and restart the recursion
+static void goertzel_finish(tone_bank_t *bank) {
+    for (int b = 0; b < bank->bin_count; b++) {
+        int64_t s1 = bank->state[2 * b];
+        int64_t s2 = bank->state[2 * b + 1];
+        int64_t re = s1 - goertzel_mul(s2, bank->coeffs[2 * b], 30);
+        int64_t im = goertzel_mul(s2, bank->coeffs[2 * b + 1], 30);
+        bank->power[b] = tone_power_db(re, im, -GOERTZEL_FRAC_BITS);
+        bank->state[2 * b] = 0;
+        bank->state[2 * b + 1] = 0;
+    }
+    bank->position = 0;
+    bank->update_count++;
+}
+
+//=============================================================================
+// Sliding DFT, modulated form: Y(k) += (x[n] - x[n - N]) e^(-j 2 pi k n / N).
+// The twiddle is periodic in N, so the sample leaving the window is removed
+// with exactly the term it was added with; the 64-bit sums are exact and
+// never drift. |Y(k)| is |X(k)| over the last N samples.
+//=============================================================================
+
+static inline void sliding_dft_step(tone_bank_t *bank, int16_t sample) {
+    int32_t delta = (int32_t)sample - bank->history[bank->position];
+    int16_t block_size = bank->block_size;
+
+    bank->history[bank->position] = sample;
+    if (++bank->position == block_size) {
+        bank->position = 0;
+    }
+
+    for (int b = 0; b < bank->bin_count; b++) {
+        const complex_t w = bank->table[bank->phase[b]];
+        bank->sums[2 * b] += (int64_t)delta * w.real;
+        bank->sums[2 * b + 1] += (int64_t)delta * w.imag;
+
+        int16_t next = bank->phase[b] + bank->bins[b];
+        bank->phase[b] = (next >= block_size) ? next - block_size : next;
+    }
+}
+
+// Process one sample
+int16_t tone_bank_push(tone_bank_t *bank, int16_t sample) {
+    if (bank->mode == TONE_SLIDING_DFT) {
+        sliding_dft_step(bank, sample);
+        return 0;
+    }
+
+    int32_t x = goertzel_input(bank, sample, bank->position);
+    for (int b = 0; b < bank->bin_count; b++) {
+        int64_t *s = &bank->state[2 * b];
+        int64_t s0 = goertzel_step(x, bank->coeffs[2 * b], s[0], s[1]);
+        s[1] = s[0];
+        s[0] = s0;
+    }
+    if (++bank->position == bank->block_size) {
+        goertzel_finish(bank);
+        return 1;
+    }
+    return 0;
+}
+
+// Process a block. Goertzel runs over each stretch of the current block a
+// pair of bins at a time, so the recursion state stays in registers.
+int16_t tone_bank_process(tone_bank_t *bank, const int16_t *input, int16_t length) {
+    if (bank->mode == TONE_SLIDING_DFT) {
+        for (int n = 0; n < length; n++) {
+            sliding_dft_step(bank, input[n]);
+        }
+        tone_bank_power(bank);
+        return 1;
+    }
+
+    int16_t updates = 0;
+    int n = 0;
+    while (n < length) {
+        int16_t start = bank->position;
+        int16_t count = bank->block_size - start;
+        if (count > length - n) {
+            count = length - n;
+        }
+
+        for (int i = 0; i < count; i++) {
+            bank->scratch[i] = goertzel_input(bank, input[n + i], start + i);
+        }
+        // Bins in pairs: each recursion is one serial chain, two of them
+        // interleaved keep the multiplier busy
+        int b = 0;
+        for (; b + 1 < bank->bin_count; b += 2) {
+            int32_t coeff_a = bank->coeffs[2 * b];
+            int32_t coeff_b = bank->coeffs[2 * b + 2];
+            int64_t *s = &bank->state[2 * b];
+            int64_t a1 = s[0], a2 = s[1], b1 = s[2], b2 = s[3];
+            for (int i = 0; i < count; i++) {
+                int64_t a0 = goertzel_step(bank->scratch[i], coeff_a, a1, a2);
+                int64_t b0 = goertzel_step(bank->scratch[i], coeff_b, b1, b2);
+                a2 = a1;
+                a1 = a0;
+                b2 = b1;
+                b1 = b0;
+            }
+            s[0] = a1;
+            s[1] = a2;
+            s[2] = b1;
+            s[3] = b2;
+        }
+        if (b < bank->bin_count) {
+            int32_t coeff = bank->coeffs[2 * b];
+            int64_t s1 = bank->state[2 * b];
+            int64_t s2 = bank->state[2 * b + 1];
+            for (int i = 0; i < count; i++) {
+                int64_t s0 = goertzel_step(bank->scratch[i], coeff, s1, s2);
+                s2 = s1;
+                s1 = s0;
+            }
+            bank->state[2 * b] = s1;
+            bank->state[2 * b + 1] = s2;
+        }
+
+        n += count;
+        bank->position = start + count;
+        if (bank->position == bank->block_size) {
+            goertzel_finish(bank);
+            updates++;
+        }
+    }
+    return updates;
+}
+
+const int16_t *tone_bank_power(tone_bank_t *bank) {
+    if (bank->mode == TONE_SLIDING_DFT) {
+        for (int b = 0; b < bank->bin_count; b++) {
+            bank->power[b] = tone_power_db(bank->sums[2 * b], bank->sums[2 * b + 1], -15);
+        }
+        bank->update_count++;
+    }
+    return bank->power;
+}
+
+// Cleanup bank resources
+void tone_bank_cleanup(tone_bank_t *bank) {
+    dsp_free(bank->arena, bank->bins);
+    dsp_free(bank->arena, bank->power);
+    dsp_free(bank->arena, bank->coeffs);
+    dsp_free(bank->arena, bank->state);
+    dsp_free(bank->arena, bank->scratch);
+    dsp_free(bank->arena, bank->table);
+    dsp_free(bank->arena, bank->phase);
+    dsp_free(bank->arena, bank->sums);
+    dsp_free(bank->arena, bank->history);
+    bank->bins = NULL;
+    bank->power = NULL;
+    bank->coeffs = NULL;
+    bank->state = NULL;
+    bank->scratch = NULL;
+    bank->table = NULL;
+    bank->phase = NULL;
+    bank->sums = NULL;
+    bank->history = NULL;
+}
+
+//=============================================================================
+// Cost model
+//=============================================================================
+
+// Goertzel: two MACs per bin per sample (the Q30 coefficient times the
+// 64-bit state, split in two), plus the window and four MACs per bin of
+// readout. Sliding DFT: two MACs per bin per sample, one readout.
+int32_t tone_bank_cost(int16_t mode, int16_t bin_count, int16_t block_size, int16_t windowed) {
+    int32_t readout = 4 * (int32_t)bin_count;
+
+    if (mode == TONE_SLIDING_DFT) {
+        return 2 * (int32_t)bin_count * block_size + readout;
+    }
+    return 2 * (int32_t)bin_count * block_size + (windowed ? block_size : 0) + readout;
+}
+
+// fft_real (N log2 N) plus fft_power_spectrum (two MACs per bin, N / 2 bins)
+int32_t tone_fft_cost(int16_t block_size) {
+    return (int32_t)block_size * log2_ceil(block_size) + block_size;
+}
+
+int16_t tone_bank_preferred(int16_t mode, int16_t bin_count, int16_t block_size, int16_t windowed) {
+    if (block_size < 1 || block_size > TONE_MAX_BLOCK_SIZE) {
+        return 0;
+    }
+    return tone_bank_cost(mode, bin_count, block_size, windowed) < tone_fft_cost(block_size);
+}
@@ -0,0 +1,85 @@
+//=============================================================================
+// Tone Detector Bank for RISC-V DSP Processor
+// Goertzel and sliding DFT power at selected bins, without a full FFT
+//=============================================================================
+
+#ifndef TONE_DETECTOR_H
+#define TONE_DETECTOR_H
+
+#include <stdint.h>
+#include "fft.h"
+
+// Bank modes
+#define TONE_GOERTZEL 0         // One result per block_size samples, optional window
+#define TONE_SLIDING_DFT 1      // Result over the last block_size samples, any time
+
+// Longest block the bank handles (and the cost model will pick it for)
+#define TONE_MAX_BLOCK_SIZE 16384
+
+// Tone detector bank. Bin k is the DFT bin of a block_size-point transform,
+// k * sample_rate / block_size Hz. Powers are in dB on the same scale as
+// fft_power_spectrum, so a bank can stand in for the FFT at the bins it
+// watches. Each sample costs two MACs per bin in either mode: the Q30
+// Goertzel coefficient takes two halves, the sliding DFT one per real and
+// imaginary sum.
+typedef struct {
+    int16_t mode;               // TONE_GOERTZEL or TONE_SLIDING_DFT
+    int16_t bin_count;          // Number of watched bins
+    int16_t block_size;         // Transform length N
+    int16_t position;           // Samples into the block (Goertzel) or history index (sliding DFT)
+    const int16_t *window;      // Q15 window of block_size (Goertzel), or NULL
+    int16_t *bins;              // Watched bins
+    int32_t *coeffs;            // Per bin cos, sin(2 pi k / N) in Q30 (Goertzel)
+    int64_t *state;             // Per bin s[n - 1], s[n - 2] (Goertzel)
+    complex_t *table;           // e^(-j 2 pi m / N) for m < N (sliding DFT)
+    int16_t *phase;             // Per bin k * n mod N (sliding DFT)
+    int64_t *sums;              // Per bin real, imaginary running sums (sliding DFT)
+    int16_t *history;           // Last N samples (sliding DFT)
+    int32_t *scratch;           // Windowed block, recursion input format (Goertzel)
+    int16_t *power;             // Latest power per bin, dB
+    uint32_t update_count;      // Completed Goertzel blocks / sliding DFT refreshes
+    arena_t *arena;             // Where the buffers came from (NULL: heap)
+} tone_bank_t;
+
+// Allocate the tables and clear the state. window is borrowed, for example
+// from hamming_window_16 or hanning_window_16, and ignored by the sliding
+// DFT (whose window is rectangular). block_size may be any length up to
+// TONE_MAX_BLOCK_SIZE.
+#if !defined(DSP_NO_MALLOC)
+void tone_bank_init(tone_bank_t *bank, int16_t mode, const int16_t *bins, int16_t bin_count,
+                    int16_t block_size, const int16_t *window);
+#endif
+
+// Same, with the buffers (tone_bank_workspace_size bytes) taken from an
+// arena; 0 if they do not fit
+int16_t tone_bank_init_arena(tone_bank_t *bank, int16_t mode, const int16_t *bins, int16_t bin_count,
+                             int16_t block_size, const int16_t *window, arena_t *arena);
+uint32_t tone_bank_workspace_size(int16_t mode, int16_t bin_count, int16_t block_size);
+
+void tone_bank_cleanup(tone_bank_t *bank);
+
+// Clear the state and restart the block
+void tone_bank_reset(tone_bank_t *bank);
+
+// One sample. Goertzel returns 1 when it completes a block and refreshes
+// power[]; the sliding DFT returns 0 and refreshes on tone_bank_power.
+int16_t tone_bank_push(tone_bank_t *bank, int16_t sample);
+
+// A block of samples, bit-exact with tone_bank_push. Returns the number of
+// times power[] was refreshed: the Goertzel blocks completed, or 1 for the
+// sliding DFT, which refreshes at the end of the call.
+int16_t tone_bank_process(tone_bank_t *bank, const int16_t *input, int16_t length);
+
+// Recompute power[] from the sliding DFT sums (no-op for Goertzel)
+const int16_t *tone_bank_power(tone_bank_t *bank);
+
+// Cost model in MACs per block_size samples: the bank in 'mode' against
+// fft_real plus fft_power_spectrum on the same block. The radix-2 count
+// follows the benchmark's N log2(N) for a real-input transform.
+int32_t tone_bank_cost(int16_t mode, int16_t bin_count, int16_t block_size, int16_t windowed);
+int32_t tone_fft_cost(int16_t block_size);
+
+// 1 when a bank in 'mode' is cheaper than the FFT path for these bins
+int16_t tone_bank_preferred(int16_t mode, int16_t bin_count, int16_t block_size, int16_t windowed);
+
+#endif // TONE_DETECTOR_H
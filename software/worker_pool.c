@@ -0,0 +1,193 @@
+//=============================================================================
+// Worker Pool for RISC-V DSP Processor
+// Fixed set of host threads that split batched kernels by index range
+//=============================================================================
+
+#include "worker_pool.h"
+
+#if defined(__riscv)
+
+// Single-core target: everything runs on the caller
+int16_t worker_pool_init(int16_t thread_count) {
+    (void)thread_count;
+    return 1;
+}
+
+void worker_pool_shutdown(void) {
+}
+
+int16_t worker_pool_size(void) {
+    return 1;
+}
+
+void worker_pool_run(worker_task_t task, void *arg, int32_t count) {
+    task(arg, 0, count);
+}
+
+void worker_pool_run_aligned(worker_task_t task, void *arg, int32_t count, int32_t grain) {
+    (void)grain;
+    task(arg, 0, count);
+}
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+// Pool state. Workers sleep on 'start' until the generation changes, run
+// their slice, and the last one to finish signals 'done'.
+static struct {
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    int16_t thread_count;       // Pool members including the caller
+    int16_t running;            // 1 while worker threads exist
+    uint32_t generation;        // Incremented for every batch and for shutdown
+    uint32_t init_generation;   // Generation when the threads were started
+    int16_t pending;            // Workers still busy with this generation
+    int16_t stop;               // Shutdown requested
+    worker_task_t task;
+    void *arg;
+    int32_t count;
+    int32_t grain;              // Slices start on multiples of this
+} pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+    .thread_count = 1
+};
+
+// Slice w of n over [0, count), split in whole units of grain items
+static void run_slice(int16_t w, int16_t n, worker_task_t task, void *arg, int32_t count, int32_t grain) {
+    int32_t units = (count + grain - 1) / grain;
+    int32_t begin = (int32_t)((int64_t)units * w / n) * grain;
+    int32_t end = (int32_t)((int64_t)units * (w + 1) / n) * grain;
+    if (end > count) {
+        end = count;
+    }
+    if (begin < end) {
+        task(arg, begin, end);
+    }
+}
+
+static void *worker_main(void *param) {
+    int16_t id = (int16_t)(intptr_t)param;
+    pthread_mutex_lock(&pool.lock);
+    uint32_t seen = pool.init_generation;
+    for (;;) {
+        while (pool.generation == seen) {
+            pthread_cond_wait(&pool.start, &pool.lock);
+        }
+        seen = pool.generation;
+        if (pool.stop) {
+            break;
+        }
+
+        worker_task_t task = pool.task;
+        void *arg = pool.arg;
+        int32_t count = pool.count;
+        int32_t grain = pool.grain;
+        int16_t n = pool.thread_count;
+        pthread_mutex_unlock(&pool.lock);
+
+        run_slice(id, n, task, arg, count, grain);
+
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.pending == 0) {
+            pthread_cond_signal(&pool.done);
+        }
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+// Start the worker threads. If a thread cannot be created the pool keeps
+// the ones already running; slices are only handed to started threads.
+int16_t worker_pool_init(int16_t thread_count) {
+    if (pool.running) {
+        return pool.thread_count;
+    }
+
+    if (thread_count <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = (cores > 0) ? (int16_t)cores : 1;
+    }
+    if (thread_count > WORKER_POOL_MAX_THREADS) {
+        thread_count = WORKER_POOL_MAX_THREADS;
+    }
+
+    pool.stop = 0;
+    pool.init_generation = pool.generation;
+    int16_t started = 1;
+    while (started < thread_count &&
+           pthread_create(&pool.threads[started], NULL, worker_main, (void*)(intptr_t)started) == 0) {
+        started++;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.thread_count = started;
+    pool.running = 1;
+    pthread_mutex_unlock(&pool.lock);
+    return started;
+}
+
+// Stop and join the worker threads
+void worker_pool_shutdown(void) {
+    if (!pool.running) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int16_t i = 1; i < pool.thread_count; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+    pool.thread_count = 1;
+    pool.running = 0;
+}
+
+int16_t worker_pool_size(void) {
+    return pool.thread_count;
+}
+
+// Run one batch across the pool; the caller takes slice 0
+void worker_pool_run_aligned(worker_task_t task, void *arg, int32_t count, int32_t grain) {
+    int16_t n = pool.thread_count;
+
+    if (grain < 1) {
+        grain = 1;
+    }
+    if (!pool.running || n == 1 || count <= grain) {
+        task(arg, 0, count);
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.task = task;
+    pool.arg = arg;
+    pool.count = count;
+    pool.grain = grain;
+    pool.pending = n - 1;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+    pthread_mutex_unlock(&pool.lock);
+
+    run_slice(0, n, task, arg, count, grain);
+
+    pthread_mutex_lock(&pool.lock);
+    while (pool.pending > 0) {
+        pthread_cond_wait(&pool.done, &pool.lock);
+    }
+    pthread_mutex_unlock(&pool.lock);
+}
+
+void worker_pool_run(worker_task_t task, void *arg, int32_t count) {
+    worker_pool_run_aligned(task, arg, count, 1);
+}
+
+#endif
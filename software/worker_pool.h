@@ -0,0 +1,33 @@
+//=============================================================================
+// Worker Pool for RISC-V DSP Processor
+// Fixed set of host threads that split batched kernels by index range
+//=============================================================================
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdint.h>
+
+// Most threads the pool will start
+#define WORKER_POOL_MAX_THREADS 64
+
+// Task body: process items [begin, end) of the batch
+typedef void (*worker_task_t)(void *arg, int32_t begin, int32_t end);
+
+// Start the pool; thread_count 0 uses one thread per online core. Returns
+// the pool size, which is smaller than requested if the system refuses to
+// start more threads. On the target (no threads) the pool has a single
+// member: the caller.
+int16_t worker_pool_init(int16_t thread_count);
+void worker_pool_shutdown(void);
+int16_t worker_pool_size(void);
+
+// Split [0, count) into one contiguous range per thread and wait for all of
+// them. Runs inline when the pool is not started or count is 1.
+void worker_pool_run(worker_task_t task, void *arg, int32_t count);
+
+// As worker_pool_run, but every range starts on a multiple of grain, so
+// slices of interleaved data can be kept on separate cache lines
+void worker_pool_run_aligned(worker_task_t task, void *arg, int32_t count, int32_t grain);
+
+#endif // WORKER_POOL_H
@@ -0,0 +1,94 @@
+//=============================================================================
+// Address Generator for RISC-V DSP Processor
+// Post-increment pointer updates with linear, circular and bit-reversed modes
+//=============================================================================
+//
+// CSR map (read/write):
+//   0x800 addr_base   Buffer base for circular and bit-reversed accesses
+//   0x801 addr_size   Circular buffer size in bytes
+//   0x802 addr_brev   Bit-reversed index width (log2 of the FFT size)
+//
+// Modes (imm[11:10] of the post-increment loads and stores):
+//   00 linear         access ptr,                          ptr += step
+//   01 circular       access ptr,                          ptr += step, wrapped into the buffer
+//   10 bit-reversed   access base + rev(ptr - base) bits,  ptr += step
+
+module address_generator (
+    input wire clk,
+    input wire rst_n,
+
+    // Pointer update, computed in EX
+    input wire [31:0] ptr,              // Address register (rs1)
+    input wire [9:0]  step,             // Signed step in bytes
+    input wire [1:0]  mode,             // Addressing mode
+    output reg [31:0] ptr_next,         // Updated address register
+
+    // Buffer configuration for memory_interface
+    output reg [31:0] base_addr,        // addr_base
+    output reg [31:0] buffer_size,      // addr_size
+    output reg [4:0]  fft_size_log2,    // addr_brev
+
+    // CSR port
+    input wire [11:0] csr_addr,         // CSR address
+    input wire        csr_write,        // Write in EX
+    input wire [1:0]  csr_op,           // 01: write, 10: set, 11: clear
+    input wire [31:0] csr_wdata,        // Write operand (rs1 or uimm)
+    output reg [31:0] csr_rdata,        // Read data
+    output reg        csr_valid         // Address is an addressing CSR
+);
+
+    reg [31:0] step32;
+    reg [31:0] stepped;
+    reg [31:0] written;
+
+    // Step the pointer; circular mode wraps once, so |step| <= addr_size
+    always @(*) begin
+        step32 = {{22{step[9]}}, step};
+        stepped = ptr + step32;
+        ptr_next = stepped;
+        if (mode == 2'b01) begin
+            if (!step[9] && stepped >= base_addr + buffer_size) begin
+                ptr_next = stepped - buffer_size;
+            end else if (step[9] && stepped < base_addr) begin
+                ptr_next = stepped + buffer_size;
+            end
+        end
+    end
+
+    // CSR read mux
+    always @(*) begin
+        csr_valid = 1'b1;
+        case (csr_addr)
+            12'h800: csr_rdata = base_addr;
+            12'h801: csr_rdata = buffer_size;
+            12'h802: csr_rdata = {27'h0, fft_size_log2};
+            default: begin
+                csr_rdata = 32'h0;
+                csr_valid = 1'b0;
+            end
+        endcase
+
+        case (csr_op)
+            2'b10:   written = csr_rdata | csr_wdata;
+            2'b11:   written = csr_rdata & ~csr_wdata;
+            default: written = csr_wdata;
+        endcase
+    end
+
+    // CSR writes
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            base_addr <= 32'h0;
+            buffer_size <= 32'h0;
+            fft_size_log2 <= 5'h0;
+        end else if (csr_write) begin
+            case (csr_addr)
+                12'h800: base_addr <= written;
+                12'h801: buffer_size <= written;
+                12'h802: fft_size_log2 <= written[4:0];
+                default: ;
+            endcase
+        end
+    end
+
+endmodule
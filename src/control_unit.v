@@ -29,13 +29,35 @@ module control_unit (
     output reg        wb_flush,      // WB stage flush
     output reg [1:0]  forward_a,     // Forwarding for operand A
     output reg [1:0]  forward_b,     // Forwarding for operand B
-    output reg        hazard_detected // Hazard detection flag
+    output reg        hazard_detected, // Hazard detection flag
+    output reg        load_use_stall,  // Stall caused by a load-use hazard
+    output reg        raw_stall,       // Stall caused by any other RAW hazard on EX
+    
+    // Hardware loops
+    input wire [31:0] pc_fetch,      // PC being fetched
+    input wire        loop_setup,    // Loop setup instruction in EX
+    input wire        loop_level,    // Level being set up (0: inner, 1: outer)
+    input wire [31:0] loop_start_in, // First instruction of the body
+    input wire [31:0] loop_end_in,   // Last instruction of the body
+    input wire [31:0] loop_count_in, // Iteration count
+    output reg        loop_taken,    // Fetch redirected to a loop start
+    output reg [31:0] loop_target,   // Loop start address
+    output wire       loop_refetch,  // Short body: refetch from the loop start
+    
+    // Post-increment address updates (second write port)
+    input wire        ptr_write_mem, // Address register update in MEM stage
+    input wire [4:0]  ptr_rd_mem,    // Updated address register in MEM stage
+    input wire        ptr_write_wb,  // Address register update in WB stage
+    input wire [4:0]  ptr_rd_wb,     // Updated address register in WB stage
+    output reg [1:0]  forward_ptr_a, // Address update forwarding for operand A
+    output reg [1:0]  forward_ptr_b  // Address update forwarding for operand B
 );
 
     // Internal signals
     wire [4:0] rs1, rs2;
     wire [4:0] rd;
     wire reg_write, mem_read, branch, jump;
+    wire load_use_hazard;
     
     // Extract instruction fields
     assign rs1 = instruction[19:15];
@@ -54,12 +76,14 @@ module control_unit (
     assign branch = (instruction[6:0] == 7'b1100011);
     assign jump = (instruction[6:0] == 7'b1101111) || (instruction[6:0] == 7'b1100111);
     
+    // Load-use hazard: Load instruction followed by instruction that uses the result
+    assign load_use_hazard = mem_read_ex && ((rs1 == rd_ex) || (rs2 == rd_ex));
+    
     // Hazard detection
     always @(*) begin
         hazard_detected = 1'b0;
         
-        // Load-use hazard: Load instruction followed by instruction that uses the result
-        if (mem_read_ex && ((rs1 == rd_ex) || (rs2 == rd_ex))) begin
+        if (load_use_hazard) begin
             hazard_detected = 1'b1;
         end
         
@@ -89,6 +113,141 @@ module control_unit (
         end
     end
     
+    // Address update forwarding (10: MEM, 01: WB). A result written
+    // through the first port in the same or a younger stage takes priority.
+    always @(*) begin
+        forward_ptr_a = 2'b00;
+        forward_ptr_b = 2'b00;
+        
+        if (ptr_write_mem && ptr_rd_mem != 5'h0 && rs1 == ptr_rd_mem &&
+            !(reg_write_mem && rd_mem == ptr_rd_mem)) begin
+            forward_ptr_a = 2'b10;
+        end else if (ptr_write_wb && ptr_rd_wb != 5'h0 && rs1 == ptr_rd_wb &&
+                     !(reg_write_mem && rd_mem == rs1) && !(reg_write_wb && rd_wb == rs1)) begin
+            forward_ptr_a = 2'b01;
+        end
+        
+        if (ptr_write_mem && ptr_rd_mem != 5'h0 && rs2 == ptr_rd_mem &&
+            !(reg_write_mem && rd_mem == ptr_rd_mem)) begin
+            forward_ptr_b = 2'b10;
+        end else if (ptr_write_wb && ptr_rd_wb != 5'h0 && rs2 == ptr_rd_wb &&
+                     !(reg_write_mem && rd_mem == rs2) && !(reg_write_wb && rd_wb == rs2)) begin
+            forward_ptr_b = 2'b01;
+        end
+    end
+    
+    // Hardware loop registers, one set per nesting level
+    reg [31:0] loop_start [0:1];
+    reg [31:0] loop_end [0:1];
+    reg [31:0] loop_count [0:1];
+    
+    // Loop ends counted down at fetch that are still younger than EX
+    // (fetched, IF, ID), per level. A taken branch or jump squashes them,
+    // so their iterations are given back.
+    reg [1:0]  loop_dec_fetched, loop_dec_if, loop_dec_id;
+    
+    // Loop registers as seen by fetch, including a setup in EX this cycle
+    reg [31:0] start0, end0, count0;
+    reg [31:0] start1, end1, count1;
+    reg        end_hit0, end_hit1;
+    wire       fetch_redirect;
+    wire [1:0] loop_dec;
+    wire [1:0] loop_dec_pending0, loop_dec_pending1;
+    
+    // When the setup reaches EX, fetch is four instructions on. A shorter
+    // body may already have passed its end, so fetch restarts at the loop
+    // start with the new registers in place, at the cost of a flush.
+    assign loop_refetch = loop_setup && (loop_end_in >= loop_start_in) &&
+                          (loop_end_in - loop_start_in < 32'd12);
+    assign fetch_redirect = branch_taken || jump_taken || loop_refetch;
+    
+    always @(*) begin
+        start0 = (loop_setup && !loop_level) ? loop_start_in : loop_start[0];
+        end0   = (loop_setup && !loop_level) ? loop_end_in   : loop_end[0];
+        count0 = (loop_setup && !loop_level) ? loop_count_in : loop_count[0];
+        start1 = (loop_setup && loop_level)  ? loop_start_in : loop_start[1];
+        end1   = (loop_setup && loop_level)  ? loop_end_in   : loop_end[1];
+        count1 = (loop_setup && loop_level)  ? loop_count_in : loop_count[1];
+        
+        end_hit0 = (pc_fetch == end0) && (count0 != 32'h0);
+        end_hit1 = (pc_fetch == end1) && (count1 != 32'h0);
+        
+        // Loop back from the end of the body while iterations remain; the
+        // inner loop wins when both levels end on the same instruction
+        loop_taken = 1'b0;
+        loop_target = start0;
+        if (!fetch_redirect) begin
+            if (end_hit0 && count0 != 32'h1) begin
+                loop_taken = 1'b1;
+                loop_target = start0;
+            end else if (end_hit1 && count1 != 32'h1) begin
+                loop_taken = 1'b1;
+                loop_target = start1;
+            end
+        end
+    end
+    
+    // Levels counted down by the instruction fetched this cycle
+    assign loop_dec[0] = !pc_stall && !fetch_redirect && end_hit0;
+    assign loop_dec[1] = !pc_stall && !fetch_redirect && end_hit1 && !(end_hit0 && count0 != 32'h1);
+    
+    assign loop_dec_pending0 = {1'b0, loop_dec_fetched[0]} + {1'b0, loop_dec_if[0]} + {1'b0, loop_dec_id[0]};
+    assign loop_dec_pending1 = {1'b0, loop_dec_fetched[1]} + {1'b0, loop_dec_if[1]} + {1'b0, loop_dec_id[1]};
+    
+    // Count down an iteration each time the fetch passes a loop end, and
+    // give back the ones squashed by a redirect from EX. A setup replaces
+    // the count, so pending decrements of its level are dropped.
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            loop_start[0] <= 32'h0;
+            loop_end[0] <= 32'h0;
+            loop_count[0] <= 32'h0;
+            loop_start[1] <= 32'h0;
+            loop_end[1] <= 32'h0;
+            loop_count[1] <= 32'h0;
+            loop_dec_fetched <= 2'b00;
+            loop_dec_if <= 2'b00;
+            loop_dec_id <= 2'b00;
+        end else begin
+            if (fetch_redirect) begin
+                if (!(loop_setup && !loop_level)) begin
+                    loop_count[0] <= loop_count[0] + {30'h0, loop_dec_pending0};
+                end
+                if (!(loop_setup && loop_level)) begin
+                    loop_count[1] <= loop_count[1] + {30'h0, loop_dec_pending1};
+                end
+            end
+            if (loop_setup) begin
+                loop_start[loop_level] <= loop_start_in;
+                loop_end[loop_level] <= loop_end_in;
+                loop_count[loop_level] <= loop_count_in;
+            end
+            if (loop_dec[0]) begin
+                loop_count[0] <= count0 - 1;
+            end
+            if (loop_dec[1]) begin
+                loop_count[1] <= count1 - 1;
+            end
+            
+            if (fetch_redirect) begin
+                loop_dec_fetched <= 2'b00;
+                loop_dec_if <= 2'b00;
+                loop_dec_id <= 2'b00;
+            end else begin
+                if (!pc_stall) begin
+                    loop_dec_fetched <= loop_dec;
+                    loop_dec_if <= loop_dec_fetched;
+                    loop_dec_id <= loop_dec_if;
+                end
+                if (loop_setup) begin
+                    loop_dec_fetched[loop_level] <= loop_dec[loop_level];
+                    loop_dec_if[loop_level] <= 1'b0;
+                    loop_dec_id[loop_level] <= 1'b0;
+                end
+            end
+        end
+    end
+    
     // Stall and flush control
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
@@ -103,6 +262,8 @@ module control_unit (
             ex_flush <= 1'b0;
             mem_flush <= 1'b0;
             wb_flush <= 1'b0;
+            load_use_stall <= 1'b0;
+            raw_stall <= 1'b0;
         end else begin
             // Default values
             pc_stall <= 1'b0;
@@ -116,6 +277,9 @@ module control_unit (
             ex_flush <= 1'b0;
             mem_flush <= 1'b0;
             wb_flush <= 1'b0;
+            // Every hazard stall cycle is counted under exactly one cause
+            load_use_stall <= load_use_hazard;
+            raw_stall <= hazard_detected && !load_use_hazard;
             
             // Load-use hazard: Stall IF and ID stages
             if (hazard_detected) begin
@@ -125,8 +289,8 @@ module control_unit (
                 ex_flush <= 1'b1; // Flush EX stage to insert bubble
             end
             
-            // Branch/Jump taken: Flush IF and ID stages
-            if (branch_taken || jump_taken) begin
+            // Branch/Jump taken or loop refetch: Flush IF and ID stages
+            if (fetch_redirect) begin
                 if_flush <= 1'b1;
                 id_flush <= 1'b1;
                 ex_flush <= 1'b1;
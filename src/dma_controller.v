@@ -0,0 +1,213 @@
+//=============================================================================
+// DMA Controller for RISC-V DSP Processor
+// Streams external samples into and out of ping-pong buffers in data memory
+//=============================================================================
+//
+// CSR map (read/write):
+//   0x810 dma_ctrl     [0] rx enable, [1] tx enable, [2] rx irq enable, [3] tx irq enable
+//   0x811 dma_status   [0] rx block done, [1] tx block done, [2] rx half, [3] tx half (read-only),
+//                      [4] rx overrun, [5] tx underrun; clear with csrc
+//   0x812 dma_rx_addr  Receive buffer: ping at addr, pong at addr + 2 * len
+//   0x813 dma_rx_len   Receive block length in halfword samples
+//   0x814 dma_tx_addr  Transmit buffer: ping at addr, pong at addr + 2 * len
+//   0x815 dma_tx_len   Transmit block length in halfword samples
+//
+// Each channel moves one 16-bit sample per transfer. A block done bit is set
+// when a half fills (rx) or drains (tx) and the channel moves to the other
+// half; firmware processes the finished half meanwhile. Disabling a channel
+// restarts it at the ping half.
+//
+// The memory port is shared with the core's load/store port, which has
+// priority: a transfer goes ahead in any cycle the core leaves its bank free.
+// Each channel holds one sample, so a sample that arrives while the previous
+// one is still waiting for the port is dropped and flagged as an overrun.
+
+module dma_controller (
+    input wire clk,
+    input wire rst_n,
+
+    // External stream
+    input wire [31:0] rx_data,          // Sample in ([15:0] used)
+    input wire        rx_valid,         // rx_data holds a new sample
+    output reg [31:0] tx_data,          // Sample out, sign-extended
+    output reg        tx_valid,         // tx_data holds a sample
+    input wire        tx_ready,         // Sink takes tx_data this cycle
+
+    // Data memory port
+    output reg        dma_write,        // Write a receive sample
+    output reg        dma_read,         // Fetch a transmit sample
+    output reg [31:0] dma_addr,         // Halfword address
+    output reg [15:0] dma_wdata,        // Receive sample
+    input wire [31:0] dma_rdata,        // Fetched sample, the cycle after the read
+    input wire        dma_grant,        // Port free this cycle
+
+    // Block-complete interrupt
+    output wire       irq,              // Enabled block done bit set
+    output wire       tx_enable,        // Transmit channel drives the stream
+
+    // CSR port
+    input wire [11:0] csr_addr,         // CSR address
+    input wire        csr_write,        // Write in EX
+    input wire [1:0]  csr_op,           // 01: write, 10: set, 11: clear
+    input wire [31:0] csr_wdata,        // Write operand (rs1 or uimm)
+    output reg [31:0] csr_rdata,        // Read data
+    output reg        csr_valid         // Address is a DMA CSR
+);
+
+    // Descriptor and control registers
+    reg [3:0]  ctrl;
+    reg [5:0]  status;
+    reg [31:0] rx_addr;
+    reg [15:0] rx_len;
+    reg [31:0] tx_addr;
+    reg [15:0] tx_len;
+
+    // Channel state
+    reg [15:0] rx_index;                // Next sample within the rx half
+    reg        rx_half;                 // Half being filled
+    reg        rx_pending;              // Sample waiting for the port
+    reg [15:0] rx_sample;
+    reg [15:0] tx_index;                // Next sample within the tx half
+    reg        tx_half;                 // Half being drained
+    reg        tx_fetch;                // Read granted, data arrives this cycle
+
+    reg [31:0] written;
+    reg        rx_go;
+    reg        tx_go;
+
+    assign tx_enable = ctrl[1];
+    assign irq = (status[0] && ctrl[2]) || (status[1] && ctrl[3]);
+
+    // Memory request: receive first, then refill the transmit register
+    always @(*) begin
+        dma_write = rx_pending;
+        dma_read = !rx_pending && ctrl[1] && !tx_valid && !tx_fetch && tx_len != 16'h0;
+        dma_wdata = rx_sample;
+        if (rx_pending) begin
+            dma_addr = rx_addr + ({rx_half ? rx_len : 16'h0, 1'b0} + {rx_index, 1'b0});
+        end else begin
+            dma_addr = tx_addr + ({tx_half ? tx_len : 16'h0, 1'b0} + {tx_index, 1'b0});
+        end
+        rx_go = dma_write && dma_grant;
+        tx_go = dma_read && dma_grant;
+    end
+
+    // CSR read mux
+    always @(*) begin
+        csr_valid = 1'b1;
+        case (csr_addr)
+            12'h810: csr_rdata = {28'h0, ctrl};
+            12'h811: csr_rdata = {26'h0, status[5:4], tx_half, rx_half, status[1:0]};
+            12'h812: csr_rdata = rx_addr;
+            12'h813: csr_rdata = {16'h0, rx_len};
+            12'h814: csr_rdata = tx_addr;
+            12'h815: csr_rdata = {16'h0, tx_len};
+            default: begin
+                csr_rdata = 32'h0;
+                csr_valid = 1'b0;
+            end
+        endcase
+
+        case (csr_op)
+            2'b10:   written = csr_rdata | csr_wdata;
+            2'b11:   written = csr_rdata & ~csr_wdata;
+            default: written = csr_wdata;
+        endcase
+    end
+
+    // CSR writes
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            ctrl <= 4'h0;
+            rx_addr <= 32'h0;
+            rx_len <= 16'h0;
+            tx_addr <= 32'h0;
+            tx_len <= 16'h0;
+        end else if (csr_write) begin
+            case (csr_addr)
+                12'h810: ctrl <= written[3:0];
+                12'h812: rx_addr <= written;
+                12'h813: rx_len <= written[15:0];
+                12'h814: tx_addr <= written;
+                12'h815: tx_len <= written[15:0];
+                default: ;
+            endcase
+        end
+    end
+
+    // Channels and status. Hardware events win over a status write in the
+    // same cycle, so a block done is never lost to a concurrent clear.
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            status <= 6'h0;
+            rx_index <= 16'h0;
+            rx_half <= 1'b0;
+            rx_pending <= 1'b0;
+            rx_sample <= 16'h0;
+            tx_index <= 16'h0;
+            tx_half <= 1'b0;
+            tx_fetch <= 1'b0;
+            tx_data <= 32'h0;
+            tx_valid <= 1'b0;
+        end else begin
+            if (csr_write && csr_addr == 12'h811) begin
+                status <= {written[5:4], 2'b00, written[1:0]} & status;
+            end
+
+            // Receive: hold the sample until the port is granted
+            if (!ctrl[0] || rx_len == 16'h0) begin
+                rx_index <= 16'h0;
+                rx_half <= 1'b0;
+                rx_pending <= 1'b0;
+            end else begin
+                if (rx_go) begin
+                    if (rx_index == rx_len - 1) begin
+                        rx_index <= 16'h0;
+                        rx_half <= !rx_half;
+                        status[0] <= 1'b1;
+                    end else begin
+                        rx_index <= rx_index + 1;
+                    end
+                end
+                if (rx_valid) begin
+                    if (rx_pending && !rx_go) begin
+                        status[4] <= 1'b1;
+                    end else begin
+                        rx_sample <= rx_data[15:0];
+                        rx_pending <= 1'b1;
+                    end
+                end else if (rx_go) begin
+                    rx_pending <= 1'b0;
+                end
+            end
+
+            // Transmit: one sample prefetched into tx_data
+            tx_fetch <= tx_go;
+            if (!ctrl[1] || tx_len == 16'h0) begin
+                tx_index <= 16'h0;
+                tx_half <= 1'b0;
+                tx_valid <= 1'b0;
+                tx_fetch <= 1'b0;
+            end else begin
+                if (tx_go) begin
+                    if (tx_index == tx_len - 1) begin
+                        tx_index <= 16'h0;
+                        tx_half <= !tx_half;
+                        status[1] <= 1'b1;
+                    end else begin
+                        tx_index <= tx_index + 1;
+                    end
+                end
+                if (tx_fetch) begin
+                    tx_data <= dma_rdata;
+                    tx_valid <= 1'b1;
+                end else if (tx_valid && tx_ready) begin
+                    tx_valid <= 1'b0;
+                end else if (!tx_valid && tx_ready) begin
+                    status[5] <= 1'b1;
+                end
+            end
+        end
+    end
+
+endmodule
@@ -26,7 +26,16 @@ module instruction_decoder (
     output reg        branch,   // Branch instruction
     output reg        jump,     // Jump instruction
     output reg        saturate, // Saturation enable
-    output reg        round     // Rounding enable
+    output reg        round,    // Rounding enable
+    output reg        csr_read, // CSR read (performance counters, addressing CSRs)
+    output reg        csr_write, // CSR write (addressing CSRs)
+    output reg        acc_enable, // Accumulator MAC instruction
+    output reg [1:0]  acc_op,   // 00: macc, 01: macc.clr, 10: macc.rd, 11: macc2
+    output reg        simd_dot, // SIMD dot product (result through the ALU path)
+    output reg        loop_setup, // Hardware loop setup
+    output reg        post_inc, // Post-increment load/store (rs1 updated)
+    output reg [1:0]  addr_mode, // 00: linear, 01: circular, 10: bit-reversed
+    output reg        xy_load   // Dual-load MAC (bank X at rs1, bank Y at rs2)
 );
 
     // Extract basic instruction fields
@@ -50,6 +59,11 @@ module instruction_decoder (
                 imm20 = 20'h0;
                 imm32 = {{20{instruction[31]}}, instruction[31:20]};
             end
+            7'b0000011: begin // I-type (loads)
+                imm12 = instruction[31:20];
+                imm20 = 20'h0;
+                imm32 = {{20{instruction[31]}}, instruction[31:20]};
+            end
             7'b0100011: begin // S-type
                 imm12 = {instruction[31:25], instruction[11:7]};
                 imm20 = 20'h0;
@@ -70,6 +84,26 @@ module instruction_decoder (
                 imm20 = 20'h0;
                 imm32 = {{20{instruction[31]}}, instruction[31:20]};
             end
+            7'b1011011: begin // I-type (hardware loop setup, offset to the loop end)
+                imm12 = instruction[31:20];
+                imm20 = 20'h0;
+                imm32 = {{20{instruction[31]}}, instruction[31:20]};
+            end
+            7'b0101011: begin // Accumulator MAC: imm = bank Y pointer step of macc.xy / macc2.xy
+                imm12 = 12'h0;
+                imm20 = 20'h0;
+                case ({instruction[27], instruction[12]})
+                    2'b00: imm32 = 32'd2;
+                    2'b01: imm32 = 32'd4;
+                    2'b10: imm32 = -32'd2;
+                    2'b11: imm32 = -32'd4;
+                endcase
+            end
+            7'b1111011: begin // I-type loads / S-type stores (post-increment mode and step)
+                imm12 = instruction[14] ? {instruction[31:25], instruction[11:7]} : instruction[31:20];
+                imm20 = 20'h0;
+                imm32 = {{20{imm12[11]}}, imm12};
+            end
             default: begin
                 imm12 = 12'h0;
                 imm20 = 20'h0;
@@ -91,6 +125,15 @@ module instruction_decoder (
         jump = 1'b0;
         saturate = 1'b0;
         round = 1'b0;
+        csr_read = 1'b0;
+        csr_write = 1'b0;
+        acc_enable = 1'b0;
+        acc_op = 2'b00;
+        simd_dot = 1'b0;
+        loop_setup = 1'b0;
+        post_inc = 1'b0;
+        addr_mode = 2'b00;
+        xy_load = 1'b0;
         
         // Decode instruction
         case (opcode)
@@ -125,10 +168,15 @@ module instruction_decoder (
                     mac_mode = funct3[1:0];
                     saturate = funct3[2];
                     round = 1'b1;
-                end else if (funct7 == 7'b0000010) begin // SIMD instruction
-                    simd_enable = 1'b1;
+                end else if (funct7 == 7'b0000010 || funct7 == 7'b0000011) begin // SIMD instruction
                     simd_op = funct3;
-                    simd_width = {funct7[1:0]};
+                    simd_width = (funct7 == 7'b0000011) ? 2'b01 : 2'b00; // 4x 8-bit / 2x 16-bit
+                    if ((funct7 == 7'b0000010 && funct3 == 3'b111) ||
+                        (funct7 == 7'b0000011 && (funct3 == 3'b011 || funct3 == 3'b100))) begin
+                        simd_dot = 1'b1; // DOT4, DOT2, DOTS2
+                    end else begin
+                        simd_enable = 1'b1;
+                    end
                 end
             end
             
@@ -212,6 +260,71 @@ module instruction_decoder (
                     default: alu_op = 5'b00000;
                 endcase
             end
+            
+            // Accumulator MAC instructions (opcode = 7'b0101011)
+            7'b0101011: begin
+                case (funct3)
+                    3'b000: begin // MACC: acc += rs1[15:0] * rs2[15:0]
+                        acc_enable = 1'b1;
+                        acc_op = 2'b00;
+                    end
+                    3'b001: begin // MACC.CLR: acc = rs1[15:0] * rs2[15:0]
+                        acc_enable = 1'b1;
+                        acc_op = 2'b01;
+                    end
+                    3'b010: begin // MACC.RD: rd = sat32(acc >> rs1[5:0])
+                        acc_enable = 1'b1;
+                        acc_op = 2'b10;
+                        reg_write = 1'b1;
+                    end
+                    3'b011: begin // MACC2: acc += rs1[15:0] * rs2[15:0] + rs1[31:16] * rs2[31:16]
+                        acc_enable = 1'b1;
+                        acc_op = 2'b11;
+                    end
+                    // MACC.XY / MACC2.XY: acc += X[rs1] * Y[rs2] (halfword / packed
+                    // pairs), added in MEM; rd = rs1 + size, rs2 steps by imm32
+                    // (funct7[2] backwards, funct7[0] circular)
+                    3'b100, 3'b101: begin
+                        xy_load = 1'b1;
+                        acc_op = funct3[0] ? 2'b11 : 2'b00;
+                        addr_mode = {1'b0, funct7[0]};
+                        reg_write = 1'b1;
+                    end
+                    default: acc_enable = 1'b0;
+                endcase
+            end
+            
+            // Hardware loop setup (opcode = 7'b1011011), level in rd[0]
+            7'b1011011: begin
+                case (funct3)
+                    3'b000: loop_setup = 1'b1; // LP.SETUP: count = rs1
+                    3'b001: loop_setup = 1'b1; // LP.SETUPI: count = uimm5 in the rs1 field
+                    default: loop_setup = 1'b0;
+                endcase
+            end
+            
+            // Post-increment loads and stores (opcode = 7'b1111011):
+            // funct3[2] store, funct3[1:0] width, imm[11:10] mode, imm[9:0] step
+            7'b1111011: begin
+                if (funct3[1:0] != 2'b11 && imm12[11:10] != 2'b11) begin
+                    post_inc = 1'b1;
+                    addr_mode = imm12[11:10];
+                    if (funct3[2]) begin
+                        mem_write = 1'b1;
+                    end else begin
+                        mem_read = 1'b1;
+                        reg_write = 1'b1;
+                    end
+                end
+            end
+            
+            7'b1110011: begin // CSR instructions (counters are read-only)
+                if (funct3 != 3'b000) begin
+                    reg_write = 1'b1;
+                    csr_read = 1'b1;
+                    csr_write = (funct3[1:0] == 2'b01) || (rs1 != 5'h0);
+                end
+            end
         endcase
     end
 
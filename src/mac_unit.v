@@ -15,7 +15,19 @@ module mac_unit (
     input wire        round,    // Enable rounding
     output reg [31:0] result,   // MAC result
     output reg        overflow, // Overflow flag
-    output reg        underflow // Underflow flag
+    output reg        underflow, // Underflow flag
+
+    // Accumulator-resident MAC (macc / macc.clr / macc.rd)
+    input wire        acc_enable, // Accumulator instruction in EX
+    input wire [1:0]  acc_op,     // 00: macc, 01: macc.clr, 10: macc.rd, 11: macc2
+    input wire [5:0]  acc_shift,  // macc.rd right shift (rs1[5:0])
+    output reg [31:0] acc_result, // macc.rd result, valid in the same cycle
+    
+    // Dual-load MAC (macc.xy / macc2.xy), accumulated in MEM
+    input wire        xy_enable,  // Dual-load MAC in MEM
+    input wire        xy_word,    // 1: packed halfword pairs (macc2.xy), 0: one halfword
+    input wire [31:0] xy_x,       // Bank X operand
+    input wire [31:0] xy_y        // Bank Y operand
 );
 
     // Internal signals
@@ -25,6 +37,66 @@ module mac_unit (
     reg [31:0] saturated_result;
     reg [31:0] rounded_result;
     
+    // Accumulator: 16x16 products summed with 8 guard bits, so 256
+    // full-scale products accumulate without overflow. macc2 adds both
+    // halfword products (dual MAC) in one cycle.
+    reg  [39:0] acc;
+    wire [31:0] acc_product;
+    wire [31:0] acc_product_hi;
+    reg  [40:0] acc_rounded;
+    reg  [39:0] acc_shifted;
+    
+    // A dual-load MAC in MEM is older than the instruction in EX, so its
+    // products are added first and EX sees the sum
+    wire [31:0] xy_product;
+    wire [31:0] xy_product_hi;
+    wire [39:0] acc_mem;
+    
+    assign acc_product = $signed(a[15:0]) * $signed(b[15:0]);
+    assign acc_product_hi = $signed(a[31:16]) * $signed(b[31:16]);
+    assign xy_product = $signed(xy_x[15:0]) * $signed(xy_y[15:0]);
+    assign xy_product_hi = xy_word ? $signed(xy_x[31:16]) * $signed(xy_y[31:16]) : 32'h0;
+    assign acc_mem = xy_enable ? acc + {{8{xy_product[31]}}, xy_product}
+                                     + {{8{xy_product_hi[31]}}, xy_product_hi} : acc;
+    
+    // One product per cycle into the accumulator. The accumulator is not a
+    // register file operand, so back-to-back maccs never wait on each other.
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            acc <= 40'h0;
+        end else if (acc_enable) begin
+            case (acc_op)
+                2'b00: acc <= acc_mem + {{8{acc_product[31]}}, acc_product};  // macc
+                2'b01: acc <= {{8{acc_product[31]}}, acc_product};            // macc.clr
+                2'b11: acc <= acc_mem + {{8{acc_product[31]}}, acc_product}   // macc2
+                                      + {{8{acc_product_hi[31]}}, acc_product_hi};
+                default: acc <= acc_mem;                                      // macc.rd
+            endcase
+        end else begin
+            acc <= acc_mem;
+        end
+    end
+    
+    // macc.rd: round half up, shift right and saturate to 32 bits
+    always @(*) begin
+        acc_rounded = {acc_mem[39], acc_mem};
+        if (acc_shift == 6'd0) begin
+            acc_shifted = acc_mem;
+        end else if (acc_shift > 6'd40) begin
+            acc_shifted = {40{acc_mem[39]}};
+        end else begin
+            acc_rounded = {acc_mem[39], acc_mem} + (41'h1 << (acc_shift - 1));
+            acc_shifted = $signed(acc_rounded) >>> acc_shift;
+        end
+        if ($signed(acc_shifted) > $signed(40'h007FFFFFFF)) begin
+            acc_result = 32'h7FFFFFFF;
+        end else if ($signed(acc_shifted) < $signed(40'hFF80000000)) begin
+            acc_result = 32'h80000000;
+        end else begin
+            acc_result = acc_shifted[31:0];
+        end
+    end
+    
     // MAC operation
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
@@ -27,22 +27,45 @@ module memory_interface (
     input wire [31:0] base_addr,     // Base address for circular addressing
     input wire [31:0] buffer_size,   // Buffer size for circular addressing
     input wire        bit_reverse,   // Bit-reverse addressing for FFT
-    input wire [4:0]  fft_size_log2  // Log2 of FFT size for bit reversal
+    input wire [4:0]  fft_size_log2, // Log2 of FFT size for bit reversal
+    
+    // Dual load: addr reads bank X while addr_y reads bank Y
+    input wire        dual_read,     // Read both banks in the same cycle
+    input wire [31:0] addr_y,        // Bank Y address
+    output reg [31:0] read_data_y,   // Bank Y read data
+    
+    // DMA port: one halfword per cycle in a bank the core leaves free
+    input wire        dma_write,     // Write dma_wdata
+    input wire        dma_read,      // Read into dma_rdata
+    input wire [31:0] dma_addr,      // Halfword address
+    input wire [15:0] dma_wdata,     // Halfword to write
+    output reg [31:0] dma_rdata,     // Halfword read, sign-extended
+    output wire       dma_grant      // DMA access takes place this cycle
 );
 
-    // Memory arrays
+    // Memory arrays. Data memory is two single-ported 4KB banks: X at
+    // 0x0000-0x0FFF and Y at 0x1000-0x1FFF (address bit 12 selects).
     reg [31:0] instruction_mem [0:4095]; // 16KB instruction memory
-    reg [31:0] data_mem [0:2047];        // 8KB data memory
+    reg [31:0] data_mem_x [0:1023];      // 4KB data bank X
+    reg [31:0] data_mem_y [0:1023];      // 4KB data bank Y
     
     // Internal signals
     reg [31:0] effective_addr;
     reg [31:0] circular_addr_result;
+    reg [31:0] bit_reverse_index;
     reg [31:0] bit_reverse_addr;
     reg [31:0] temp_read_data;
     reg [31:0] temp_write_data;
+    reg [31:0] bank_word;                // Addressed word of the selected bank
+    reg [31:0] bank_word_y;              // Bank Y word of a dual load
+    reg [31:0] dma_word;                 // Word addressed by the DMA
     
     // Initialize memories
     integer i;
+`ifdef SIM
+    reg [8*256-1:0] image_file;          // Program image path from the command line
+    reg [31:0] data_image [0:2047];      // +dmem image, split across the banks
+`endif
     initial begin
         // Initialize instruction memory with valid RISC-V instructions
         for (i = 0; i < 4096; i = i + 1) begin
@@ -56,9 +79,27 @@ module memory_interface (
         instruction_mem[1028] = 32'h00400213; // ADDI x4, x0, 4 (PC=0x1010)
         instruction_mem[1029] = 32'h00500293; // ADDI x5, x0, 5 (PC=0x1014)
         
-        for (i = 0; i < 2048; i = i + 1) begin
-            data_mem[i] = 32'h0;
+        for (i = 0; i < 1024; i = i + 1) begin
+            data_mem_x[i] = 32'h0;
+            data_mem_y[i] = 32'h0;
+        end
+        
+`ifdef SIM
+        // Simulation program images: +imem=<file> +dmem=<file> ($readmemh, word addressed)
+        if ($value$plusargs("imem=%s", image_file)) begin
+            $readmemh(image_file, instruction_mem);
+        end
+        if ($value$plusargs("dmem=%s", image_file)) begin
+            for (i = 0; i < 2048; i = i + 1) begin
+                data_image[i] = 32'h0;
+            end
+            $readmemh(image_file, data_image);
+            for (i = 0; i < 1024; i = i + 1) begin
+                data_mem_x[i] = data_image[i];
+                data_mem_y[i] = data_image[i + 1024];
+            end
         end
+`endif
     end
     
     // Address calculation
@@ -66,21 +107,27 @@ module memory_interface (
         effective_addr = addr;
         
         // Circular addressing
-        if (circular_addr) begin
+        if (circular_addr && buffer_size != 32'h0) begin
             circular_addr_result = base_addr + ((addr - base_addr) % buffer_size);
             effective_addr = circular_addr_result;
         end
         
-        // Bit-reverse addressing for FFT
+        // Bit-reverse addressing for FFT: reverse the element index within
+        // the buffer, elements being mem_width bytes wide
         if (bit_reverse) begin
+            bit_reverse_index = (effective_addr - base_addr) >> mem_width[1:0];
             bit_reverse_addr = 32'h0;
             for (i = 0; i < fft_size_log2; i = i + 1) begin
-                bit_reverse_addr[i] = effective_addr[fft_size_log2 - 1 - i];
+                bit_reverse_addr[i] = bit_reverse_index[fft_size_log2 - 1 - i];
             end
-            effective_addr = bit_reverse_addr;
+            effective_addr = base_addr + (bit_reverse_addr << mem_width[1:0]);
         end
     end
     
+    // The core's access has priority; a dual load occupies both banks
+    assign dma_grant = (dma_write || dma_read) && dma_addr[31:2] < 2048 && !dual_read &&
+                       !((mem_read || mem_write) && effective_addr[12] == dma_addr[12]);
+    
     // Instruction fetch
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
@@ -98,56 +145,97 @@ module memory_interface (
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             read_data <= 32'h0;
+            read_data_y <= 32'h0;
+            dma_rdata <= 32'h0;
             mem_ready <= 1'b0;
         end else begin
             mem_ready <= 1'b1;
+            read_data_y <= 32'h0;
+            
+            // A dual load always takes addr from bank X
+            bank_word = (effective_addr[12] && !dual_read) ? data_mem_y[effective_addr[11:2]] :
+                                                             data_mem_x[effective_addr[11:2]];
             
-            if (mem_read && effective_addr[31:2] < 2048) begin
+            if ((mem_read || dual_read) && effective_addr[31:2] < 2048) begin
                 case (mem_width)
                     3'b000: begin // 8-bit access
                         case (effective_addr[1:0])
-                            2'b00: temp_read_data = {{24{mem_signed ? data_mem[effective_addr[31:2]][7] : 1'b0}}, data_mem[effective_addr[31:2]][7:0]};
-                            2'b01: temp_read_data = {{24{mem_signed ? data_mem[effective_addr[31:2]][15] : 1'b0}}, data_mem[effective_addr[31:2]][15:8]};
-                            2'b10: temp_read_data = {{24{mem_signed ? data_mem[effective_addr[31:2]][23] : 1'b0}}, data_mem[effective_addr[31:2]][23:16]};
-                            2'b11: temp_read_data = {{24{mem_signed ? data_mem[effective_addr[31:2]][31] : 1'b0}}, data_mem[effective_addr[31:2]][31:24]};
+                            2'b00: temp_read_data = {{24{mem_signed ? bank_word[7] : 1'b0}}, bank_word[7:0]};
+                            2'b01: temp_read_data = {{24{mem_signed ? bank_word[15] : 1'b0}}, bank_word[15:8]};
+                            2'b10: temp_read_data = {{24{mem_signed ? bank_word[23] : 1'b0}}, bank_word[23:16]};
+                            2'b11: temp_read_data = {{24{mem_signed ? bank_word[31] : 1'b0}}, bank_word[31:24]};
                         endcase
                     end
                     3'b001: begin // 16-bit access
                         case (effective_addr[1])
-                            1'b0: temp_read_data = {{16{mem_signed ? data_mem[effective_addr[31:2]][15] : 1'b0}}, data_mem[effective_addr[31:2]][15:0]};
-                            1'b1: temp_read_data = {{16{mem_signed ? data_mem[effective_addr[31:2]][31] : 1'b0}}, data_mem[effective_addr[31:2]][31:16]};
+                            1'b0: temp_read_data = {{16{mem_signed ? bank_word[15] : 1'b0}}, bank_word[15:0]};
+                            1'b1: temp_read_data = {{16{mem_signed ? bank_word[31] : 1'b0}}, bank_word[31:16]};
                         endcase
                     end
                     3'b010: begin // 32-bit access
-                        temp_read_data = data_mem[effective_addr[31:2]];
+                        temp_read_data = bank_word;
                     end
                     default: temp_read_data = 32'h0;
                 endcase
                 read_data <= temp_read_data;
+                
+                // Second operand of a dual load, same width, from bank Y
+                if (dual_read) begin
+                    bank_word_y = data_mem_y[addr_y[11:2]];
+                    if (mem_width == 3'b001) begin
+                        read_data_y <= addr_y[1] ? {{16{bank_word_y[31]}}, bank_word_y[31:16]} :
+                                                   {{16{bank_word_y[15]}}, bank_word_y[15:0]};
+                    end else begin
+                        read_data_y <= bank_word_y;
+                    end
+                end
             end else if (mem_write && effective_addr[31:2] < 2048) begin
                 case (mem_width)
                     3'b000: begin // 8-bit write
                         case (effective_addr[1:0])
-                            2'b00: data_mem[effective_addr[31:2]] <= {data_mem[effective_addr[31:2]][31:8], write_data[7:0]};
-                            2'b01: data_mem[effective_addr[31:2]] <= {data_mem[effective_addr[31:2]][31:16], write_data[7:0], data_mem[effective_addr[31:2]][7:0]};
-                            2'b10: data_mem[effective_addr[31:2]] <= {data_mem[effective_addr[31:2]][31:24], write_data[7:0], data_mem[effective_addr[31:2]][15:0]};
-                            2'b11: data_mem[effective_addr[31:2]] <= {write_data[7:0], data_mem[effective_addr[31:2]][23:0]};
+                            2'b00: temp_write_data = {bank_word[31:8], write_data[7:0]};
+                            2'b01: temp_write_data = {bank_word[31:16], write_data[7:0], bank_word[7:0]};
+                            2'b10: temp_write_data = {bank_word[31:24], write_data[7:0], bank_word[15:0]};
+                            2'b11: temp_write_data = {write_data[7:0], bank_word[23:0]};
                         endcase
                     end
                     3'b001: begin // 16-bit write
                         case (effective_addr[1])
-                            1'b0: data_mem[effective_addr[31:2]] <= {data_mem[effective_addr[31:2]][31:16], write_data[15:0]};
-                            1'b1: data_mem[effective_addr[31:2]] <= {write_data[15:0], data_mem[effective_addr[31:2]][15:0]};
+                            1'b0: temp_write_data = {bank_word[31:16], write_data[15:0]};
+                            1'b1: temp_write_data = {write_data[15:0], bank_word[15:0]};
                         endcase
                     end
                     3'b010: begin // 32-bit write
-                        data_mem[effective_addr[31:2]] <= write_data;
+                        temp_write_data = write_data;
                     end
+                    default: temp_write_data = bank_word;
                 endcase
+                if (effective_addr[12]) begin
+                    data_mem_y[effective_addr[11:2]] <= temp_write_data;
+                end else begin
+                    data_mem_x[effective_addr[11:2]] <= temp_write_data;
+                end
                 read_data <= 32'h0;
             end else begin
                 read_data <= 32'h0;
             end
+            
+            // DMA transfer in the other bank
+            if (dma_grant) begin
+                dma_word = dma_addr[12] ? data_mem_y[dma_addr[11:2]] : data_mem_x[dma_addr[11:2]];
+                if (dma_write) begin
+                    if (dma_addr[12]) begin
+                        data_mem_y[dma_addr[11:2]] <= dma_addr[1] ? {dma_wdata, dma_word[15:0]} :
+                                                                    {dma_word[31:16], dma_wdata};
+                    end else begin
+                        data_mem_x[dma_addr[11:2]] <= dma_addr[1] ? {dma_wdata, dma_word[15:0]} :
+                                                                    {dma_word[31:16], dma_wdata};
+                    end
+                end else begin
+                    dma_rdata <= dma_addr[1] ? {{16{dma_word[31]}}, dma_word[31:16]} :
+                                               {{16{dma_word[15]}}, dma_word[15:0]};
+                end
+            end
         end
     end
 
@@ -0,0 +1,91 @@
+//=============================================================================
+// Performance Counters for RISC-V DSP Processor
+// Cycle, instret and stall-cause counters readable through user CSRs
+//=============================================================================
+//
+// CSR map (read-only, low word at 0xC0x, high word at 0xC8x):
+//   0xC00 cycle          0xC03 hpmcounter3: load-use stall cycles
+//   0xC01 time (=cycle)  0xC04 hpmcounter4: memory stall cycles
+//   0xC02 instret        0xC05 hpmcounter5: branch/jump flushes
+//                        0xC06 hpmcounter6: MAC busy cycles
+//                        0xC07 hpmcounter7: SIMD busy cycles
+//                        0xC08 hpmcounter8: RAW (data hazard) stall cycles
+//
+// hpmcounter3 + hpmcounter8 is the total of hazard stall cycles.
+
+module perf_counters (
+    input wire clk,
+    input wire rst_n,
+
+    // Events, sampled every cycle
+    input wire        retire,           // Valid instruction in WB
+    input wire        load_use_stall,   // Pipeline held for a load-use hazard
+    input wire        raw_stall,        // Pipeline held for another RAW hazard
+    input wire        mem_stall,        // Pipeline held for the memory port
+    input wire        branch_flush,     // Taken branch or jump in EX
+    input wire        mac_busy,         // MAC unit enabled
+    input wire        simd_busy,        // SIMD unit enabled
+
+    // CSR read port
+    input wire [11:0] csr_addr,         // CSR address
+    output reg [31:0] csr_rdata,        // Read data
+    output reg        csr_valid         // Address is a counter CSR
+);
+
+    // Counters
+    reg [63:0] cycle_count;
+    reg [63:0] instret_count;
+    reg [63:0] load_use_count;
+    reg [63:0] mem_stall_count;
+    reg [63:0] branch_flush_count;
+    reg [63:0] mac_busy_count;
+    reg [63:0] simd_busy_count;
+    reg [63:0] raw_stall_count;
+
+    reg [63:0] selected;
+
+    // Count events
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            cycle_count <= 64'h0;
+            instret_count <= 64'h0;
+            load_use_count <= 64'h0;
+            mem_stall_count <= 64'h0;
+            branch_flush_count <= 64'h0;
+            mac_busy_count <= 64'h0;
+            simd_busy_count <= 64'h0;
+            raw_stall_count <= 64'h0;
+        end else begin
+            cycle_count <= cycle_count + 1;
+            if (retire)         instret_count <= instret_count + 1;
+            if (load_use_stall) load_use_count <= load_use_count + 1;
+            if (mem_stall)      mem_stall_count <= mem_stall_count + 1;
+            if (branch_flush)   branch_flush_count <= branch_flush_count + 1;
+            if (mac_busy)       mac_busy_count <= mac_busy_count + 1;
+            if (simd_busy)      simd_busy_count <= simd_busy_count + 1;
+            if (raw_stall)      raw_stall_count <= raw_stall_count + 1;
+        end
+    end
+
+    // CSR read mux: bit 7 selects the high word
+    always @(*) begin
+        csr_valid = 1'b1;
+        case ({csr_addr[11:8], csr_addr[6:0]})
+            {4'hC, 7'h00}: selected = cycle_count;
+            {4'hC, 7'h01}: selected = cycle_count;
+            {4'hC, 7'h02}: selected = instret_count;
+            {4'hC, 7'h03}: selected = load_use_count;
+            {4'hC, 7'h04}: selected = mem_stall_count;
+            {4'hC, 7'h05}: selected = branch_flush_count;
+            {4'hC, 7'h06}: selected = mac_busy_count;
+            {4'hC, 7'h07}: selected = simd_busy_count;
+            {4'hC, 7'h08}: selected = raw_stall_count;
+            default: begin
+                selected = 64'h0;
+                csr_valid = 1'b0;
+            end
+        endcase
+        csr_rdata = csr_addr[7] ? selected[63:32] : selected[31:0];
+    end
+
+endmodule
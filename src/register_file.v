@@ -1,6 +1,6 @@
 //=============================================================================
 // Register File for RISC-V DSP Processor
-// 32 general-purpose registers with dual-port read and single-port write
+// 32 general-purpose registers with dual-port read and dual-port write
 //=============================================================================
 
 module register_file (
@@ -11,6 +11,9 @@ module register_file (
     input wire [4:0]  raddr2,   // Read address 2
     input wire [4:0]  waddr,    // Write address
     input wire [31:0] wdata,    // Write data
+    input wire we2,             // Write enable 2 (post-increment address updates)
+    input wire [4:0]  waddr2,   // Write address 2
+    input wire [31:0] wdata2,   // Write data 2
     output reg [31:0] rdata1,   // Read data 1
     output reg [31:0] rdata2    // Read data 2
 );
@@ -47,8 +50,14 @@ module register_file (
             for (i = 0; i < 32; i = i + 1) begin
                 registers[i] <= 32'h0;
             end
-        end else if (we && waddr != 5'h0) begin // x0 cannot be written
-            registers[waddr] <= wdata;
+        end else begin
+            // Port 1 wins when both ports write the same register
+            if (we2 && waddr2 != 5'h0) begin
+                registers[waddr2] <= wdata2;
+            end
+            if (we && waddr != 5'h0) begin // x0 cannot be written
+                registers[waddr] <= wdata;
+            end
         end
     end
 
@@ -10,6 +10,12 @@ module riscv_dsp_core (
     output reg [31:0] external_data_out,
     output reg        processor_ready,
     
+    // Sample stream handled by the DMA controller
+    input wire        external_data_valid,     // external_data_in holds a new sample
+    output wire       external_data_out_valid, // external_data_out holds a DMA sample
+    input wire        external_data_ready,     // Sink takes external_data_out
+    output wire       dma_irq,                 // DMA block complete
+    
     // Debug/verification outputs
     output wire [31:0] pc,
     output wire [31:0] instruction,
@@ -41,6 +47,7 @@ module riscv_dsp_core (
     // Internal signals (only those not exposed as outputs)
     wire [31:0] pc_next;
     reg [31:0] pc_current;  // Current PC register
+    reg [31:0] pc_fetched;  // PC of the instruction memory output
     
     // Instruction decoder signals
     wire [6:0]  opcode;
@@ -86,6 +93,63 @@ module riscv_dsp_core (
     // Forwarding multiplexers
     wire [31:0] forward_data1, forward_data2;
     
+    // Performance counters and CSR reads
+    wire        csr_read;
+    wire        acc_enable;
+    wire [1:0]  acc_op;
+    reg         acc_enable_id, acc_enable_ex;
+    reg  [1:0]  acc_op_id, acc_op_ex;
+    wire [31:0] acc_result;
+    wire        simd_dot;
+    reg         simd_dot_id, simd_dot_ex;
+    wire [31:0] simd_dot_result;
+    
+    // Hardware loops
+    wire        loop_setup;
+    reg         loop_setup_id, loop_setup_ex;
+    wire        loop_taken;
+    wire [31:0] loop_target;
+    wire        loop_refetch;
+    wire [31:0] loop_count_ex;
+    
+    // Post-increment addressing
+    wire        csr_write;
+    reg         csr_write_id, csr_write_ex;
+    wire        post_inc;
+    wire [1:0]  addr_mode;
+    reg         post_inc_id, post_inc_ex;
+    reg  [1:0]  addr_mode_id, addr_mode_ex;
+    wire [31:0] ptr_next;
+    wire [31:0] agu_base_addr, agu_buffer_size;
+    wire [4:0]  agu_fft_size_log2;
+    wire [31:0] agu_csr_rdata;
+    wire        agu_csr_valid;
+    wire [31:0] mem_addr_ex;
+    wire [1:0]  forward_ptr_a, forward_ptr_b;
+    reg         ptr_write_mem, ptr_write_wb;
+    reg  [4:0]  ptr_rd_mem, ptr_rd_wb;
+    reg  [31:0] ptr_next_mem, ptr_next_wb;
+    
+    // Dual-load MAC (bank X and bank Y read in the same cycle)
+    wire        xy_load;
+    reg         xy_load_id, xy_load_ex, xy_load_mem;
+    reg         xy_word_mem;
+    wire [31:0] mem_read_data_y;
+    // DMA controller (shares the data port with loads and stores)
+    wire        dma_write, dma_read, dma_grant, dma_tx_enable;
+    wire [31:0] dma_addr, dma_rdata, dma_tx_data;
+    wire [15:0] dma_wdata;
+    wire [31:0] dma_csr_rdata;
+    wire        dma_csr_valid;
+    reg         csr_read_id, csr_read_ex;
+    wire [31:0] csr_rdata;
+    wire        csr_valid;
+    wire        load_use_stall;
+    wire        raw_stall;
+    wire [31:0] ex_result;
+    reg         fetch_valid, valid_if;                    // pc_fetched / IF hold a real fetch, not reset state
+    reg         valid_id, valid_ex, valid_mem, valid_wb;  // Instruction (not bubble) in stage
+    
     // Branch and jump logic
     wire jump_taken;
     wire [31:0] jump_target;
@@ -114,7 +178,16 @@ module riscv_dsp_core (
         .branch(branch),
         .jump(jump),
         .saturate(saturate),
-        .round(round)
+        .round(round),
+        .csr_read(csr_read),
+        .acc_enable(acc_enable),
+        .acc_op(acc_op),
+        .simd_dot(simd_dot),
+        .loop_setup(loop_setup),
+        .csr_write(csr_write),
+        .post_inc(post_inc),
+        .addr_mode(addr_mode),
+        .xy_load(xy_load)
     );
     
     register_file reg_file (
@@ -125,6 +198,9 @@ module riscv_dsp_core (
         .raddr2(rs2_id),
         .waddr(rd_wb),
         .wdata(reg_write_data),
+        .we2(ptr_write_wb),
+        .waddr2(ptr_rd_wb),
+        .wdata2(ptr_next_wb),
         .rdata1(reg_data1),
         .rdata2(reg_data2)
     );
@@ -153,7 +229,15 @@ module riscv_dsp_core (
         .round(round_ex),
         .result(mac_result),
         .overflow(mac_overflow),
-        .underflow(mac_underflow)
+        .underflow(mac_underflow),
+        .acc_enable(acc_enable_ex && valid_ex),
+        .acc_op(acc_op_ex),
+        .acc_shift(forward_data1[5:0]),
+        .acc_result(acc_result),
+        .xy_enable(xy_load_mem && valid_mem),
+        .xy_word(xy_word_mem),
+        .xy_x(mem_read_data),
+        .xy_y(mem_read_data_y)
     );
     
     simd_unit simd_unit_inst (
@@ -166,28 +250,87 @@ module riscv_dsp_core (
         .width(simd_width_ex),
         .shift_amt(imm32_ex[2:0]),
         .result(simd_result),
-        .overflow(simd_overflow)
+        .overflow(simd_overflow),
+        .dot_result(simd_dot_result)
     );
     
     memory_interface mem_interface (
         .clk(clk),
         .rst_n(rst_n),
-        .pc(pc_if),
+        .pc(pc_current),
         .instruction(instruction),
         .if_stall(if_stall),
-        .addr(alu_result_ex),
+        .addr(mem_addr_ex),
         .write_data(forward_data2),
         .mem_read(mem_read_ex),
         .mem_write(mem_write_ex),
-        .mem_width(funct3),
+        .mem_width(post_inc_ex ? {1'b0, instruction_ex[13:12]} :
+                   xy_load_ex ? (acc_op_ex == 2'b11 ? 3'b010 : 3'b001) : funct3),
         .mem_signed(1'b1),
         .read_data(mem_read_data),
         .mem_ready(mem_ready),
-        .circular_addr(1'b0),
-        .base_addr(32'h0),
-        .buffer_size(32'h0),
-        .bit_reverse(1'b0),
-        .fft_size_log2(5'h0)
+        .circular_addr(post_inc_ex && addr_mode_ex == 2'b01),
+        .base_addr(agu_base_addr),
+        .buffer_size(agu_buffer_size),
+        .bit_reverse(post_inc_ex && addr_mode_ex == 2'b10),
+        .fft_size_log2(agu_fft_size_log2),
+        .dual_read(xy_load_ex && valid_ex),
+        .addr_y(forward_data2),
+        .read_data_y(mem_read_data_y),
+        .dma_write(dma_write),
+        .dma_read(dma_read),
+        .dma_addr(dma_addr),
+        .dma_wdata(dma_wdata),
+        .dma_rdata(dma_rdata),
+        .dma_grant(dma_grant)
+    );
+    
+    dma_controller dma_inst (
+        .clk(clk),
+        .rst_n(rst_n),
+        .rx_data(external_data_in),
+        .rx_valid(external_data_valid),
+        .tx_data(dma_tx_data),
+        .tx_valid(external_data_out_valid),
+        .tx_ready(external_data_ready),
+        .dma_write(dma_write),
+        .dma_read(dma_read),
+        .dma_addr(dma_addr),
+        .dma_wdata(dma_wdata),
+        .dma_rdata(dma_rdata),
+        .dma_grant(dma_grant),
+        .irq(dma_irq),
+        .tx_enable(dma_tx_enable),
+        .csr_addr(instruction_ex[31:20]),
+        .csr_write(csr_write_ex && valid_ex),
+        .csr_op(instruction_ex[13:12]),
+        .csr_wdata(instruction_ex[14] ? {27'h0, instruction_ex[19:15]} : forward_data1),
+        .csr_rdata(dma_csr_rdata),
+        .csr_valid(dma_csr_valid)
+    );
+    
+    // Post-increment accesses and dual loads use the address register as
+    // is, then update it
+    assign mem_addr_ex = (post_inc_ex || xy_load_ex) ? forward_data1 : alu_result_ex;
+    
+    // The address generator steps rs1 of a post-increment access, or the
+    // bank Y pointer (rs2) of a dual load
+    address_generator agu_inst (
+        .clk(clk),
+        .rst_n(rst_n),
+        .ptr(xy_load_ex ? forward_data2 : forward_data1),
+        .step(imm32_ex[9:0]),
+        .mode(addr_mode_ex),
+        .ptr_next(ptr_next),
+        .base_addr(agu_base_addr),
+        .buffer_size(agu_buffer_size),
+        .fft_size_log2(agu_fft_size_log2),
+        .csr_addr(instruction_ex[31:20]),
+        .csr_write(csr_write_ex && valid_ex),
+        .csr_op(instruction_ex[13:12]),
+        .csr_wdata(instruction_ex[14] ? {27'h0, instruction_ex[19:15]} : forward_data1),
+        .csr_rdata(agu_csr_rdata),
+        .csr_valid(agu_csr_valid)
     );
     
     control_unit control_unit_inst (
@@ -216,15 +359,65 @@ module riscv_dsp_core (
         .wb_flush(wb_flush),
         .forward_a(forward_a),
         .forward_b(forward_b),
-        .hazard_detected(hazard_detected)
+        .hazard_detected(hazard_detected),
+        .load_use_stall(load_use_stall),
+        .raw_stall(raw_stall),
+        .pc_fetch(pc_current),
+        .loop_setup(loop_setup_ex && valid_ex),
+        .loop_level(instruction_ex[7]),
+        .loop_start_in(pc_ex + 4),
+        .loop_end_in(pc_ex + imm32_ex),
+        .loop_count_in(loop_count_ex),
+        .loop_taken(loop_taken),
+        .loop_target(loop_target),
+        .loop_refetch(loop_refetch),
+        .ptr_write_mem(ptr_write_mem),
+        .ptr_rd_mem(ptr_rd_mem),
+        .ptr_write_wb(ptr_write_wb),
+        .ptr_rd_wb(ptr_rd_wb),
+        .forward_ptr_a(forward_ptr_a),
+        .forward_ptr_b(forward_ptr_b)
     );
     
-    // Forwarding multiplexers
-    assign forward_data1 = (forward_a == 2'b10) ? alu_result_mem :
+    // LP.SETUP takes the count from rs1, LP.SETUPI from the rs1 field
+    assign loop_count_ex = (instruction_ex[14:12] == 3'b001) ? {27'h0, instruction_ex[19:15]} : forward_data1;
+    
+    perf_counters perf_counters_inst (
+        .clk(clk),
+        .rst_n(rst_n),
+        .retire(valid_wb),
+        .load_use_stall(load_use_stall),
+        .raw_stall(raw_stall),
+        .mem_stall(mem_stall || ((mem_read_ex || mem_write_ex) && !mem_ready)),
+        .branch_flush(branch_taken || jump_taken),
+        .mac_busy(mac_enable_ex || acc_enable_ex || xy_load_ex),
+        .simd_busy(simd_enable_ex || simd_dot_ex),
+        .csr_addr(instruction_ex[31:20]),
+        .csr_rdata(csr_rdata),
+        .csr_valid(csr_valid)
+    );
+    
+    // EX result: CSR reads, macc.rd, dot products and the bank X pointer of
+    // a dual load go down the ALU result path
+    assign ex_result = (csr_read_ex && csr_valid) ? csr_rdata :
+                       xy_load_ex ? forward_data1 + ((acc_op_ex == 2'b11) ? 32'd4 : 32'd2) :
+                       (csr_read_ex && agu_csr_valid) ? agu_csr_rdata :
+                       (csr_read_ex && dma_csr_valid) ? dma_csr_rdata :
+                       (acc_enable_ex && acc_op_ex == 2'b10) ? acc_result :
+                       simd_dot_ex ? simd_dot_result :
+                       alu_result;
+    
+    // Forwarding multiplexers (address updates from the second write port
+    // are forwarded like results)
+    assign forward_data1 = (forward_ptr_a == 2'b10) ? ptr_next_mem :
+                          (forward_a == 2'b10) ? alu_result_mem :
+                          (forward_ptr_a == 2'b01) ? ptr_next_wb :
                           (forward_a == 2'b01) ? reg_write_data :
                           reg_data1_ex;
     
-    assign forward_data2 = (forward_b == 2'b10) ? alu_result_mem :
+    assign forward_data2 = (forward_ptr_b == 2'b10) ? ptr_next_mem :
+                          (forward_b == 2'b10) ? alu_result_mem :
+                          (forward_ptr_b == 2'b01) ? ptr_next_wb :
                           (forward_b == 2'b01) ? reg_write_data :
                           reg_data2_ex;
     
@@ -238,6 +431,8 @@ module riscv_dsp_core (
     assign pc_plus_4 = pc_current + 4;
     assign pc_next = (branch_taken) ? branch_target :
                     (jump_taken) ? jump_target :
+                    (loop_refetch) ? pc_ex + 4 :
+                    (loop_taken) ? loop_target :
                     pc_plus_4;
     
     // Pipeline register updates
@@ -245,7 +440,8 @@ module riscv_dsp_core (
         if (!rst_n) begin
             // Reset all pipeline registers
             pc_current <= 32'h1000;  // Start at address 0x1000 (valid instruction memory)
-            pc_if <= 32'h1000;
+            pc_fetched <= 32'h0;
+            pc_if <= 32'h0;
             pc_id <= 32'h0;
             pc_ex <= 32'h0;
             pc_mem <= 32'h0;
@@ -255,16 +451,54 @@ module riscv_dsp_core (
             instruction_ex <= 32'h00000013;  // NOP instruction
             instruction_mem <= 32'h00000013; // NOP instruction
             instruction_wb <= 32'h00000013;  // NOP instruction
+            csr_read_id <= 1'b0;
+            csr_read_ex <= 1'b0;
+            acc_enable_id <= 1'b0;
+            acc_enable_ex <= 1'b0;
+            acc_op_id <= 2'b00;
+            acc_op_ex <= 2'b00;
+            simd_dot_id <= 1'b0;
+            simd_dot_ex <= 1'b0;
+            loop_setup_id <= 1'b0;
+            loop_setup_ex <= 1'b0;
+            csr_write_id <= 1'b0;
+            csr_write_ex <= 1'b0;
+            post_inc_id <= 1'b0;
+            post_inc_ex <= 1'b0;
+            addr_mode_id <= 2'b00;
+            addr_mode_ex <= 2'b00;
+            ptr_write_mem <= 1'b0;
+            ptr_write_wb <= 1'b0;
+            ptr_rd_mem <= 5'h0;
+            ptr_rd_wb <= 5'h0;
+            ptr_next_mem <= 32'h0;
+            ptr_next_wb <= 32'h0;
+            xy_load_id <= 1'b0;
+            xy_load_ex <= 1'b0;
+            xy_load_mem <= 1'b0;
+            xy_word_mem <= 1'b0;
+            fetch_valid <= 1'b0;
+            valid_if <= 1'b0;
+            valid_id <= 1'b0;
+            valid_ex <= 1'b0;
+            valid_mem <= 1'b0;
+            valid_wb <= 1'b0;
             // ... (reset all other pipeline registers)
             processor_ready <= 1'b0;
         end else begin
-            // IF stage
+            // IF stage: the instruction memory output is registered, so
+            // pc_if follows the fetch address by two cycles to stay paired
+            // with instruction_if
             if (!pc_stall) begin
                 pc_current <= pc_next;
-                pc_if <= pc_next;
             end
             if (!if_stall) begin
+                pc_fetched <= pc_current;
+                pc_if <= pc_fetched;
                 instruction_if <= instruction;
+                // The reset NOPs ahead of the first fetch are not instructions
+                fetch_valid <= 1'b1;
+                valid_if <= fetch_valid;
             end
             
             // ID stage
@@ -290,6 +524,16 @@ module riscv_dsp_core (
                 simd_enable_id <= simd_enable;
                 saturate_id <= saturate;
                 round_id <= round;
+                csr_read_id <= csr_read;
+                acc_enable_id <= acc_enable;
+                acc_op_id <= acc_op;
+                simd_dot_id <= simd_dot;
+                loop_setup_id <= loop_setup;
+                csr_write_id <= csr_write;
+                post_inc_id <= post_inc;
+                addr_mode_id <= addr_mode;
+                xy_load_id <= xy_load;
+                valid_id <= valid_if && !id_flush;
             end
             
             // EX stage
@@ -315,13 +559,24 @@ module riscv_dsp_core (
                 simd_enable_ex <= simd_enable_id;
                 saturate_ex <= saturate_id;
                 round_ex <= round_id;
+                csr_read_ex <= csr_read_id;
+                acc_enable_ex <= acc_enable_id;
+                acc_op_ex <= acc_op_id;
+                simd_dot_ex <= simd_dot_id;
+                loop_setup_ex <= loop_setup_id;
+                csr_write_ex <= csr_write_id;
+                post_inc_ex <= post_inc_id;
+                addr_mode_ex <= addr_mode_id;
+                xy_load_ex <= xy_load_id;
+                valid_ex <= valid_id && !ex_flush;
             end
             
             // MEM stage
             if (!mem_stall) begin
                 pc_mem <= pc_ex;
                 instruction_mem <= instruction_ex;
-                alu_result_mem <= alu_result;
+                alu_result_mem <= ex_result;
+                valid_mem <= valid_ex && !mem_flush;
                 mac_result_mem <= mac_result;
                 simd_result_mem <= simd_result;
                 mem_read_data_mem <= mem_read_data;
@@ -329,6 +584,11 @@ module riscv_dsp_core (
                 reg_write_mem <= reg_write_ex;
                 mem_read_mem <= mem_read_ex;
                 mem_write_mem <= mem_write_ex;
+                ptr_write_mem <= (post_inc_ex || xy_load_ex) && valid_ex && !mem_flush;
+                ptr_rd_mem <= xy_load_ex ? instruction_ex[24:20] : instruction_ex[19:15];
+                xy_load_mem <= xy_load_ex;
+                xy_word_mem <= (acc_op_ex == 2'b11);
+                ptr_next_mem <= ptr_next;
             end
             
             // WB stage
@@ -341,6 +601,10 @@ module riscv_dsp_core (
                 mem_read_data_wb <= mem_read_data_mem;
                 rd_wb <= rd_mem;
                 reg_write_wb <= reg_write_mem;
+                valid_wb <= valid_mem && !wb_flush;
+                ptr_write_wb <= ptr_write_mem && !wb_flush;
+                ptr_rd_wb <= ptr_rd_mem;
+                ptr_next_wb <= ptr_next_mem;
             end
             
             processor_ready <= 1'b1;
@@ -355,7 +619,7 @@ module riscv_dsp_core (
     
     // External interface
     assign pc = pc_current;
-    assign external_data_out = alu_result_wb;
+    assign external_data_out = dma_tx_enable ? dma_tx_data : alu_result_wb;
     
     // Debug/verification outputs
     assign instruction = instruction_if;
@@ -9,11 +9,12 @@ module simd_unit (
     input wire enable,
     input wire [31:0] a,        // First operand
     input wire [31:0] b,        // Second operand
-    input wire [2:0]  op,       // SIMD operation (000: ADD4, 001: SUB4, 010: MUL4, 011: AND4, 100: OR4, 101: XOR4, 110: SHIFT4, 111: reserved)
+    input wire [2:0]  op,       // SIMD operation (000: ADD4, 001: SUB4, 010: MUL4, 011: AND4, 100: OR4, 101: XOR4, 110: SHIFT4, 111: DOT4)
     input wire [1:0]  width,    // Data width (00: 8-bit, 01: 16-bit, 10: reserved, 11: reserved)
     input wire [2:0]  shift_amt, // Shift amount for SHIFT4 operation
     output reg [31:0] result,   // SIMD result
-    output reg        overflow  // Overflow flag
+    output reg        overflow, // Overflow flag
+    output reg [31:0] dot_result // Dot product (DOT4, DOT2, DOTS2), valid in the same cycle
 );
 
     // Internal signals for 8-bit operations
@@ -64,6 +65,36 @@ module simd_unit (
     assign mul16_0 = a16_0 * b16_0;
     assign mul16_1 = a16_1 * b16_1;
     
+    // Signed products for the dot products
+    wire signed [15:0] smul0, smul1, smul2, smul3;
+    wire signed [31:0] smul16_0, smul16_1;
+    wire signed [17:0] dot4;
+    wire signed [32:0] dot2, dots2;
+    
+    assign smul0 = $signed(a0) * $signed(b0);
+    assign smul1 = $signed(a1) * $signed(b1);
+    assign smul2 = $signed(a2) * $signed(b2);
+    assign smul3 = $signed(a3) * $signed(b3);
+    assign smul16_0 = $signed(a16_0) * $signed(b16_0);
+    assign smul16_1 = $signed(a16_1) * $signed(b16_1);
+    
+    // Horizontal reduction: four 8x8 products fit in 18 bits and a 16x16
+    // difference fits in 32; the 16x16 sum overflows only for
+    // (-32768)^2 + (-32768)^2 and saturates
+    assign dot4 = smul0 + smul1 + smul2 + smul3;
+    assign dot2 = smul16_0 + smul16_1;
+    assign dots2 = smul16_0 - smul16_1;
+    
+    always @(*) begin
+        if (width == 2'b00) begin
+            dot_result = {{14{dot4[17]}}, dot4};                       // DOT4
+        end else if (op == 3'b100) begin
+            dot_result = dots2[31:0];                                   // DOTS2
+        end else begin
+            dot_result = (dot2[32] != dot2[31]) ? 32'h7FFFFFFF : dot2[31:0]; // DOT2
+        end
+    end
+    
     // SIMD operation execution
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
@@ -19,6 +19,12 @@ interface riscv_dsp_if(input logic clk);
     logic [DATA_WIDTH-1:0] external_data_in;
     logic [DATA_WIDTH-1:0] external_data_out;
     
+    // Sample stream (DMA controller)
+    logic external_data_valid;
+    logic external_data_ready;
+    logic external_data_out_valid;
+    logic dma_irq;
+    
     // Program counter
     logic [ADDR_WIDTH-1:0] pc;
     logic [ADDR_WIDTH-1:0] pc_plus_4;
@@ -67,6 +73,7 @@ interface riscv_dsp_if(input logic clk);
         clocking cb @(posedge clk);
             output rst_n, external_data_in;
             input processor_ready, external_data_out;
+            input external_data_valid, external_data_ready, external_data_out_valid, dma_irq;
             input pc, pc_plus_4, instruction;
             input rs1, rs2, rd, rs1_data, rs2_data, reg_write_data, reg_write;
             input alu_result, alu_zero, alu_overflow, alu_carry, alu_negative, alu_op;
@@ -80,6 +87,7 @@ interface riscv_dsp_if(input logic clk);
         // Clocking block for monitor (same as driver for now)
         clocking monitor_cb @(posedge clk);
             input rst_n, external_data_in, processor_ready, external_data_out;
+            input external_data_valid, external_data_ready, external_data_out_valid, dma_irq;
             input pc, pc_plus_4, instruction;
             input rs1, rs2, rd, rs1_data, rs2_data, reg_write_data, reg_write;
             input alu_result, alu_zero, alu_overflow, alu_carry, alu_negative, alu_op;
@@ -90,9 +98,18 @@ interface riscv_dsp_if(input logic clk);
             input branch, jump, branch_target, branch_taken;
         endclocking
         
+        // Clocking block for the streaming-source agent
+        clocking stream_cb @(posedge clk);
+            output external_data_in, external_data_valid, external_data_ready;
+            input external_data_out, external_data_out_valid, dma_irq;
+        endclocking
+        
         // Modport for driver
         modport DRV (clocking cb, input clk);
         
+        // Modport for the streaming-source agent
+        modport STREAM (clocking stream_cb, input clk, rst_n);
+        
         // Modport for monitor  
         modport MON (clocking monitor_cb, input clk);
         
@@ -104,6 +121,7 @@ interface riscv_dsp_if(input logic clk);
                     saturate, round, simd_a, simd_b, simd_result, simd_overflow, simd_op, simd_width, simd_enable,
                     mem_addr, mem_data_in, mem_data_out, mem_read, mem_write, mem_valid,
                     branch, jump, branch_target, branch_taken,
-                    output external_data_in);
+                    external_data_out_valid, dma_irq,
+                    output external_data_in, external_data_valid, external_data_ready);
     
 endinterface : riscv_dsp_if
\ No newline at end of file
@@ -51,17 +51,24 @@ package riscv_dsp_pkg;
         MAC_RESERVED = 2'b11
     } mac_mode_t;
 
-    // SIMD operations
+    // SIMD operations (simd_width = 00, 4x 8-bit lanes)
     typedef enum logic [2:0] {
-        SIMD_ADD4 = 3'b000,
-        SIMD_SUB4 = 3'b001,
-        SIMD_MUL4 = 3'b010,
-        SIMD_AND4 = 3'b011,
-        SIMD_OR4  = 3'b100,
-        SIMD_XOR4 = 3'b101,
-        SIMD_SAT  = 3'b110,
-        SIMD_CLIP = 3'b111
+        SIMD_ADD4   = 3'b000,
+        SIMD_SUB4   = 3'b001,
+        SIMD_MUL4   = 3'b010,
+        SIMD_AND4   = 3'b011,
+        SIMD_OR4    = 3'b100,
+        SIMD_XOR4   = 3'b101,
+        SIMD_SHIFT4 = 3'b110,
+        SIMD_DOT4   = 3'b111
     } simd_op_t;
+    
+    // SIMD operations with simd_width = 01 (2x 16-bit lanes)
+    parameter logic [2:0] SIMD_ADD2  = 3'b000;
+    parameter logic [2:0] SIMD_SUB2  = 3'b001;
+    parameter logic [2:0] SIMD_MUL2  = 3'b010;
+    parameter logic [2:0] SIMD_DOT2  = 3'b011;
+    parameter logic [2:0] SIMD_DOTS2 = 3'b100;
 
     // Sequence item class
     class riscv_dsp_seq_item extends uvm_sequence_item;
@@ -204,6 +204,31 @@ class riscv_dsp_scoreboard extends uvm_scoreboard;
     
     // Calculate SIMD instruction results
     virtual function void calculate_simd_result(riscv_dsp_seq_item item);
+        logic signed [32:0] dot_sum;
+        
+        // 2x 16-bit lanes
+        if (item.simd_width == 2'b01) begin
+            case (item.simd_op)
+                riscv_dsp_pkg::SIMD_DOT2: begin
+                    // Dual 16x16 MAC with horizontal reduction, saturated to 32 bits
+                    dot_sum = $signed(item.simd_a[15:0]) * $signed(item.simd_b[15:0]) +
+                              $signed(item.simd_a[31:16]) * $signed(item.simd_b[31:16]);
+                    item.result = (dot_sum > 33'sh07FFFFFFF) ? 32'h7FFFFFFF : dot_sum[31:0];
+                end
+                riscv_dsp_pkg::SIMD_DOTS2: begin
+                    // Dual 16x16 product difference (always fits in 32 bits)
+                    dot_sum = $signed(item.simd_a[15:0]) * $signed(item.simd_b[15:0]) -
+                              $signed(item.simd_a[31:16]) * $signed(item.simd_b[31:16]);
+                    item.result = dot_sum[31:0];
+                end
+                default: begin
+                    `uvm_warning("SCOREBOARD", $sformatf("Unchecked 16-bit SIMD op: %0d", item.simd_op))
+                end
+            endcase
+            item.simd_overflow = 1'b0;
+            return;
+        end
+        
         case (item.simd_op)
             riscv_dsp_pkg::SIMD_ADD4: begin
                 // 4x 8-bit addition
@@ -247,6 +272,14 @@ class riscv_dsp_scoreboard extends uvm_scoreboard;
                 item.result[23:16] = item.simd_a[23:16] ^ item.simd_b[23:16];
                 item.result[31:24] = item.simd_a[31:24] ^ item.simd_b[31:24];
             end
+            riscv_dsp_pkg::SIMD_DOT4: begin
+                // Signed 4x 8-bit dot product
+                dot_sum = $signed(item.simd_a[7:0])   * $signed(item.simd_b[7:0]) +
+                          $signed(item.simd_a[15:8])  * $signed(item.simd_b[15:8]) +
+                          $signed(item.simd_a[23:16]) * $signed(item.simd_b[23:16]) +
+                          $signed(item.simd_a[31:24]) * $signed(item.simd_b[31:24]);
+                item.result = dot_sum[31:0];
+            end
         endcase
         
         item.simd_overflow = 1'b0; // SIMD overflow detection would be more complex
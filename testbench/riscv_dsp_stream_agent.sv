@@ -0,0 +1,226 @@
+//=============================================================================
+// RISC-V DSP Processor Streaming Agent
+// UVM-style source/sink agent for the DMA sample stream
+//=============================================================================
+
+// One stream sample and the gap before it
+class riscv_dsp_stream_item extends uvm_sequence_item;
+
+    rand logic [15:0] sample;           // Sample driven on external_data_in
+    rand int unsigned gap;              // Idle cycles before the sample
+
+    logic [31:0] data;                  // Monitored sample word
+    logic        is_output;             // Monitored on external_data_out
+
+    constraint gap_c { gap inside {[0:16]}; }
+
+    // Constructor
+    function new(string name = "riscv_dsp_stream_item");
+        super.new(name);
+    endfunction
+
+    // UVM field macros
+    `uvm_object_utils_begin(riscv_dsp_stream_item)
+        `uvm_field_int(sample, UVM_ALL_ON)
+        `uvm_field_int(gap, UVM_ALL_ON)
+        `uvm_field_int(data, UVM_ALL_ON)
+        `uvm_field_int(is_output, UVM_ALL_ON)
+    `uvm_object_utils_end
+
+endclass : riscv_dsp_stream_item
+
+// Sine-like ramp of block_len * blocks samples at a fixed rate
+class riscv_dsp_stream_sequence extends uvm_sequence #(riscv_dsp_stream_item);
+
+    int unsigned block_len = 64;        // Samples per DMA block (dma_rx_len)
+    int unsigned blocks = 4;            // Blocks to stream
+    int unsigned rate_gap = 8;          // Idle cycles between samples
+
+    // Constructor
+    function new(string name = "riscv_dsp_stream_sequence");
+        super.new(name);
+    endfunction
+
+    // UVM field macros
+    `uvm_object_utils(riscv_dsp_stream_sequence)
+
+    // Body
+    virtual task body();
+        riscv_dsp_stream_item item;
+
+        for (int i = 0; i < block_len * blocks; i++) begin
+            item = riscv_dsp_stream_item::type_id::create("stream_item");
+            start_item(item);
+            if (!item.randomize() with { gap == rate_gap; })
+                `uvm_error("SEQ", "Stream item randomization failed")
+            item.sample = 16'(i * 257);
+            finish_item(item);
+        end
+    endtask
+
+endclass : riscv_dsp_stream_sequence
+
+// Drives external_data_in/external_data_valid and accepts external_data_out
+class riscv_dsp_stream_driver extends uvm_driver #(riscv_dsp_stream_item);
+
+    // Virtual interface
+    virtual riscv_dsp_if vif;
+
+    // Sink: take every transmitted sample as soon as it is valid
+    bit sink_ready = 1'b1;
+
+    // Constructor
+    function new(string name = "riscv_dsp_stream_driver", uvm_component parent = null);
+        super.new(name, parent);
+    endfunction
+
+    // UVM field macros
+    `uvm_component_utils(riscv_dsp_stream_driver)
+
+    // Build phase
+    virtual function void build_phase(uvm_phase phase);
+        super.build_phase(phase);
+        if (!uvm_config_db#(virtual riscv_dsp_if)::get(this, "", "vif", vif))
+            `uvm_fatal("NOVIF", "Virtual interface not found")
+    endfunction
+
+    // Run phase
+    virtual task run_phase(uvm_phase phase);
+        super.run_phase(phase);
+
+        // Initialize interface
+        vif.stream_cb.external_data_in <= 32'h0;
+        vif.stream_cb.external_data_valid <= 1'b0;
+        vif.stream_cb.external_data_ready <= 1'b0;
+
+        // Wait for reset release
+        wait(vif.rst_n === 1'b1);
+        vif.stream_cb.external_data_ready <= sink_ready;
+
+        // Main driver loop
+        forever begin
+            seq_item_port.get_next_item(req);
+            drive_item(req);
+            seq_item_port.item_done();
+        end
+    endtask
+
+    // Drive one sample for a single cycle after the gap
+    virtual task drive_item(riscv_dsp_stream_item item);
+        repeat(item.gap) @(vif.stream_cb);
+        vif.stream_cb.external_data_in <= {{16{item.sample[15]}}, item.sample};
+        vif.stream_cb.external_data_valid <= 1'b1;
+        @(vif.stream_cb);
+        vif.stream_cb.external_data_valid <= 1'b0;
+
+        `uvm_info("STREAM_DRV", $sformatf("Sample 0x%04h", item.sample), UVM_HIGH)
+    endtask
+
+endclass : riscv_dsp_stream_driver
+
+// Publishes received and transmitted samples, counts DMA interrupts
+class riscv_dsp_stream_monitor extends uvm_monitor;
+
+    // Virtual interface
+    virtual riscv_dsp_if vif;
+
+    // Analysis port
+    uvm_analysis_port #(riscv_dsp_stream_item) ap;
+
+    // Statistics
+    int samples_in = 0;
+    int samples_out = 0;
+    int irq_count = 0;
+
+    // Constructor
+    function new(string name = "riscv_dsp_stream_monitor", uvm_component parent = null);
+        super.new(name, parent);
+        ap = new("ap", this);
+    endfunction
+
+    // UVM field macros
+    `uvm_component_utils(riscv_dsp_stream_monitor)
+
+    // Build phase
+    virtual function void build_phase(uvm_phase phase);
+        super.build_phase(phase);
+        if (!uvm_config_db#(virtual riscv_dsp_if)::get(this, "", "vif", vif))
+            `uvm_fatal("NOVIF", "Virtual interface not found")
+    endfunction
+
+    // Run phase
+    virtual task run_phase(uvm_phase phase);
+        riscv_dsp_stream_item item;
+        logic irq_prev = 1'b0;
+
+        super.run_phase(phase);
+
+        forever begin
+            @(vif.monitor_cb);
+
+            if (vif.monitor_cb.external_data_valid) begin
+                item = riscv_dsp_stream_item::type_id::create("stream_in");
+                item.data = vif.monitor_cb.external_data_in;
+                item.is_output = 1'b0;
+                samples_in++;
+                ap.write(item);
+            end
+
+            if (vif.monitor_cb.external_data_out_valid && vif.monitor_cb.external_data_ready) begin
+                item = riscv_dsp_stream_item::type_id::create("stream_out");
+                item.data = vif.monitor_cb.external_data_out;
+                item.is_output = 1'b1;
+                samples_out++;
+                ap.write(item);
+            end
+
+            if (vif.monitor_cb.dma_irq && !irq_prev) begin
+                irq_count++;
+                `uvm_info("STREAM_MON", $sformatf("DMA block complete after %0d samples in", samples_in), UVM_MEDIUM)
+            end
+            irq_prev = vif.monitor_cb.dma_irq;
+        end
+    endtask
+
+    // Report phase
+    virtual function void report_phase(uvm_phase phase);
+        `uvm_info("STREAM_MON", $sformatf("Samples in: %0d  Samples out: %0d  DMA interrupts: %0d",
+                 samples_in, samples_out, irq_count), UVM_LOW)
+    endfunction
+
+endclass : riscv_dsp_stream_monitor
+
+// Active agent: sequencer, driver and monitor for the sample stream
+class riscv_dsp_stream_agent extends uvm_agent;
+
+    uvm_sequencer #(riscv_dsp_stream_item) sequencer;
+    riscv_dsp_stream_driver driver;
+    riscv_dsp_stream_monitor monitor;
+
+    // Constructor
+    function new(string name = "riscv_dsp_stream_agent", uvm_component parent = null);
+        super.new(name, parent);
+    endfunction
+
+    // UVM field macros
+    `uvm_component_utils(riscv_dsp_stream_agent)
+
+    // Build phase
+    virtual function void build_phase(uvm_phase phase);
+        super.build_phase(phase);
+        monitor = riscv_dsp_stream_monitor::type_id::create("monitor", this);
+        if (get_is_active() == UVM_ACTIVE) begin
+            sequencer = uvm_sequencer#(riscv_dsp_stream_item)::type_id::create("sequencer", this);
+            driver = riscv_dsp_stream_driver::type_id::create("driver", this);
+        end
+    endfunction
+
+    // Connect phase
+    virtual function void connect_phase(uvm_phase phase);
+        super.connect_phase(phase);
+        if (get_is_active() == UVM_ACTIVE) begin
+            driver.seq_item_port.connect(sequencer.seq_item_export);
+        end
+    endfunction
+
+endclass : riscv_dsp_stream_agent
@@ -23,6 +23,10 @@ module riscv_dsp_tb_top;
         .external_data_in(riscv_if.external_data_in),
         .external_data_out(riscv_if.external_data_out),
         .processor_ready(riscv_if.processor_ready),
+        .external_data_valid(riscv_if.external_data_valid),
+        .external_data_out_valid(riscv_if.external_data_out_valid),
+        .external_data_ready(riscv_if.external_data_ready),
+        .dma_irq(riscv_if.dma_irq),
         
         // Debug/verification outputs
         .pc(riscv_if.pc),
@@ -163,8 +167,8 @@ module riscv_dsp_tb_top;
                                                            riscv_dsp_pkg::SIMD_AND4,
                                                            riscv_dsp_pkg::SIMD_OR4,
                                                            riscv_dsp_pkg::SIMD_XOR4,
-                                                           riscv_dsp_pkg::SIMD_SAT,
-                                                           riscv_dsp_pkg::SIMD_CLIP});
+                                                           riscv_dsp_pkg::SIMD_SHIFT4,
+                                                           riscv_dsp_pkg::SIMD_DOT4});
     endproperty
     assert_simd_operation: assert property (simd_operation_property)
         else `uvm_error("ASSERT", "SIMD operation assertion failed")
@@ -189,6 +193,16 @@ module riscv_dsp_tb_top;
     assert_instruction_fetch: assert property (instruction_fetch_property)
         else `uvm_error("ASSERT", "Instruction fetch assertion failed")
     
+    // DMA transmit handshake: a sample is held until the sink takes it
+    property dma_tx_hold_property;
+        @(posedge clk)
+        disable iff (!rst_n)
+        riscv_if.external_data_out_valid && !riscv_if.external_data_ready
+        |=> riscv_if.external_data_out_valid && $stable(riscv_if.external_data_out);
+    endproperty
+    assert_dma_tx_hold: assert property (dma_tx_hold_property)
+        else `uvm_error("ASSERT", "DMA transmit handshake assertion failed")
+    
     // Coverage assertions
     covergroup riscv_dsp_cg @(posedge clk);
         alu_op_cp: coverpoint riscv_if.alu_op {
@@ -219,8 +233,8 @@ module riscv_dsp_tb_top;
             bins and4 = {riscv_dsp_pkg::SIMD_AND4};
             bins or4 = {riscv_dsp_pkg::SIMD_OR4};
             bins xor4 = {riscv_dsp_pkg::SIMD_XOR4};
-            bins sat = {riscv_dsp_pkg::SIMD_SAT};
-            bins clip = {riscv_dsp_pkg::SIMD_CLIP};
+            bins shift4 = {riscv_dsp_pkg::SIMD_SHIFT4};
+            bins dot4 = {riscv_dsp_pkg::SIMD_DOT4};
         }
         
         overflow_cp: coverpoint riscv_if.alu_overflow {